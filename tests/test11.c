@@ -0,0 +1,175 @@
+/* Dummy Test 11 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_machine_export_c, tnn_machine_fprop
+ *
+ * Exports a linear-bias-sum-linear machine with deterministic weights to test11_export.c, compiles it with a
+ * small driver (using $CC, or cc) that reads inputs and writes outputs as hexadecimal floats, and checks that
+ * its outputs are bit-identical to tnn_machine_fprop on N inputs. A name that is not a C identifier must be
+ * rejected. Needs a C compiler at run time, but nothing built by the other tests.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 6 //Input size
+#define B 8 //Hidden size
+#define C 4 //Sum output size
+#define D 3 //Output size
+#define N 100 //Number of inputs
+
+tnn_error build(tnn_machine *m);
+int compile();
+
+int main(){
+  tnn_machine m;
+  tnn_state *sin, *sout;
+  FILE *fp;
+  double output[D];
+  size_t i, j, nequal;
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m)));
+  tnn_machine_get_sin(&m, &sin);
+  tnn_machine_get_sout(&m, &sout);
+
+  //Export and compile the machine
+  if((fp = fopen("test11_export.c", "w")) == NULL){
+    printf("Cannot open test11_export.c\n");
+    return 1;
+  }
+  printf("Exporting the machine: %s\n", TEST_FUNC(tnn_machine_export_c(&m, fp, "test11")));
+  fclose(fp);
+  printf("Exporting with an invalid name (should be NO): %s\n", TEST_FUNC(tnn_machine_export_c(&m, stdout, "11test")));
+  printf("Compiling the exported machine: %s\n", compile() == 0 ? "YES" : "NO");
+
+  //Write the inputs
+  if((fp = fopen("test11_input.txt", "w")) == NULL){
+    printf("Cannot open test11_input.txt\n");
+    return 1;
+  }
+  for(i = 0; i < N; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      fprintf(fp, "%a\n", cos(1.3*(double)(i*A + j)));
+    }
+  }
+  fclose(fp);
+
+  //Compare the outputs of the compiled machine
+  if((fp = popen("./test11_export < test11_input.txt", "r")) == NULL){
+    printf("Cannot run test11_export\n");
+    return 1;
+  }
+  nequal = 0;
+  for(i = 0; i < N; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      gsl_vector_set(&sin->x, j, cos(1.3*(double)(i*A + j)));
+    }
+    tnn_machine_fprop(&m);
+    for(j = 0; j < D; j = j + 1){
+      if(fscanf(fp, "%la", &output[j]) != 1){
+	break;
+      }
+    }
+    if(j == D && memcmp(output, sout->x.data, D*sizeof(double)) == 0){
+      nequal = nequal + 1;
+    }
+  }
+  pclose(fp);
+  printf("Bit-identical outputs: %ld/%d\n", nequal, N);
+  printf("Exported machine equivalent: %s\n", nequal == N ? "YES" : "NO");
+
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m)));
+
+  return 0;
+}
+
+//Write a driver around the exported source and compile it to test11_export
+int compile(){
+  FILE *fp;
+  char cmd[256];
+  const char *cc;
+
+  if((fp = fopen("test11_main.c", "w")) == NULL){
+    return -1;
+  }
+  fprintf(fp, "#include <stdio.h>\n#include \"test11_export.c\"\n");
+  fprintf(fp, "int main(){\n  double input[%d], output[%d], io[TEST11_NIO];\n  int i;\n", A, D);
+  fprintf(fp, "  for(;;){\n    for(i = 0; i < %d; i = i + 1){\n", A);
+  fprintf(fp, "      if(scanf(\"%%la\", &input[i]) != 1){\n\treturn 0;\n      }\n    }\n");
+  fprintf(fp, "    test11_fprop(input, output, io);\n");
+  fprintf(fp, "    for(i = 0; i < %d; i = i + 1){\n      printf(\"%%a\\n\", output[i]);\n    }\n  }\n}\n", D);
+  fclose(fp);
+
+  cc = getenv("CC");
+  snprintf(cmd, sizeof(cmd), "%s -ffp-contract=off -o test11_export test11_main.c -lm", cc != NULL ? cc : "cc");
+  return system(cmd);
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_state *in, *out, *h1, *h2, *h3;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p, *io;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_io(m, &io);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_sum(mod, h2, h3, io)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_linear(mout, h3, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/3.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,155 @@
+/* Dummy Test 12 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_profile_init
+ * tnn_profile_add_machine
+ * tnn_profile_add_loss
+ * tnn_profile_add_reg
+ * tnn_profile_report
+ * tnn_profile_report_csv
+ * tnn_profile_reset
+ * tnn_profile_destroy
+ *
+ * After the reset, T threads call the profiled regularizer at once, and every call must be counted.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_profile.h>
+#include <pthread.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 64 //Input size
+#define B 256 //Hidden size
+#define C 10 //Output size
+#define N 1000 //Number of iterations
+#define T 4 //Number of concurrent threads
+#define M 20000 //Number of calls per thread
+
+void *caller(void *arg);
+
+int main(){
+  tnn_machine m;
+  tnn_loss l, lc;
+  tnn_reg r, rc;
+  tnn_profile f;
+  tnn_state *in, *out, *h1, *h2, *label, *loss;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p, *io;
+  tnn_profile_el *el;
+  pthread_t th[T];
+  gsl_vector *d;
+  double rl;
+  size_t i;
+
+  //Build the machine
+  printf("Initializing the machine: %s\n", TEST_FUNC(tnn_machine_init(&m, A, C)));
+  tnn_machine_get_param(&m, &p);
+  tnn_machine_get_io(&m, &io);
+  tnn_machine_get_sin(&m, &in);
+  tnn_machine_get_sout(&m, &out);
+  tnn_machine_get_min(&m, &min);
+  tnn_machine_get_mout(&m, &mout);
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  label = malloc(sizeof(tnn_state));
+  loss = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(label, C);
+  tnn_state_init(loss, 1);
+  tnn_machine_state_alloc(&m, h1);
+  tnn_machine_state_alloc(&m, h2);
+  tnn_machine_state_alloc(&m, label);
+  tnn_machine_state_alloc(&m, loss);
+  printf("Initializing the input module: %s\n", TEST_FUNC(tnn_module_init_linear(min, in, h1, p)));
+  mod = malloc(sizeof(tnn_module));
+  printf("Initializing the bias module: %s\n", TEST_FUNC(tnn_module_init_bias(mod, h1, h2, p)));
+  tnn_machine_module_append(&m, mod);
+  printf("Initializing the output module: %s\n", TEST_FUNC(tnn_module_init_linear(mout, h2, out, p)));
+  printf("Initializing the loss: %s\n", TEST_FUNC(tnn_loss_init_euclidean(&l, out, label, loss)));
+  printf("Initializing the regularizer: %s\n", TEST_FUNC(tnn_reg_init_l2(&r)));
+  printf("Randomizing the machine: %s\n", TEST_FUNC(tnn_machine_randomize(&m, 0.1)));
+  gsl_vector_set_all(&in->x, 0.5);
+  gsl_vector_set_all(&label->x, 1.0);
+  d = gsl_vector_alloc(p->size);
+
+  //Profile everything
+  printf("Initializing the profile: %s\n", TEST_FUNC(tnn_profile_init(&f)));
+  printf("Profiling the machine: %s\n", TEST_FUNC(tnn_profile_add_machine(&f, &m)));
+  printf("Profiling the loss: %s\n", TEST_FUNC(tnn_profile_add_loss(&f, &l)));
+  printf("Profiling the regularizer: %s\n", TEST_FUNC(tnn_profile_add_reg(&f, &r)));
+  printf("Profiling the loss again (should be NO): %s\n", TEST_FUNC(tnn_profile_add_loss(&f, &l)));
+
+  for(i = 0; i < N; i = i + 1){
+    tnn_machine_fprop(&m);
+    tnn_loss_fprop(&l);
+    gsl_vector_set(&loss->dx, 0, 1.0);
+    tnn_loss_bprop(&l);
+    tnn_machine_bprop(&m);
+    tnn_reg_l(&r, p->x, &rl);
+    tnn_reg_d(&r, p->x, d);
+  }
+
+  //Copies of profiled objects run the original methods and are not accounted
+  lc = l;
+  rc = r;
+  printf("Running a copy of the profiled loss: %s\n", TEST_FUNC(tnn_loss_fprop(&lc)));
+  printf("Running a copy of the profiled regularizer: %s\n", TEST_FUNC(tnn_reg_d(&rc, p->x, d)));
+
+  printf("Printing the report: %s\n", TEST_FUNC(tnn_profile_report(&f, stdout)));
+  printf("Printing the CSV: %s\n", TEST_FUNC(tnn_profile_report_csv(&f, stdout)));
+  printf("Resetting the profile: %s\n", TEST_FUNC(tnn_profile_reset(&f)));
+
+  //Concurrent calls to one profiled object
+  for(i = 0; i < T; i = i + 1){
+    pthread_create(&th[i], NULL, &caller, &r);
+  }
+  for(i = 0; i < T; i = i + 1){
+    pthread_join(th[i], NULL);
+  }
+  for(el = f.els; el != NULL && el->key != &r; el = el->next);
+  printf("Concurrent calls counted: %ld of %d\n", el != NULL ? el->count[0] : 0L, T*M);
+
+  printf("Destroying the profile: %s\n", TEST_FUNC(tnn_profile_destroy(&f)));
+  printf("Methods restored: %s\n", (min->fprop == &tnn_module_fprop_linear && mod->bprop == &tnn_module_bprop_bias
+                                    && l.fprop == &tnn_loss_fprop_euclidean && r.d == &tnn_reg_d_l2) ? "YES" : "NO");
+  printf("Running the copies after destroying the profile: %s\n",
+         (tnn_loss_fprop(&lc) == TNN_ERROR_SUCCESS && tnn_reg_d(&rc, p->x, d) == TNN_ERROR_SUCCESS) ? "YES" : "NO");
+
+  gsl_vector_free(d);
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m)));
+  return 0;
+}
+
+//Call the l method of a regularizer M times
+void *caller(void *arg){
+  gsl_vector *w;
+  double l;
+  size_t i;
+
+  w = gsl_vector_alloc(16);
+  gsl_vector_set_all(w, 0.5);
+  for(i = 0; i < M; i = i + 1){
+    tnn_reg_l((tnn_reg *)arg, w, &l);
+  }
+  gsl_vector_free(w);
+  return NULL;
+}
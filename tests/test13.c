@@ -0,0 +1,161 @@
+/* Dummy Test 13 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_machine_clone
+ * tnn_machine_replica
+ *
+ * Replicas must give the same outputs as the original machine without owning any parameter,
+ * and must see changes of the shared weights. Clones must own an independent copy. A clone that fails
+ * part way must not affect the original.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 6 //Input size
+#define B 8 //Hidden size
+#define C 4 //Sum output size
+#define D 3 //Output size
+#define R 4 //Number of replicas
+
+tnn_error build(tnn_machine *m);
+int same(tnn_machine *m1, tnn_machine *m2);
+
+int main(){
+  tnn_machine m, c, f, r[R];
+  tnn_param *p;
+  tnn_module *mout;
+  TNN_MODULE_FUNC_CLONE clone;
+  size_t i, k, n;
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m)));
+  for(k = 0; k < R; k = k + 1){
+    printf("Making replica %ld: %s\n", k, TEST_FUNC(tnn_machine_replica(&m, &r[k], NULL)));
+  }
+  printf("Cloning the machine: %s\n", TEST_FUNC(tnn_machine_clone(&m, &c, NULL)));
+
+  //A failed clone destroys what it has built and leaves the original intact
+  tnn_machine_get_mout(&m, &mout);
+  clone = mout->clone;
+  mout->clone = NULL;
+  printf("Cloning without an output clone method (should be NO): %s\n", TEST_FUNC(tnn_machine_clone(&m, &f, NULL)));
+  mout->clone = clone;
+  tnn_machine_get_param(&r[0], &p);
+  printf("Replica parameter size: %ld\n", p->size);
+
+  //Compare outputs on some inputs
+  n = 0;
+  for(i = 0; i < 50; i = i + 1){
+    for(k = 0; k < R; k = k + 1){
+      n = n + same(&m, &r[k]);
+    }
+    n = n + same(&m, &c);
+  }
+  printf("Identical outputs: %ld/%d\n", n, 50*(R+1));
+
+  //Change the shared weights
+  tnn_machine_get_param(&m, &p);
+  gsl_vector_scale(p->x, 2.0);
+  printf("Replica sees new weights: %s\n", same(&m, &r[0]) ? "YES" : "NO");
+  printf("Clone keeps old weights: %s\n", same(&m, &c) ? "NO" : "YES");
+
+  for(k = 0; k < R; k = k + 1){
+    printf("Destroying replica %ld: %s\n", k, TEST_FUNC(tnn_machine_destroy(&r[k])));
+  }
+  printf("Destroying the clone: %s\n", TEST_FUNC(tnn_machine_destroy(&c)));
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m)));
+
+  return 0;
+}
+
+//Run both machines on the same random input and compare the outputs
+int same(tnn_machine *m1, tnn_machine *m2){
+  tnn_state *in1, *in2, *out1, *out2;
+  size_t i;
+
+  tnn_machine_get_sin(m1, &in1);
+  tnn_machine_get_sin(m2, &in2);
+  tnn_machine_get_sout(m1, &out1);
+  tnn_machine_get_sout(m2, &out2);
+  for(i = 0; i < A; i = i + 1){
+    gsl_vector_set(&in1->x, i, 2.0*((double)rand()/(double)RAND_MAX) - 1.0);
+  }
+  gsl_vector_memcpy(&in2->x, &in1->x);
+  tnn_machine_fprop(m1);
+  tnn_machine_fprop(m2);
+  for(i = 0; i < D; i = i + 1){
+    if(gsl_vector_get(&out1->x, i) != gsl_vector_get(&out2->x, i)){
+      return 0;
+    }
+  }
+  return 1;
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_state *in, *out, *h1, *h2, *h3;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p, *io;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_io(m, &io);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_sum(mod, h2, h3, io)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_linear(mout, h3, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/3.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
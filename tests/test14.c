@@ -0,0 +1,179 @@
+/* Dummy Test 14 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_swap_init
+ * tnn_swap_reader_init
+ * tnn_swap_fprop
+ * tnn_swap_update
+ * tnn_swap_reader_destroy
+ * tnn_swap_destroy
+ *
+ * Reader threads run a fixed input while the main thread keeps swapping between two weight sets.
+ * Every output must match one of the two reference outputs exactly (no torn weights).
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+#include <tnn/tnn_swap.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 6 //Input size
+#define B 8 //Hidden size
+#define C 4 //Sum output size
+#define D 3 //Output size
+#define T 4 //Number of reader threads
+#define N 20000 //Number of runs per reader
+#define U 2000 //Number of updates
+
+tnn_error build(tnn_machine *m);
+void *reader(void *arg);
+
+tnn_swap s;
+tnn_swap_reader r[T];
+gsl_vector *in, *ref[2];
+size_t bad[T];
+
+int main(){
+  tnn_machine m;
+  tnn_param *p;
+  tnn_state *sin, *sout;
+  gsl_vector *w[2];
+  pthread_t th[T];
+  size_t i, k, nbad;
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m)));
+  tnn_machine_get_param(&m, &p);
+  tnn_machine_get_sin(&m, &sin);
+  tnn_machine_get_sout(&m, &sout);
+
+  //Two weight sets and their reference outputs
+  in = gsl_vector_alloc(A);
+  for(i = 0; i < A; i = i + 1){
+    gsl_vector_set(in, i, cos((double)i));
+  }
+  for(k = 0; k < 2; k = k + 1){
+    w[k] = gsl_vector_alloc(p->size);
+    ref[k] = gsl_vector_alloc(D);
+    gsl_vector_memcpy(w[k], p->x);
+    gsl_vector_scale(w[k], 1.0 + (double)k);
+    gsl_vector_memcpy(p->x, w[k]);
+    gsl_vector_memcpy(&sin->x, in);
+    tnn_machine_fprop(&m);
+    gsl_vector_memcpy(ref[k], &sout->x);
+  }
+  gsl_vector_memcpy(p->x, w[0]);
+
+  printf("Initializing the swap: %s\n", TEST_FUNC(tnn_swap_init(&s, &m)));
+  for(k = 0; k < T; k = k + 1){
+    printf("Initializing reader %ld: %s\n", k, TEST_FUNC(tnn_swap_reader_init(&s, &r[k])));
+  }
+
+  //Readers run while the weights are swapped
+  for(k = 0; k < T; k = k + 1){
+    pthread_create(&th[k], NULL, &reader, (void *)k);
+  }
+  for(i = 0; i < U; i = i + 1){
+    tnn_swap_update(&s, w[(i+1)%2]);
+  }
+  nbad = 0;
+  for(k = 0; k < T; k = k + 1){
+    pthread_join(th[k], NULL);
+    nbad = nbad + bad[k];
+  }
+  printf("Torn outputs: %ld\n", nbad);
+
+  for(k = 0; k < T; k = k + 1){
+    printf("Destroying reader %ld: %s\n", k, TEST_FUNC(tnn_swap_reader_destroy(&r[k])));
+  }
+  printf("Destroying the swap: %s\n", TEST_FUNC(tnn_swap_destroy(&s)));
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m)));
+
+  return 0;
+}
+
+//Run the fixed input repeatedly and count the outputs matching no reference
+void *reader(void *arg){
+  size_t k, i;
+  gsl_vector *out;
+
+  k = (size_t)arg;
+  out = gsl_vector_alloc(D);
+  bad[k] = 0;
+  for(i = 0; i < N; i = i + 1){
+    if(tnn_swap_fprop(&s, &r[k], in, out) != TNN_ERROR_SUCCESS){
+      bad[k] = bad[k] + 1;
+    } else if(!gsl_vector_equal(out, ref[0]) && !gsl_vector_equal(out, ref[1])){
+      bad[k] = bad[k] + 1;
+    }
+  }
+  gsl_vector_free(out);
+  return NULL;
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_state *in, *out, *h1, *h2, *h3;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p, *io;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_io(m, &io);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_sum(mod, h2, h3, io)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_linear(mout, h3, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/3.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
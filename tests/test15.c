@@ -0,0 +1,134 @@
+/* Dummy Test 15 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_machine_checkpoint
+ *
+ * A deep chain of linear and bias modules is cloned, and the clone is checkpointed. Both machines must
+ * produce identical outputs and gradients, while the checkpointed io parameter is much smaller.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 5 //Input size
+#define H 16 //Hidden size
+#define D 3 //Output size
+#define L 24 //Number of hidden layers
+
+tnn_error build(tnn_machine *m);
+tnn_error run(tnn_machine *m);
+
+int main(){
+  tnn_machine m, c;
+  tnn_param *p1, *p2, *io1, *io2;
+  tnn_state *in1, *in2, *out1, *out2;
+  size_t i;
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m)));
+  printf("Cloning the machine: %s\n", TEST_FUNC(tnn_machine_clone(&m, &c, NULL)));
+  printf("Checkpointing the clone: %s\n", TEST_FUNC(tnn_machine_checkpoint(&c, 0)));
+  printf("Checkpointing again (should be NO): %s\n", TEST_FUNC(tnn_machine_checkpoint(&c, 0)));
+  tnn_machine_get_io(&m, &io1);
+  tnn_machine_get_io(&c, &io2);
+  printf("Segment length: %ld, io size: %ld -> %ld\n", c.k, io1->size, io2->size);
+
+  tnn_machine_get_sin(&m, &in1);
+  tnn_machine_get_sin(&c, &in2);
+  for(i = 0; i < A; i = i + 1){
+    gsl_vector_set(&in1->x, i, cos((double)i));
+  }
+  gsl_vector_memcpy(&in2->x, &in1->x);
+  printf("Running the machine: %s\n", TEST_FUNC(run(&m)));
+  printf("Running the clone: %s\n", TEST_FUNC(run(&c)));
+
+  tnn_machine_get_sout(&m, &out1);
+  tnn_machine_get_sout(&c, &out2);
+  tnn_machine_get_param(&m, &p1);
+  tnn_machine_get_param(&c, &p2);
+  printf("Identical outputs: %s\n", gsl_vector_equal(&out1->x, &out2->x) ? "YES" : "NO");
+  printf("Identical input gradients: %s\n", gsl_vector_equal(&in1->dx, &in2->dx) ? "YES" : "NO");
+  printf("Identical parameter gradients: %s\n", gsl_vector_equal(p1->dx, p2->dx) ? "YES" : "NO");
+
+  printf("Destroying the clone: %s\n", TEST_FUNC(tnn_machine_destroy(&c)));
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m)));
+
+  return 0;
+}
+
+//One forward and backward propagation with a fixed output gradient
+tnn_error run(tnn_machine *m){
+  tnn_state *out;
+  tnn_error ret;
+
+  if((ret = tnn_machine_fprop(m)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_sout(m, &out);
+  gsl_vector_set_all(&out->dx, 1.0);
+  return tnn_machine_bprop(m);
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_state *in, *out, *s, *t;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  s = malloc(sizeof(tnn_state));
+  tnn_state_init(s, H);
+  tnn_machine_state_alloc(m, s);
+  if((ret = tnn_module_init_linear(min, in, s, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < 2*L; i = i + 1){
+    t = malloc(sizeof(tnn_state));
+    tnn_state_init(t, H);
+    tnn_machine_state_alloc(m, t);
+    mod = malloc(sizeof(tnn_module));
+    if(i % 2 == 0){
+      ret = tnn_module_init_linear(mod, s, t, p);
+    } else {
+      ret = tnn_module_init_bias(mod, s, t, p);
+    }
+    if(ret != TNN_ERROR_SUCCESS){
+      return ret;
+    }
+    tnn_machine_module_append(m, mod);
+    s = t;
+  }
+  if((ret = tnn_module_init_linear(mout, s, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/3.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/* Dummy Test 16 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_param_save
+ * tnn_param_load
+ *
+ * The parameters of a machine are saved to test16.param and mapped into a second machine built by
+ * the same code. Loading into a machine of a different shape must fail.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 6 //Input size
+#define B 8 //Hidden size
+#define C 4 //Sum output size
+#define D 3 //Output size
+
+tnn_error build(tnn_machine *m);
+
+int main(){
+  tnn_machine m1, m2, m3;
+  tnn_param *p1, *p2, *p3;
+  tnn_state *in1, *in2, *out1, *out2, *in3, *out3, *h;
+  size_t i;
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m1)));
+  tnn_machine_get_param(&m1, &p1);
+  printf("Saving the parameters: %s\n", TEST_FUNC(tnn_param_save(p1, "test16.param")));
+
+  printf("Building the second machine: %s\n", TEST_FUNC(build(&m2)));
+  tnn_machine_get_param(&m2, &p2);
+  gsl_vector_set_zero(p2->x);
+  printf("Loading the parameters: %s\n", TEST_FUNC(tnn_param_load(p2, "test16.param")));
+  printf("Mapped and aligned: %s\n", (p2->map != NULL && (uintptr_t)p2->x->data % TNN_PARAM_FILE_ALIGN == 0) ? "YES" : "NO");
+  printf("Identical parameters: %s\n", gsl_vector_equal(p1->x, p2->x) ? "YES" : "NO");
+
+  tnn_machine_get_sin(&m1, &in1);
+  tnn_machine_get_sin(&m2, &in2);
+  tnn_machine_get_sout(&m1, &out1);
+  tnn_machine_get_sout(&m2, &out2);
+  for(i = 0; i < A; i = i + 1){
+    gsl_vector_set(&in1->x, i, cos((double)i));
+  }
+  gsl_vector_memcpy(&in2->x, &in1->x);
+  tnn_machine_fprop(&m1);
+  tnn_machine_fprop(&m2);
+  printf("Identical outputs: %s\n", gsl_vector_equal(&out1->x, &out2->x) ? "YES" : "NO");
+
+  //Writes to a loaded parameter stay private
+  gsl_vector_set_zero(p2->x);
+  printf("Building the third machine: %s\n", TEST_FUNC(build(&m3)));
+  tnn_machine_get_param(&m3, &p3);
+  printf("Loading the parameters again: %s\n", TEST_FUNC(tnn_param_load(p3, "test16.param")));
+  printf("File unchanged by writes: %s\n", gsl_vector_equal(p1->x, p3->x) ? "YES" : "NO");
+  printf("Destroying the third machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m3)));
+
+  //A machine of a different shape
+  printf("Initializing a different machine: %s\n", TEST_FUNC(tnn_machine_init(&m3, A, D)));
+  tnn_machine_get_param(&m3, &p3);
+  tnn_machine_get_sin(&m3, &in3);
+  tnn_machine_get_sout(&m3, &out3);
+  h = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_machine_state_alloc(&m3, h);
+  tnn_module_init_linear(&m3.min, in3, h, p3);
+  tnn_module_init_linear(&m3.mout, h, out3, p3);
+  printf("Loading into a different machine (should be NO): %s\n", TEST_FUNC(tnn_param_load(p3, "test16.param")));
+
+  printf("Destroying the different machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m3)));
+  printf("Destroying the second machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m2)));
+  printf("Destroying the machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m1)));
+  remove("test16.param");
+
+  return 0;
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_state *in, *out, *h1, *h2, *h3;
+  tnn_module *min, *mout, *mod;
+  tnn_param *p, *io;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_io(m, &io);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_sum(mod, h2, h3, io)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_linear(mout, h3, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/3.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
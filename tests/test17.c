@@ -0,0 +1,134 @@
+/* Dummy Test 17 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_dataset_write
+ * tnn_dataset_open
+ * tnn_dataset_close
+ * tnn_trainer_class_train_dataset_nsgd
+ * tnn_trainer_class_test_dataset
+ *
+ * The same 1-layer linear-bias model is trained on an in-memory matrix and on a mapped dataset file
+ * (test17.data) holding the same samples. Both must give identical parameters and test results.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_dataset.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+
+tnn_error build(tnn_trainer_class *t);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_dataset ds;
+  tnn_param *p1, *p2;
+  gsl_matrix *inputs, *dinputs;
+  size_t *labels, *dlabels;
+  double ls1, ls2, er1, er2;
+  size_t i, j, same;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 1.0 : 0.0));
+    }
+  }
+
+  printf("Writing the dataset: %s\n", TEST_FUNC(tnn_dataset_write("test17.data", inputs, labels)));
+  printf("Opening the dataset: %s\n", TEST_FUNC(tnn_dataset_open(&ds, "test17.data")));
+  tnn_dataset_get_inputs(&ds, &dinputs);
+  tnn_dataset_get_labels(&ds, &dlabels);
+  same = gsl_matrix_equal(inputs, dinputs);
+  for(i = 0; i < Q; i = i + 1){
+    same = same && labels[i] == dlabels[i];
+  }
+  printf("Identical data: %s\n", same ? "YES" : "NO");
+
+  //Two identical trainers
+  printf("Building the first trainer: %s\n", TEST_FUNC(build(&t1)));
+  printf("Building the second trainer: %s\n", TEST_FUNC(build(&t2)));
+  tnn_machine_get_param(&t1.m, &p1);
+  tnn_machine_get_param(&t2.m, &p2);
+  gsl_vector_memcpy(p2->x, p1->x);
+
+  printf("Training on the matrix: %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("Training on the dataset: %s\n", TEST_FUNC(tnn_trainer_class_train_dataset_nsgd(&t2, &ds)));
+  printf("Identical parameters: %s\n", gsl_vector_equal(p1->x, p2->x) ? "YES" : "NO");
+
+  printf("Testing on the matrix: %s\n", TEST_FUNC(tnn_trainer_class_test(&t1, inputs, labels, &ls1, &er1)));
+  printf("Testing on the dataset: %s\n", TEST_FUNC(tnn_trainer_class_test_dataset(&t2, &ds, &ls2, &er2)));
+  printf("Loss: %g, error: %g, identical: %s\n", ls2, er2, (ls1 == ls2 && er1 == er2) ? "YES" : "NO");
+
+  printf("Closing the dataset: %s\n", TEST_FUNC(tnn_dataset_close(&ds)));
+  printf("Destroying the first trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)));
+  printf("Destroying the second trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+  remove("test17.data");
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+tnn_error build(tnn_trainer_class *t){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, 0.0001, 0.01, 0.0, 100, 5000)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/* Dummy Test 18 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_loader_init
+ * tnn_loader_pull
+ * tnn_loader_release
+ * tnn_loader_destroy
+ * tnn_loader_fetch_matrix
+ * tnn_trainer_class_train_loader_nsgd
+ *
+ * The same 1-layer linear-bias model is trained on an in-memory matrix and through a loader over the same
+ * matrix, with a ring shorter than the data. Both must give identical parameters. The loader is also
+ * checked to stop at a failing sample after handing out those before it.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_loader.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define D 16 //Loader depth
+#define F 40 //Failing sample
+
+tnn_error build(tnn_trainer_class *t);
+tnn_error fetch_fail(void *src, size_t i, gsl_vector *x, size_t *label);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_loader ld;
+  tnn_loader_matrix src;
+  tnn_param *p1, *p2;
+  gsl_matrix *inputs;
+  gsl_vector_view in, row;
+  size_t *labels;
+  size_t i, j, label, same, aligned;
+  tnn_error ret;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 1.0 : 0.0));
+    }
+  }
+  src.inputs = inputs;
+  src.labels = labels;
+
+  //Pull more than an epoch and compare with the matrix
+  printf("Initializing the loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, tnn_loader_fetch_matrix, &src, Q, A, D)));
+  same = 1;
+  aligned = 1;
+  for(i = 0; i < 2*Q + D; i = i + 1){
+    if(tnn_loader_pull(&ld, &in, &label) != TNN_ERROR_SUCCESS){
+      same = 0;
+      break;
+    }
+    row = gsl_matrix_row(inputs, i%Q);
+    same = same && gsl_vector_equal(&in.vector, &row.vector) && label == labels[i%Q];
+    aligned = aligned && ((uintptr_t)in.vector.data)%TNN_LOADER_ALIGN == 0;
+    tnn_loader_release(&ld);
+  }
+  printf("Identical samples: %s\n", same ? "YES" : "NO");
+  printf("Aligned samples: %s\n", aligned ? "YES" : "NO");
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+
+  //Two identical trainers
+  printf("Building the first trainer: %s\n", TEST_FUNC(build(&t1)));
+  printf("Building the second trainer: %s\n", TEST_FUNC(build(&t2)));
+  tnn_machine_get_param(&t1.m, &p1);
+  tnn_machine_get_param(&t2.m, &p2);
+  gsl_vector_memcpy(p2->x, p1->x);
+
+  printf("Training on the matrix: %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("Initializing the loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, tnn_loader_fetch_matrix, &src, Q, A, D)));
+  printf("Training on the loader: %s\n", TEST_FUNC(tnn_trainer_class_train_loader_nsgd(&t2, &ld)));
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+  printf("Identical parameters: %s\n", gsl_vector_equal(p1->x, p2->x) ? "YES" : "NO");
+
+  //A failing source
+  printf("Initializing the failing loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, fetch_fail, &src, Q, A, D)));
+  for(i = 0; (ret = tnn_loader_pull(&ld, &in, &label)) == TNN_ERROR_SUCCESS; i = i + 1){
+    tnn_loader_release(&ld);
+  }
+  printf("Samples before failure: %ld, error passed: %s\n", i, ret == TNN_ERROR_STATE_INCOMP ? "YES" : "NO");
+  printf("Destroying the failing loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+
+  printf("Destroying the first trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)));
+  printf("Destroying the second trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+tnn_error fetch_fail(void *src, size_t i, gsl_vector *x, size_t *label){
+  if(i == F){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  return tnn_loader_fetch_matrix(src, i, x, label);
+}
+
+tnn_error build(tnn_trainer_class *t){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, 0.0001, 0.01, 0.0, 100, 5000)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
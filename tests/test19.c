@@ -0,0 +1,143 @@
+/* Dummy Test 19 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_checkpoint_nsgd
+ * tnn_trainer_class_resume_nsgd
+ * tnn_ckpt_load
+ *
+ * A 1-layer linear-bias model is trained for N steps in one go. Another one is trained for M steps with
+ * checkpoints to test19.ckpt, then a fresh trainer resumes from it (on the matrix and on a loader) up to N
+ * steps. All must give identical parameters.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_loader.h>
+#include <tnn/tnn_ckpt.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define N 5000 //Total steps
+#define M 2300 //Steps before interruption
+#define C 1000 //Steps between checkpoints
+
+tnn_error build(tnn_trainer_class *t, size_t niter);
+
+int main(){
+  tnn_trainer_class t1, t2, t3, t4;
+  tnn_loader ld;
+  tnn_loader_matrix src;
+  tnn_param *p1, *p2, *p3, *p4;
+  gsl_matrix *inputs;
+  size_t *labels;
+  size_t i, j, titer;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 1.0 : 0.0));
+    }
+  }
+  src.inputs = inputs;
+  src.labels = labels;
+
+  //Identical trainers
+  printf("Building the trainers: %s %s %s %s\n", TEST_FUNC(build(&t1, N)), TEST_FUNC(build(&t2, M)),
+         TEST_FUNC(build(&t3, N)), TEST_FUNC(build(&t4, N)));
+  tnn_machine_get_param(&t1.m, &p1);
+  tnn_machine_get_param(&t2.m, &p2);
+  tnn_machine_get_param(&t3.m, &p3);
+  tnn_machine_get_param(&t4.m, &p4);
+  gsl_vector_memcpy(p2->x, p1->x);
+
+  printf("Training in one go: %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+
+  printf("Resuming from a missing file (should be NO): %s\n", TEST_FUNC(tnn_trainer_class_resume_nsgd(&t3, "test19.ckpt")));
+  printf("Setting the checkpoint: %s\n", TEST_FUNC(tnn_trainer_class_checkpoint_nsgd(&t2, "test19.ckpt", C)));
+  printf("Training with checkpoints: %s\n", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("Checkpoint steps: %s\n", TEST_FUNC(tnn_ckpt_load("test19.ckpt", TNN_TRAINER_CLASS_TYPE_NSGD, p4->x, NULL, &titer)));
+  printf("Steps in the checkpoint: %ld\n", titer);
+  printf("Loading as a wrong trainer type (should be NO): %s\n",
+         TEST_FUNC(tnn_ckpt_load("test19.ckpt", TNN_TRAINER_CLASS_TYPE_TSGD, p4->x, NULL, &titer)));
+
+  printf("Resuming on the matrix: %s\n", TEST_FUNC(tnn_trainer_class_resume_nsgd(&t3, "test19.ckpt")));
+  printf("Training the rest: %s\n", TEST_FUNC(tnn_trainer_class_train(&t3, inputs, labels)));
+  printf("Identical parameters: %s\n", gsl_vector_equal(p1->x, p3->x) ? "YES" : "NO");
+
+  printf("Resuming on the loader: %s\n", TEST_FUNC(tnn_trainer_class_resume_nsgd(&t4, "test19.ckpt")));
+  printf("Initializing the loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, tnn_loader_fetch_matrix, &src, Q, A, 16)));
+  printf("Training the rest: %s\n", TEST_FUNC(tnn_trainer_class_train_loader_nsgd(&t4, &ld)));
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+  printf("Identical parameters: %s\n", gsl_vector_equal(p1->x, p4->x) ? "YES" : "NO");
+
+  printf("Destroying the trainers: %s %s %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+         TEST_FUNC(tnn_trainer_class_destroy(&t2)), TEST_FUNC(tnn_trainer_class_destroy(&t3)),
+         TEST_FUNC(tnn_trainer_class_destroy(&t4)));
+  remove("test19.ckpt");
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+tnn_error build(tnn_trainer_class *t, size_t niter){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, 0.0001, 0.01, 0.0, 100, niter)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,157 @@
+/* Dummy Test 20 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_sparse_from_matrix
+ * tnn_sparse_destroy
+ * tnn_module_init_linear_sparse
+ * tnn_module_linear_sparse_input
+ * tnn_trainer_class_train_sparse_nsgd
+ *
+ * The same linear-bias model is trained on sparse data stored in a dense matrix with the linear module, and
+ * in CSR form with the sparse linear module (whose weights are the transpose). The parameters must agree, and
+ * the sparse weight gradient must be zero outside the nonzero features of the last sample.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_sparse.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 200 //Input size
+#define B 3 //Number of classes
+#define Q 500 //Data size
+#define K 7 //Nonzeros per row (at most)
+
+tnn_error build(tnn_trainer_class *t, bool sparse);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_sparse sp;
+  tnn_param *p1, *p2;
+  gsl_matrix *inputs;
+  size_t *labels;
+  size_t i, j, k, n, zero;
+  double d;
+
+  //Generate the data
+  inputs = gsl_matrix_calloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(k = 0; k < K; k = k + 1){
+      j = (i*131 + k*k*17) % A;
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)));
+    }
+    gsl_matrix_set(inputs, i, labels[i], 1.0);
+  }
+  printf("Converting to CSR: %s\n", TEST_FUNC(tnn_sparse_from_matrix(&sp, inputs)));
+  tnn_sparse_row_nnz(&sp, 0, &n);
+  printf("Rows: %ld, nonzeros: %ld, in the first row: %ld\n", sp.size1, sp.nnz, n);
+  printf("Starting a new row: %s\n", TEST_FUNC(tnn_sparse_append(&sp, 5, 1.0)));
+  printf("Appending a decreasing column (should be NO): %s\n", TEST_FUNC(tnn_sparse_append(&sp, 0, 1.0)));
+
+  //The same model, dense and sparse
+  printf("Building the dense trainer: %s\n", TEST_FUNC(build(&t1, false)));
+  printf("Building the sparse trainer: %s\n", TEST_FUNC(build(&t2, true)));
+  tnn_machine_get_param(&t1.m, &p1);
+  tnn_machine_get_param(&t2.m, &p2);
+  for(i = 0; i < B; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      gsl_vector_set(&t2.m.min.w.x, j*B + i, gsl_vector_get(&t1.m.min.w.x, i*A + j));
+    }
+  }
+
+  printf("Training dense: %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("Training sparse: %s\n", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  d = 0.0;
+  for(i = 0; i < B; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      d = fmax(d, fabs(gsl_vector_get(&t2.m.min.w.x, j*B + i) - gsl_vector_get(&t1.m.min.w.x, i*A + j)));
+    }
+    d = fmax(d, fabs(gsl_vector_get(&t2.m.mout.w.x, i) - gsl_vector_get(&t1.m.mout.w.x, i)));
+  }
+  printf("Maximum parameter difference: %g, agree: %s\n", d, d < 1e-12 ? "YES" : "NO");
+
+  //Gradient outside the last sample
+  i = (((tnn_trainer_class_nsgd*)t2.c)->titer - 1) % Q;
+  zero = 1;
+  for(j = 0; j < A; j = j + 1){
+    if(gsl_matrix_get(inputs, i, j) == 0.0){
+      for(k = 0; k < B; k = k + 1){
+        zero = zero && gsl_vector_get(&t2.m.min.w.dx, j*B + k) == 0.0;
+      }
+    }
+  }
+  printf("Sparse gradient zero outside the nonzeros: %s\n", zero ? "YES" : "NO");
+
+  printf("Destroying the dense trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)));
+  printf("Destroying the sparse trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+  printf("Destroying the CSR matrix: %s\n", TEST_FUNC(tnn_sparse_destroy(&sp)));
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+tnn_error build(tnn_trainer_class *t, bool sparse){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, sparse ? 1 : A, B, lset, 0.0, 0.01, 0.0, 100, 3000)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if(sparse){
+    ret = tnn_module_init_linear_sparse(&m->min, A, h, p);
+  } else {
+    ret = tnn_module_init_linear(&m->min, sin, h, p);
+  }
+  if(ret != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/* Dummy Test 21 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_quant_machine
+ * tnn_quant_save
+ * tnn_quant_load
+ * tnn_module_fprop_linear_int8
+ * tnn_module_linear_int8_simd
+ *
+ * A linear-bias-linear-bias machine is quantized with calibration samples. The int8 outputs must stay close
+ * to the double ones, the SIMD and scalar kernels must agree exactly, and the saved file (test21.quant) loaded
+ * into a freshly built machine must give the same outputs from a file about an eighth of the parameter file size.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_linear_int8.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_quant.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 256 //Input size
+#define B 64 //Hidden size
+#define C 10 //Output size
+#define Q 200 //Data size
+
+tnn_error build(tnn_machine *m);
+void run(tnn_machine *m, gsl_matrix *inputs, gsl_matrix *outputs);
+double maxdiff(gsl_matrix *a, gsl_matrix *b);
+
+int main(){
+  tnn_machine m1, m2;
+  tnn_module *min;
+  gsl_matrix *inputs, *o1, *o2, *o3;
+  struct stat st1, st2;
+  size_t i, j;
+  double d, r;
+  int simd;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  o1 = gsl_matrix_alloc(Q, C);
+  o2 = gsl_matrix_alloc(Q, C);
+  o3 = gsl_matrix_alloc(Q, C);
+  for(i = 0; i < Q; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)));
+    }
+  }
+
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m1)));
+  run(&m1, inputs, o1);
+  r = maxdiff(o1, NULL);
+  tnn_param_save(&m1.p, "test21.param");
+
+  //Quantize and compare with double
+  printf("Quantizing the machine: %s\n", TEST_FUNC(tnn_quant_machine(&m1, inputs)));
+  tnn_machine_get_min(&m1, &min);
+  printf("Input module type is int8 linear: %s\n", min->t == TNN_MODULE_TYPE_LINEAR_INT8 ? "YES" : "NO");
+  run(&m1, inputs, o2);
+  d = maxdiff(o2, o1);
+  printf("Largest output: %g, largest int8 error: %g, within 2%%: %s\n", r, d, d < 0.02*r ? "YES" : "NO");
+
+  //SIMD against scalar
+  tnn_module_linear_int8_simd(&simd);
+  printf("SIMD kernel available: %d\n", simd);
+  run(&m1, inputs, o2);
+  ((tnn_module_linear_int8*)min->c)->simd = 0;
+  ((tnn_module_linear_int8*)m1.m->next->c)->simd = 0;
+  run(&m1, inputs, o3);
+  printf("Scalar kernel identical: %s\n", gsl_matrix_equal(o2, o3) ? "YES" : "NO");
+
+  //Save and load
+  printf("Saving the quantized machine: %s\n", TEST_FUNC(tnn_quant_save(&m1, "test21.quant")));
+  printf("Building the second machine: %s\n", TEST_FUNC(build(&m2)));
+  printf("Loading the quantized machine: %s\n", TEST_FUNC(tnn_quant_load(&m2, "test21.quant")));
+  run(&m2, inputs, o3);
+  printf("Loaded machine identical: %s\n", gsl_matrix_equal(o2, o3) ? "YES" : "NO");
+  stat("test21.param", &st1);
+  stat("test21.quant", &st2);
+  printf("Parameter file: %ld bytes, quantized file: %ld bytes, ratio %.2f\n",
+         (long)st1.st_size, (long)st2.st_size, (double)st1.st_size/(double)st2.st_size);
+
+  printf("Destroying the first machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m1)));
+  printf("Destroying the second machine: %s\n", TEST_FUNC(tnn_machine_destroy(&m2)));
+  remove("test21.param");
+  remove("test21.quant");
+  gsl_matrix_free(inputs);
+  gsl_matrix_free(o1);
+  gsl_matrix_free(o2);
+  gsl_matrix_free(o3);
+
+  return 0;
+}
+
+void run(tnn_machine *m, gsl_matrix *inputs, gsl_matrix *outputs){
+  tnn_state *sin, *sout;
+  gsl_vector_view v;
+  size_t i;
+
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  for(i = 0; i < inputs->size1; i = i + 1){
+    v = gsl_matrix_row(inputs, i);
+    gsl_vector_memcpy(&sin->x, &v.vector);
+    tnn_machine_fprop(m);
+    v = gsl_matrix_row(outputs, i);
+    gsl_vector_memcpy(&v.vector, &sout->x);
+  }
+}
+
+double maxdiff(gsl_matrix *a, gsl_matrix *b){
+  size_t i, j;
+  double d;
+
+  d = 0.0;
+  for(i = 0; i < a->size1; i = i + 1){
+    for(j = 0; j < a->size2; j = j + 1){
+      d = fmax(d, fabs(gsl_matrix_get(a, i, j) - (b == NULL ? 0.0 : gsl_matrix_get(b, i, j))));
+    }
+  }
+  return d;
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_param *p;
+  tnn_state *in, *out, *h1, *h2, *h3;
+  tnn_module *min, *mout, *mod;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, C)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_linear(mod, h2, h3, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_bias(mout, h3, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
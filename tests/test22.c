@@ -0,0 +1,218 @@
+/* Dummy Test 22 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_ingest_dense
+ * tnn_ingest_sparse
+ * tnn_ingest_dataset
+ * tnn_ingest_sparse_cached
+ *
+ * The same random data is written as CSV (test22.csv) and libsvm (test22.svm) text, with many zeros left out
+ * of the libsvm file. Both are parsed back with 1 and 4 threads and must equal the data exactly. The caches
+ * (test22.data, test22.sprs) are created on the first call and loaded on the second, which should be much
+ * faster. Asking for another number of columns must rebuild a cache rather than load it, and a sparse cache
+ * with an out-of-range column index or decreasing row pointers must be refused. A malformed line must be
+ * rejected.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_sparse.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_ingest.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 32 //Input size
+#define Q 50000 //Data size
+
+int same(gsl_matrix *a, size_t *la, gsl_matrix *b, size_t *lb);
+double elapsed(struct timespec *c);
+
+int main(){
+  gsl_matrix *inputs, *m1, *m4, *ds_inputs;
+  size_t *labels, *l1, *l4, *lc, *ds_labels, i, j, k, nnz;
+  uint64_t v, w;
+  long off;
+  tnn_sparse s, sc;
+  tnn_dataset ds;
+  struct timespec c;
+  FILE *fp, *fs;
+  int ok;
+
+  //Generate the data with about a third of zeros, and write it as text
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *) malloc(Q*sizeof(size_t));
+  fp = fopen("test22.csv", "w");
+  fs = fopen("test22.svm", "w");
+  nnz = 0;
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % 2;
+    fprintf(fp, "%ld", labels[i]);
+    fprintf(fs, "%s", labels[i] == 0 ? "-1" : "+1");
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, rand() % 3 == 0 ? 0.0 : (double)rand()/RAND_MAX - 0.5);
+      fprintf(fp, ",%.17g", gsl_matrix_get(inputs, i, j));
+      if(gsl_matrix_get(inputs, i, j) != 0.0){
+	fprintf(fs, " %ld:%.17g", j + 1, gsl_matrix_get(inputs, i, j));
+	nnz = nnz + 1;
+      }
+    }
+    fprintf(fp, "\n");
+    fprintf(fs, "\n");
+  }
+  fclose(fp);
+  fclose(fs);
+  remove("test22.data");
+  remove("test22.sprs");
+
+  //Dense CSV
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("CSV 1 thread: %s, ", TEST_FUNC(tnn_ingest_dense("test22.csv", TNN_INGEST_FORMAT_CSV, 0, 1, &m1, &l1)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("CSV 4 threads: %s, ", TEST_FUNC(tnn_ingest_dense("test22.csv", TNN_INGEST_FORMAT_CSV, 0, 4, &m4, &l4)));
+  printf("%g s\n", elapsed(&c));
+  printf("CSV equal: 1 thread %d, 4 threads %d\n", same(inputs, labels, m1, l1), same(inputs, labels, m4, l4));
+  gsl_matrix_free(m1);
+  gsl_matrix_free(m4);
+  free(l1);
+  free(l4);
+
+  //Dense libsvm
+  printf("libsvm dense: %s, ", TEST_FUNC(tnn_ingest_dense("test22.svm", TNN_INGEST_FORMAT_LIBSVM, A, 4, &m4, &l4)));
+  printf("equal %d\n", same(inputs, labels, m4, l4));
+  gsl_matrix_free(m4);
+  free(l4);
+
+  //Sparse libsvm
+  printf("libsvm sparse: %s, ", TEST_FUNC(tnn_ingest_sparse("test22.svm", 0, 4, &s, &l4)));
+  ok = s.size1 == Q && s.size2 == A && s.nnz == nnz;
+  for(i = 0; i < Q && ok; i = i + 1){
+    ok = labels[i] == l4[i];
+    for(k = s.ptr[i]; k < s.ptr[i + 1] && ok; k = k + 1){
+      ok = gsl_matrix_get(inputs, i, s.ind[k]) == s.val[k];
+    }
+  }
+  printf("size1 = %ld, size2 = %ld, nnz = %ld (expected %ld), equal %d\n", s.size1, s.size2, s.nnz, nnz, ok);
+  free(l4);
+
+  //Dataset cache
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Dataset cache create: %s, ",
+	 TEST_FUNC(tnn_ingest_dataset("test22.csv", "test22.data", TNN_INGEST_FORMAT_CSV, 0, 4, &ds)));
+  printf("%g s\n", elapsed(&c));
+  tnn_dataset_close(&ds);
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Dataset cache load: %s, ",
+	 TEST_FUNC(tnn_ingest_dataset("test22.csv", "test22.data", TNN_INGEST_FORMAT_CSV, 0, 4, &ds)));
+  printf("%g s, ", elapsed(&c));
+  tnn_dataset_get_inputs(&ds, &ds_inputs);
+  tnn_dataset_get_labels(&ds, &ds_labels);
+  printf("equal %d\n", same(inputs, labels, ds_inputs, ds_labels));
+  tnn_dataset_close(&ds);
+
+  //Sparse cache
+  printf("Sparse cache create: %s, ", TEST_FUNC(tnn_ingest_sparse_cached("test22.svm", "test22.sprs", 0, 4, &sc, &lc)));
+  tnn_sparse_destroy(&sc);
+  free(lc);
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("load: %s, ", TEST_FUNC(tnn_ingest_sparse_cached("test22.svm", "test22.sprs", 0, 4, &sc, &lc)));
+  printf("%g s, ", elapsed(&c));
+  ok = sc.size1 == s.size1 && sc.size2 == s.size2 && sc.nnz == s.nnz;
+  for(i = 0; i <= s.size1 && ok; i = i + 1){
+    ok = sc.ptr[i] == s.ptr[i] && (i == s.size1 || lc[i] == labels[i]);
+  }
+  for(k = 0; k < s.nnz && ok; k = k + 1){
+    ok = sc.ind[k] == s.ind[k] && sc.val[k] == s.val[k];
+  }
+  printf("equal %d\n", ok);
+  tnn_sparse_destroy(&sc);
+  free(lc);
+
+  //Caches built with another number of columns
+  printf("Dataset cache with more columns: %s, ",
+	 TEST_FUNC(tnn_ingest_dataset("test22.svm", "test22.data", TNN_INGEST_FORMAT_LIBSVM, A + 8, 4, &ds)));
+  tnn_dataset_get_inputs(&ds, &ds_inputs);
+  printf("size2 = %ld (expected %d)\n", ds_inputs->size2, A + 8);
+  tnn_dataset_close(&ds);
+  printf("Sparse cache with more columns: %s, ",
+	 TEST_FUNC(tnn_ingest_sparse_cached("test22.svm", "test22.sprs", A + 8, 4, &sc, &lc)));
+  printf("size2 = %ld (expected %d)\n", sc.size2, A + 8);
+  tnn_sparse_destroy(&sc);
+  free(lc);
+
+  //Corrupt sparse cache: a column index out of range, then decreasing row pointers
+  off = (long)(sizeof(tnn_ingest_sparse_header) + sizeof(tnn_ingest_key));
+  fp = fopen("test22.sprs", "r+b");
+  fseek(fp, off + (long)((s.size1 + 1)*sizeof(uint64_t)), SEEK_SET);
+  fread(&w, sizeof(uint64_t), 1, fp);
+  v = A + 8;
+  fseek(fp, off + (long)((s.size1 + 1)*sizeof(uint64_t)), SEEK_SET);
+  fwrite(&v, sizeof(uint64_t), 1, fp);
+  fclose(fp);
+  printf("Sparse cache with a column out of range (should be NO): %s\n",
+	 TEST_FUNC(tnn_ingest_sparse_cached("test22.svm", "test22.sprs", A + 8, 4, &sc, &lc)));
+  fp = fopen("test22.sprs", "r+b");
+  fseek(fp, off + (long)((s.size1 + 1)*sizeof(uint64_t)), SEEK_SET);
+  fwrite(&w, sizeof(uint64_t), 1, fp);
+  v = s.nnz;
+  fseek(fp, off + (long)sizeof(uint64_t), SEEK_SET);
+  fwrite(&v, sizeof(uint64_t), 1, fp);
+  fclose(fp);
+  printf("Sparse cache with decreasing row pointers (should be NO): %s\n",
+	 TEST_FUNC(tnn_ingest_sparse_cached("test22.svm", "test22.sprs", A + 8, 4, &sc, &lc)));
+  tnn_sparse_destroy(&s);
+
+  //Malformed text
+  fp = fopen("test22.bad", "w");
+  fprintf(fp, "1,0.5,0.25\n0,0.5\n");
+  fclose(fp);
+  printf("Malformed CSV (should be NO): %s\n",
+	 TEST_FUNC(tnn_ingest_dense("test22.bad", TNN_INGEST_FORMAT_CSV, 0, 1, &m1, &l1)));
+  fp = fopen("test22.bad", "w");
+  fprintf(fp, "1 3:0.5 2:0.25\n");
+  fclose(fp);
+  printf("Decreasing libsvm index (should be NO): %s\n",
+	 TEST_FUNC(tnn_ingest_sparse("test22.bad", 0, 1, &s, &l1)));
+
+  gsl_matrix_free(inputs);
+  free(labels);
+  return 0;
+}
+
+//Whether two matrices and label arrays are exactly equal
+int same(gsl_matrix *a, size_t *la, gsl_matrix *b, size_t *lb){
+  size_t i, j;
+
+  if(a->size1 != b->size1 || a->size2 != b->size2){
+    return 0;
+  }
+  for(i = 0; i < a->size1; i = i + 1){
+    if(la[i] != lb[i]){
+      return 0;
+    }
+    for(j = 0; j < a->size2; j = j + 1){
+      if(gsl_matrix_get(a, i, j) != gsl_matrix_get(b, i, j)){
+	return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
@@ -0,0 +1,269 @@
+/* Dummy Test 23 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_machine_save
+ * tnn_machine_load
+ * tnn_param_reserve
+ *
+ * A linear-sum-bias-linear-bias machine is saved (test23.machine) and loaded without any building code. The
+ * loaded machine must have the same io and parameter sizes and give identical outputs, also after int8
+ * quantization. A chain of many bias modules is then built in code and loaded from its file, and loading
+ * should be much faster since io and p are allocated once. Every truncation of the quantized machine file
+ * and a state count too large to allocate must be refused, leaving nothing allocated.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+#include <tnn/tnn_quant.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 20 //Input size
+#define B 16 //Hidden size
+#define C 5 //Output size
+#define Q 50 //Data size
+#define N 1000 //Modules in the chain
+#define D 200 //Size of the chain states
+#define T 64 //Truncations of the machine file
+
+tnn_error build(tnn_machine *m);
+tnn_error chain(tnn_machine *m);
+void run(tnn_machine *m, gsl_matrix *inputs, gsl_matrix *outputs);
+size_t refused(const char *file);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_machine m1, m2;
+  gsl_matrix *inputs, *o1, *o2;
+  struct timespec c;
+  size_t i, j;
+
+  inputs = gsl_matrix_alloc(Q, A);
+  o1 = gsl_matrix_alloc(Q, C);
+  o2 = gsl_matrix_alloc(Q, C);
+  for(i = 0; i < Q; i = i + 1){
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, cos((double)(i*A + j)));
+    }
+  }
+
+  //Save and load
+  printf("Building the machine: %s\n", TEST_FUNC(build(&m1)));
+  printf("Saving the machine: %s\n", TEST_FUNC(tnn_machine_save(&m1, "test23.machine")));
+  printf("Loading the machine: %s\n", TEST_FUNC(tnn_machine_load(&m2, "test23.machine")));
+  printf("io size %ld = %ld, p size %ld = %ld, modules %s\n", m1.io.size, m2.io.size, m1.p.size, m2.p.size,
+	 m2.m != NULL && m2.m->t == TNN_MODULE_TYPE_SUM && m2.mout.t == TNN_MODULE_TYPE_BIAS ? "YES" : "NO");
+  run(&m1, inputs, o1);
+  run(&m2, inputs, o2);
+  printf("Outputs identical: %s\n", gsl_matrix_equal(o1, o2) ? "YES" : "NO");
+  printf("Parameters identical: %s\n", gsl_vector_equal(m1.p.x, m2.p.x) ? "YES" : "NO");
+  tnn_machine_destroy(&m2);
+
+  //Quantized machine
+  printf("Quantizing the machine: %s\n", TEST_FUNC(tnn_quant_machine(&m1, inputs)));
+  printf("Saving the quantized machine: %s\n", TEST_FUNC(tnn_machine_save(&m1, "test23.machine")));
+  printf("Loading the quantized machine: %s\n", TEST_FUNC(tnn_machine_load(&m2, "test23.machine")));
+  run(&m1, inputs, o1);
+  run(&m2, inputs, o2);
+  printf("Quantized outputs identical: %s\n", gsl_matrix_equal(o1, o2) ? "YES" : "NO");
+  i = refused("test23.machine");
+  printf("Truncated files refused: %ld of %d\n", i, T);
+  tnn_machine_destroy(&m1);
+  tnn_machine_destroy(&m2);
+
+  //Startup time of a long chain
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Building a chain of %d modules: %s, ", N, TEST_FUNC(chain(&m1)));
+  printf("%g s\n", elapsed(&c));
+  printf("Saving the chain: %s\n", TEST_FUNC(tnn_machine_save(&m1, "test23.machine")));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Loading the chain: %s, ", TEST_FUNC(tnn_machine_load(&m2, "test23.machine")));
+  printf("%g s\n", elapsed(&c));
+  printf("Chain parameters identical: %s\n", gsl_vector_equal(m1.p.x, m2.p.x) ? "YES" : "NO");
+  tnn_machine_destroy(&m1);
+  tnn_machine_destroy(&m2);
+
+  gsl_matrix_free(inputs);
+  gsl_matrix_free(o1);
+  gsl_matrix_free(o2);
+  return 0;
+}
+
+tnn_error build(tnn_machine *m){
+  tnn_param *p, *io;
+  tnn_state *in, *out, *h1, *h2, *h3, *h4;
+  tnn_module *min, *mout, *mod;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, A, C)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_io(m, &io);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  h4 = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, 2*B);
+  tnn_state_init(h2, B);
+  tnn_state_init(h3, B);
+  tnn_state_init(h4, C);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+  tnn_machine_state_alloc(m, h4);
+
+  if((ret = tnn_module_init_linear(min, in, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_sum(mod, h1, h2, io)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h2, h3, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_linear(mod, h3, h4, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_bias(mout, h4, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Deterministic weights
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, sin(0.37*(double)i + 0.1)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error chain(tnn_machine *m){
+  tnn_param *p;
+  tnn_state *in, *out, *s, *t;
+  tnn_module *min, *mout, *mod;
+  tnn_error ret;
+  size_t i;
+
+  if((ret = tnn_machine_init(m, D, D)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &in);
+  tnn_machine_get_sout(m, &out);
+  tnn_machine_get_min(m, &min);
+  tnn_machine_get_mout(m, &mout);
+
+  //Every module allocates its output in io and its weights in p
+  s = in;
+  for(i = 0; i + 1 < N; i = i + 1){
+    t = malloc(sizeof(tnn_state));
+    tnn_state_init(t, D);
+    tnn_machine_state_alloc(m, t);
+    mod = i == 0 ? min : malloc(sizeof(tnn_module));
+    if((ret = tnn_module_init_bias(mod, s, t, p)) != TNN_ERROR_SUCCESS){
+      return ret;
+    }
+    if(i > 0){
+      tnn_machine_module_append(m, mod);
+    }
+    s = t;
+  }
+  if((ret = tnn_module_init_bias(mout, s, out, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, (double)i);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+void run(tnn_machine *m, gsl_matrix *inputs, gsl_matrix *outputs){
+  gsl_vector_view in, out;
+  size_t i;
+
+  for(i = 0; i < inputs->size1; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    out = gsl_matrix_row(outputs, i);
+    gsl_vector_memcpy(&m->sin->x, &in.vector);
+    tnn_machine_fprop(m);
+    gsl_vector_memcpy(&out.vector, &m->sout->x);
+  }
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
+
+//Number of truncations of a machine file that fail to load, with the header then given too many states
+size_t refused(const char *file){
+  tnn_machine_header *h;
+  tnn_machine m;
+  size_t n, k, count;
+  char *buf;
+  FILE *fp;
+
+  fp = fopen(file, "rb");
+  fseek(fp, 0, SEEK_END);
+  n = (size_t) ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  buf = (char *) malloc(n);
+  fread(buf, 1, n, fp);
+  fclose(fp);
+
+  count = 0;
+  for(k = 0; k < T; k = k + 1){
+    fp = fopen("test23.bad", "wb");
+    fwrite(buf, 1, n*k/T, fp);
+    fclose(fp);
+    if(tnn_machine_load(&m, "test23.bad") != TNN_ERROR_SUCCESS){
+      count = count + 1;
+    } else {
+      tnn_machine_destroy(&m);
+    }
+  }
+
+  h = (tnn_machine_header *) buf;
+  h->nstates = UINT64_MAX/2;
+  fp = fopen("test23.bad", "wb");
+  fwrite(buf, 1, n, fp);
+  fclose(fp);
+  printf("Too many states (should be NO): %s\n", TEST_FUNC(tnn_machine_load(&m, "test23.bad")));
+
+  free(buf);
+  return count;
+}
@@ -0,0 +1,140 @@
+/* Dummy Test 24 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_shuffle_nsgd
+ *
+ * The data is sorted by label, so visiting it in order trains on long runs of a single class. Two trainers
+ * shuffled with the same seed must give identical parameters, and another seed or the plain order must not.
+ * A shuffled run interrupted by a checkpoint (test24.ckpt) and resumed must also be identical. The test loss
+ * and error of the shuffled and the in-order runs are printed, and the shuffled loss should be lower.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 900 //Data size
+#define N 2700 //Total steps
+#define M 1300 //Steps before interruption
+#define S 7 //Seed
+
+tnn_error build(tnn_trainer_class *t, size_t niter);
+
+int main(){
+  tnn_trainer_class t1, t2, t3, t4, t5, t6;
+  tnn_param *p1, *p2, *p3, *p4, *p6;
+  gsl_matrix *inputs;
+  size_t *labels;
+  size_t i, j;
+  double l1, l4, e1, e4;
+
+  //Generate the data sorted by label
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i*B/Q;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 1.0 : 0.0));
+    }
+  }
+
+  printf("Building the trainers: %s %s %s %s %s %s\n", TEST_FUNC(build(&t1, N)), TEST_FUNC(build(&t2, N)),
+	 TEST_FUNC(build(&t3, N)), TEST_FUNC(build(&t4, N)), TEST_FUNC(build(&t5, M)), TEST_FUNC(build(&t6, N)));
+  tnn_machine_get_param(&t1.m, &p1);
+  tnn_machine_get_param(&t2.m, &p2);
+  tnn_machine_get_param(&t3.m, &p3);
+  tnn_machine_get_param(&t4.m, &p4);
+  tnn_machine_get_param(&t6.m, &p6);
+
+  printf("Shuffling: %s %s %s\n", TEST_FUNC(tnn_trainer_class_shuffle_nsgd(&t1, S, 0)),
+	 TEST_FUNC(tnn_trainer_class_shuffle_nsgd(&t2, S, 4)), TEST_FUNC(tnn_trainer_class_shuffle_nsgd(&t3, S + 1, 4)));
+  printf("Training: %s %s %s %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)),
+	 TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)), TEST_FUNC(tnn_trainer_class_train(&t3, inputs, labels)),
+	 TEST_FUNC(tnn_trainer_class_train(&t4, inputs, labels)));
+  printf("Same seed identical: %s\n", gsl_vector_equal(p1->x, p2->x) ? "YES" : "NO");
+  printf("Other seed identical (should be NO): %s\n", gsl_vector_equal(p1->x, p3->x) ? "YES" : "NO");
+  printf("In order identical (should be NO): %s\n", gsl_vector_equal(p1->x, p4->x) ? "YES" : "NO");
+
+  //Interrupt and resume a shuffled run
+  printf("Shuffling: %s\n", TEST_FUNC(tnn_trainer_class_shuffle_nsgd(&t5, S, 4)));
+  printf("Setting the checkpoint: %s\n", TEST_FUNC(tnn_trainer_class_checkpoint_nsgd(&t5, "test24.ckpt", 100)));
+  printf("Training with checkpoints: %s\n", TEST_FUNC(tnn_trainer_class_train(&t5, inputs, labels)));
+  printf("Finishing the checkpoint: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t5)));
+  printf("Shuffling: %s\n", TEST_FUNC(tnn_trainer_class_shuffle_nsgd(&t6, S, 4)));
+  printf("Resuming: %s\n", TEST_FUNC(tnn_trainer_class_resume_nsgd(&t6, "test24.ckpt")));
+  printf("Training the rest: %s\n", TEST_FUNC(tnn_trainer_class_train(&t6, inputs, labels)));
+  printf("Resumed identical: %s\n", gsl_vector_equal(p1->x, p6->x) ? "YES" : "NO");
+
+  //Test errors
+  tnn_trainer_class_test(&t1, inputs, labels, &l1, &e1);
+  tnn_trainer_class_test(&t4, inputs, labels, &l4, &e4);
+  printf("Shuffled: loss = %g, error = %g; in order: loss = %g, error = %g\n", l1, e1, l4, e4);
+
+  printf("Destroying the trainers: %s %s %s %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t2)), TEST_FUNC(tnn_trainer_class_destroy(&t3)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t4)), TEST_FUNC(tnn_trainer_class_destroy(&t6)));
+  remove("test24.ckpt");
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+tnn_error build(tnn_trainer_class *t, size_t niter){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, 0.0001, 0.01, 0.0, 100, niter)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/* Dummy Test 25 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_stream_init
+ * tnn_stream_fetch
+ * tnn_stream_destroy
+ * tnn_dataset_read
+ *
+ * A dataset (test25.data) whose row i holds i is streamed through a loader for two epochs. Every epoch must
+ * visit every row exactly once with its label, the two epochs must differ, and a second stream with the same
+ * seed must give the same order. The mean distance between the position of a sample and its row is printed
+ * for the stream and for the plain order (which is 0), and should be a good fraction of the data size. The
+ * time of an epoch through the stream and through tnn_loader_fetch_dataset are printed and should be close.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_loader.h>
+#include <tnn/tnn_stream.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 16 //Input size
+#define Q 100000 //Data size
+#define K 1000 //Rows in a block
+#define P 8 //Blocks in the pool
+#define D 64 //Depth of the loader
+#define S 3 //Seed
+
+tnn_error epoch(tnn_loader *ld, size_t *order);
+double elapsed(struct timespec *c);
+
+int main(){
+  gsl_matrix *inputs;
+  size_t *labels, *o1, *o2, *o3, *seen;
+  size_t i, j, ok;
+  double dist;
+  tnn_dataset ds;
+  tnn_stream st, st2;
+  tnn_loader ld;
+  struct timespec c;
+
+  //Write the dataset
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *) malloc(Q*sizeof(size_t));
+  o1 = (size_t *) malloc(Q*sizeof(size_t));
+  o2 = (size_t *) malloc(Q*sizeof(size_t));
+  o3 = (size_t *) malloc(Q*sizeof(size_t));
+  seen = (size_t *) calloc(Q, sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % 10;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, (double)i);
+    }
+  }
+  printf("Writing the dataset: %s\n", TEST_FUNC(tnn_dataset_write("test25.data", inputs, labels)));
+  printf("Opening the dataset: %s\n", TEST_FUNC(tnn_dataset_open(&ds, "test25.data")));
+
+  printf("Invalid stream (should be NO): %s\n", TEST_FUNC(tnn_stream_init(&st, &ds, 0, P, S)));
+
+  //Two epochs through the stream
+  printf("Initializing the stream: %s\n", TEST_FUNC(tnn_stream_init(&st, &ds, K, P, S)));
+  printf("Initializing the loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, tnn_stream_fetch, &st, Q, A, D)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Epoch 1: %s, ", TEST_FUNC(epoch(&ld, o1)));
+  printf("%g s\n", elapsed(&c));
+  printf("Epoch 2: %s\n", TEST_FUNC(epoch(&ld, o2)));
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+
+  for(ok = 1, i = 0; i < Q; i = i + 1){
+    seen[o1[i]] = seen[o1[i]] + 1;
+    seen[o2[i]] = seen[o2[i]] + 2;
+  }
+  for(i = 0; i < Q; i = i + 1){
+    ok = ok && seen[i] == 3;
+  }
+  printf("Every row once per epoch: %s\n", ok ? "YES" : "NO");
+  for(ok = 1, i = 0; i < Q; i = i + 1){
+    ok = ok && o1[i] == o2[i];
+  }
+  printf("Epochs identical (should be NO): %s\n", ok ? "YES" : "NO");
+  for(dist = 0.0, i = 0; i < Q; i = i + 1){
+    dist = dist + (o1[i] > i ? (double)(o1[i] - i) : (double)(i - o1[i]));
+  }
+  printf("Mean distance from the row: %g (plain order 0, uniform shuffle %g)\n", dist/Q, Q/3.0);
+
+  //Same seed
+  printf("Second stream with the same seed: %s\n", TEST_FUNC(tnn_stream_init(&st2, &ds, K, P, S)));
+  printf("Initializing the loader: %s\n", TEST_FUNC(tnn_loader_init(&ld, tnn_stream_fetch, &st2, Q, A, D)));
+  printf("Epoch 1: %s\n", TEST_FUNC(epoch(&ld, o3)));
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+  for(ok = 1, i = 0; i < Q; i = i + 1){
+    ok = ok && o1[i] == o3[i];
+  }
+  printf("Same order: %s\n", ok ? "YES" : "NO");
+
+  //Sequential epoch for comparison
+  printf("Initializing the sequential loader: %s\n",
+	 TEST_FUNC(tnn_loader_init(&ld, tnn_loader_fetch_dataset, &ds, Q, A, D)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Sequential epoch: %s, ", TEST_FUNC(epoch(&ld, o3)));
+  printf("%g s\n", elapsed(&c));
+  printf("Destroying the loader: %s\n", TEST_FUNC(tnn_loader_destroy(&ld)));
+
+  printf("Destroying the streams: %s %s\n", TEST_FUNC(tnn_stream_destroy(&st)), TEST_FUNC(tnn_stream_destroy(&st2)));
+  printf("Closing the dataset: %s\n", TEST_FUNC(tnn_dataset_close(&ds)));
+  remove("test25.data");
+  gsl_matrix_free(inputs);
+  free(labels);
+  free(o1);
+  free(o2);
+  free(o3);
+  free(seen);
+  return 0;
+}
+
+//Pull an epoch from the loader and record the rows in order, checking the rows and labels
+tnn_error epoch(tnn_loader *ld, size_t *order){
+  gsl_vector_view x;
+  size_t i, j, label;
+  tnn_error ret;
+
+  for(i = 0; i < Q; i = i + 1){
+    if((ret = tnn_loader_pull(ld, &x, &label)) != TNN_ERROR_SUCCESS){
+      return ret;
+    }
+    order[i] = (size_t)gsl_vector_get(&x.vector, 0);
+    for(j = 1; j < A; j = j + 1){
+      if(gsl_vector_get(&x.vector, j) != (double)order[i]){
+	return TNN_ERROR_FAILURE;
+      }
+    }
+    if(order[i] >= Q || label != order[i] % 10){
+      return TNN_ERROR_FAILURE;
+    }
+    tnn_loader_release(ld);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
@@ -0,0 +1,160 @@
+/* Dummy Test 26 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_init_msgd
+ * tnn_trainer_class_learn_msgd
+ * tnn_trainer_class_train_msgd
+ * tnn_trainer_class_titer_msgd
+ *
+ * With mu = 0, both momentum trainers must follow the naive SGD trainer step by step (up to rounding), with
+ * the L2 and the L1 regularizers. Then naive, heavy-ball and Nesterov trainers are trained for N steps from
+ * the same weights and their test losses printed; the momentum ones should be lower. An invalid momentum
+ * must be rejected.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l1.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_trainer_class_msgd.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define N 3000 //Training steps
+#define L 50 //Steps compared
+
+tnn_error init(tnn_trainer_class *t, int type, double mu, int nesterov, int l1);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+
+int main(){
+  tnn_trainer_class t1, t2, t3;
+  gsl_matrix *inputs;
+  gsl_vector_view in;
+  size_t *labels;
+  size_t i, j, titer;
+  double l1, l2, l3, e;
+  int l;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 0.5 : 0.0));
+    }
+  }
+
+  //Without momentum, step by step
+  for(l = 0; l < 2; l = l + 1){
+    printf("Building the %s trainers: %s %s %s\n", l ? "L1" : "L2", TEST_FUNC(init(&t1, 0, 0.0, 0, l)),
+	   TEST_FUNC(init(&t2, 1, 0.0, 0, l)), TEST_FUNC(init(&t3, 1, 0.0, 1, l)));
+    for(i = 0; i < L; i = i + 1){
+      in = gsl_matrix_row(inputs, i);
+      tnn_trainer_class_learn(&t1, &in.vector, labels[i]);
+      tnn_trainer_class_learn(&t2, &in.vector, labels[i]);
+      tnn_trainer_class_learn(&t3, &in.vector, labels[i]);
+    }
+    printf("Heavy-ball difference: %g, Nesterov difference: %g\n", diff(&t1, &t2), diff(&t1, &t3));
+    tnn_trainer_class_destroy(&t1);
+    tnn_trainer_class_destroy(&t2);
+    tnn_trainer_class_destroy(&t3);
+  }
+
+  //Training with momentum
+  printf("Invalid momentum (should be NO): %s\n", TEST_FUNC(init(&t1, 1, 1.0, 0, 0)));
+  printf("Building the trainers: %s %s %s\n", TEST_FUNC(init(&t1, 0, 0.0, 0, 0)),
+	 TEST_FUNC(init(&t2, 1, 0.9, 0, 0)), TEST_FUNC(init(&t3, 1, 0.9, 1, 0)));
+  printf("Training naive: %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("Training heavy-ball: %s\n", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("Training Nesterov: %s\n", TEST_FUNC(tnn_trainer_class_train(&t3, inputs, labels)));
+  printf("Getting the steps: %s, ", TEST_FUNC(tnn_trainer_class_titer_msgd(&t2, &titer)));
+  printf("%ld\n", titer);
+  tnn_trainer_class_test(&t1, inputs, labels, &l1, &e);
+  tnn_trainer_class_test(&t2, inputs, labels, &l2, &e);
+  tnn_trainer_class_test(&t3, inputs, labels, &l3, &e);
+  printf("Test loss: naive = %g, heavy-ball = %g, Nesterov = %g\n", l1, l2, l3);
+
+  printf("Destroying the trainers: %s %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t2)), TEST_FUNC(tnn_trainer_class_destroy(&t3)));
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build a naive (type 0) or momentum (type 1) trainer with fixed weights, and an L2 or L1 regularizer
+tnn_error init(tnn_trainer_class *t, int type, double mu, int nesterov, int l1){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  ret = type == 0 ? tnn_trainer_class_init_nsgd(t, A, B, lset, 0.001, 0.005, 0.0, 100, N)
+    : tnn_trainer_class_init_msgd(t, A, B, lset, 0.001, 0.005, mu, nesterov, 0.0, 100, N);
+  if(ret != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = (l1 ? tnn_reg_init_l1(&t->r) : tnn_reg_init_l2(&t->r))) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
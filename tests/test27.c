@@ -0,0 +1,193 @@
+/* Dummy Test 27 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_init_adagrad
+ * tnn_trainer_class_init_rmsprop
+ * tnn_trainer_class_init_adam
+ * tnn_trainer_class_learn_adapt
+ * tnn_trainer_class_train_adapt
+ *
+ * For each adaptive trainer, L steps are learnt one by one while a reference keeps its own moments and
+ * applies the textbook update to a copy of the parameters from the gradient left in dx; the largest
+ * difference is printed and should be at rounding level. Then naive SGD and the three adaptive trainers are
+ * trained for N steps from the same weights (AdaGrad with a larger step size, as its steps only shrink) and
+ * their test losses printed. Invalid decays must be rejected.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_trainer_class_adapt.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define N 3000 //Training steps
+#define L 50 //Steps compared
+#define LAMBDA 0.001
+#define ETA 0.01 //Step size of naive SGD, RMSProp and Adam, and the reference
+#define ETA_ADAGRAD 0.1 //Step size of AdaGrad in training
+#define BETA1 0.9
+#define BETA2 0.99
+#define DELTA 1e-8
+
+tnn_error init(tnn_trainer_class *t, int type, double eta);
+double check(tnn_trainer_class *t, int type, gsl_matrix *inputs, size_t *labels);
+
+int main(){
+  tnn_trainer_class t[4];
+  gsl_matrix *inputs, *lset;
+  size_t *labels;
+  size_t i, j;
+  double l[4], e;
+  int k;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 0.5 : 0.0));
+    }
+  }
+
+  lset = gsl_matrix_alloc(B, B);
+  printf("Invalid decays (should be NO): %s %s\n",
+	 TEST_FUNC(tnn_trainer_class_init_rmsprop(&t[0], A, B, lset, LAMBDA, ETA, 1.0, DELTA, 0.0, 100, N)),
+	 TEST_FUNC(tnn_trainer_class_init_adam(&t[0], A, B, lset, LAMBDA, ETA, -0.1, BETA2, DELTA, 0.0, 100, N)));
+  gsl_matrix_free(lset);
+
+  //Against the reference
+  for(k = 1; k < 4; k = k + 1){
+    printf("Building the %s trainer: %s\n", k == 1 ? "AdaGrad" : (k == 2 ? "RMSProp" : "Adam"), TEST_FUNC(init(&t[k], k, 0.0)));
+    printf("Largest difference to the reference: %g\n", check(&t[k], k, inputs, labels));
+    tnn_trainer_class_destroy(&t[k]);
+  }
+
+  //Training
+  for(k = 0; k < 4; k = k + 1){
+    printf("Building and training trainer %d: %s, ", k, TEST_FUNC(init(&t[k], k, ETA_ADAGRAD)));
+    printf("%s\n", TEST_FUNC(tnn_trainer_class_train(&t[k], inputs, labels)));
+    tnn_trainer_class_test(&t[k], inputs, labels, &l[k], &e);
+  }
+  printf("Test loss: naive = %g, AdaGrad = %g, RMSProp = %g, Adam = %g\n", l[0], l[1], l[2], l[3]);
+  printf("Destroying the trainers: %s %s %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t[0])),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t[1])), TEST_FUNC(tnn_trainer_class_destroy(&t[2])),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t[3])));
+
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build a naive (type 0), AdaGrad (1), RMSProp (2) or Adam (3) trainer with fixed weights
+//AdaGrad uses eta instead of ETA if it is not 0.
+tnn_error init(tnn_trainer_class *t, int type, double eta){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if(type == 0){
+    ret = tnn_trainer_class_init_nsgd(t, A, B, lset, LAMBDA, ETA, 0.0, 100, N);
+  } else if(type == 1){
+    ret = tnn_trainer_class_init_adagrad(t, A, B, lset, LAMBDA, eta == 0.0 ? ETA : eta, DELTA, 0.0, 100, N);
+  } else if(type == 2){
+    ret = tnn_trainer_class_init_rmsprop(t, A, B, lset, LAMBDA, ETA, BETA2, DELTA, 0.0, 100, N);
+  } else {
+    ret = tnn_trainer_class_init_adam(t, A, B, lset, LAMBDA, ETA, BETA1, BETA2, DELTA, 0.0, 100, N);
+  }
+  if(ret != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Learn L samples and follow them with the reference update, returning the largest difference
+double check(tnn_trainer_class *t, int type, gsl_matrix *inputs, size_t *labels){
+  tnn_param *p;
+  gsl_vector_view in;
+  double *x, *m, *s, g, a, d;
+  size_t i, k;
+
+  tnn_machine_get_param(&t->m, &p);
+  x = (double *) malloc(p->size*sizeof(double));
+  m = (double *) calloc(p->size, sizeof(double));
+  s = (double *) calloc(p->size, sizeof(double));
+  for(i = 0; i < p->size; i = i + 1){
+    x[i] = gsl_vector_get(p->x, i);
+  }
+
+  for(d = 0.0, k = 1; k <= L; k = k + 1){
+    in = gsl_matrix_row(inputs, k);
+    tnn_trainer_class_learn(t, &in.vector, labels[k]);
+    a = ETA*sqrt(1.0 - pow(BETA2, (double)k))/(1.0 - pow(BETA1, (double)k));
+    for(i = 0; i < p->size; i = i + 1){
+      g = gsl_vector_get(p->dx, i) + 2.0*LAMBDA*x[i];
+      if(type == 1){
+	s[i] = s[i] + g*g;
+	x[i] = x[i] - ETA*g/(sqrt(s[i]) + DELTA);
+      } else if(type == 2){
+	s[i] = BETA2*s[i] + (1.0 - BETA2)*g*g;
+	x[i] = x[i] - ETA*g/(sqrt(s[i]) + DELTA);
+      } else {
+	m[i] = BETA1*m[i] + (1.0 - BETA1)*g;
+	s[i] = BETA2*s[i] + (1.0 - BETA2)*g*g;
+	x[i] = x[i] - a*m[i]/(sqrt(s[i]) + DELTA);
+      }
+      d = fmax(d, fabs(x[i] - gsl_vector_get(p->x, i)));
+    }
+  }
+
+  free(x);
+  free(m);
+  free(s);
+  return d;
+}
@@ -0,0 +1,208 @@
+/* Dummy Test 28 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_init_mbsgd
+ * tnn_trainer_class_learn_mbsgd
+ * tnn_trainer_class_train_mbsgd
+ * tnn_trainer_class_titer_mbsgd
+ *
+ * With batches of 1 sample, the minibatch trainer must follow the naive SGD trainer. One step on a batch of
+ * K samples must equal the update by the average of their gradients, taken from a naive trainer with a zero
+ * step size. Then a wide model is trained on the same number of samples by naive SGD and by batches of K (with
+ * a step size SCALE times larger), and the times and test losses printed; the minibatch one should be faster
+ * at a similar loss.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_trainer_class_mbsgd.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define K 16 //Batch size
+#define N 20000 //Samples trained
+#define LAMBDA 0.001
+#define ETA 0.01
+#define SCALE 4 //Step size scale of the minibatch trainer on the wide model
+
+tnn_error init(tnn_trainer_class *t, size_t a, double eta, size_t batch, size_t niter);
+gsl_matrix *data(size_t a, size_t **labels);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t1, t2, t3;
+  tnn_param *p2, *p3;
+  gsl_matrix *inputs, *lset;
+  gsl_vector *x, *g;
+  gsl_vector_view in;
+  struct timespec c;
+  size_t *labels;
+  size_t i, titer;
+  double l1, l2, e;
+
+  inputs = data(A, &labels);
+
+  //Batches of 1
+  lset = gsl_matrix_alloc(B, B);
+  printf("Invalid batch (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_init_mbsgd(&t1, A, B, lset, LAMBDA, ETA, 0, 0.0, 1, N)));
+  gsl_matrix_free(lset);
+  printf("Building the trainers: %s %s\n", TEST_FUNC(init(&t1, A, ETA, 0, 100)), TEST_FUNC(init(&t2, A, ETA, 1, 100)));
+  printf("Training: %s %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)),
+	 TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("Difference with batches of 1: %g\n", diff(&t1, &t2));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //One batch against the average gradient
+  printf("Building the trainers: %s %s\n", TEST_FUNC(init(&t2, A, ETA, K, 1)), TEST_FUNC(init(&t3, A, 0.0, 0, 1)));
+  tnn_machine_get_param(&t2.m, &p2);
+  tnn_machine_get_param(&t3.m, &p3);
+  x = gsl_vector_alloc(p2->size);
+  g = gsl_vector_calloc(p2->size);
+  gsl_vector_memcpy(x, p2->x);
+  for(i = 0; i < K; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    tnn_trainer_class_learn(&t3, &in.vector, labels[i]);
+    gsl_blas_daxpy(1.0/K, p3->dx, g);
+  }
+  gsl_blas_daxpy(2.0*LAMBDA, x, g);
+  gsl_blas_daxpy(-ETA, g, x);
+  printf("One batch step: %s\n", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("Getting the steps: %s, ", TEST_FUNC(tnn_trainer_class_titer_mbsgd(&t2, &titer)));
+  printf("%ld\n", titer);
+  for(l1 = 0.0, i = 0; i < p2->size; i = i + 1){
+    l1 = fmax(l1, fabs(gsl_vector_get(x, i) - gsl_vector_get(p2->x, i)));
+  }
+  printf("Difference to the average gradient step: %g\n", l1);
+  gsl_vector_free(x);
+  gsl_vector_free(g);
+  tnn_trainer_class_destroy(&t2);
+  tnn_trainer_class_destroy(&t3);
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  //Speed on a wide model
+  inputs = data(100*A, &labels);
+  printf("Building the trainers: %s %s\n", TEST_FUNC(init(&t1, 100*A, ETA, 0, N)),
+	 TEST_FUNC(init(&t2, 100*A, ETA*SCALE, K, N/K)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training naive: %s, ", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training minibatch: %s, ", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  tnn_trainer_class_test(&t1, inputs, labels, &l1, &e);
+  tnn_trainer_class_test(&t2, inputs, labels, &l2, &e);
+  printf("Test loss: naive = %g, minibatch = %g\n", l1, l2);
+  printf("Destroying the trainers: %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build a naive (batch 0) or minibatch trainer with a input features and fixed weights
+tnn_error init(tnn_trainer_class *t, size_t a, double eta, size_t batch, size_t niter){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  ret = batch == 0 ? tnn_trainer_class_init_nsgd(t, a, B, lset, eta == 0.0 ? 0.0 : LAMBDA, eta, 0.0, 100, niter)
+    : tnn_trainer_class_init_mbsgd(t, a, B, lset, LAMBDA, eta, batch, 0.0, 1, niter);
+  if(ret != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Generate Q samples of a features
+gsl_matrix *data(size_t a, size_t **labels){
+  gsl_matrix *inputs;
+  size_t i, j;
+
+  inputs = gsl_matrix_alloc(Q, a);
+  *labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    (*labels)[i] = i % B;
+    for(j = 0; j < a; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*a + j))/sqrt((double)a/A) + (j == (*labels)[i] ? 0.5 : 0.0));
+    }
+  }
+  return inputs;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
@@ -0,0 +1,223 @@
+/* Dummy Test 29 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_init_lbfgs
+ * tnn_trainer_class_train_lbfgs
+ * tnn_trainer_class_titer_lbfgs
+ * tnn_trainer_class_objective_lbfgs
+ *
+ * A convex model (linear and bias modules with euclidean loss and L2 regularizer) is trained by L-BFGS with 1
+ * and T threads until the gradient norm drops below EPSILON; both should stop well before NITER iterations at
+ * the same objective, with parameters that differ only by the rounding of the reduction. Then naive SGD is
+ * trained for N steps from the same weights, and the times and objectives printed; L-BFGS should reach a lower
+ * objective.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_trainer_class_lbfgs.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 20 //Input size
+#define B 3 //Number of classes
+#define Q 2000 //Data size
+#define T 4 //Threads
+#define M 8 //History size
+#define N 100000 //Steps of naive SGD
+#define LAMBDA 0.001
+#define ETA 0.01
+#define EPSILON 1e-6
+#define NITER 500
+
+tnn_error init(tnn_trainer_class *t, size_t nthreads);
+tnn_error build(tnn_trainer_class *t);
+gsl_matrix *data(size_t **labels);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t1, t2, t3;
+  gsl_matrix *inputs, *lset;
+  gsl_vector_view in;
+  struct timespec c;
+  size_t *labels;
+  size_t titer;
+  double f;
+
+  inputs = data(&labels);
+
+  //Invalid parameters and learning
+  lset = gsl_matrix_alloc(B, B);
+  printf("Invalid history (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_init_lbfgs(&t1, A, B, lset, LAMBDA, 0, EPSILON, NITER, 1)));
+  printf("Invalid threads (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_init_lbfgs(&t1, A, B, lset, LAMBDA, M, EPSILON, NITER, 0)));
+  gsl_matrix_free(lset);
+  printf("Building the trainers: %s %s %s\n", TEST_FUNC(init(&t1, 1)), TEST_FUNC(init(&t2, T)),
+	 TEST_FUNC(init(&t3, 0)));
+  in = gsl_matrix_row(inputs, 0);
+  printf("Learning one sample (should be NO): %s\n", TEST_FUNC(tnn_trainer_class_learn(&t1, &in.vector, labels[0])));
+
+  //L-BFGS with 1 and T threads
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training L-BFGS with 1 thread: %s, ", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training L-BFGS with %d threads: %s, ", T, TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  printf("Getting the iterations: %s, ", TEST_FUNC(tnn_trainer_class_titer_lbfgs(&t1, &titer)));
+  printf("%ld of %d, ", titer, NITER);
+  printf("%s, ", TEST_FUNC(tnn_trainer_class_titer_lbfgs(&t2, &titer)));
+  printf("%ld of %d\n", titer, NITER);
+  printf("Getting the objective: %s, ", TEST_FUNC(tnn_trainer_class_objective_lbfgs(&t1, &f)));
+  printf("%.12g (recomputed %.12g), ", f, objective(&t1, inputs, labels));
+  printf("%s, ", TEST_FUNC(tnn_trainer_class_objective_lbfgs(&t2, &f)));
+  printf("%.12g\n", f);
+  printf("Difference between 1 and %d threads: %g\n", T, diff(&t1, &t2));
+
+  //Naive SGD
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training naive SGD: %s, ", TEST_FUNC(tnn_trainer_class_train(&t3, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  printf("Objective: L-BFGS = %.12g, naive = %.12g\n", objective(&t1, inputs, labels), objective(&t3, inputs, labels));
+
+  printf("Destroying the trainers: %s %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t2)), TEST_FUNC(tnn_trainer_class_destroy(&t3)));
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build an L-BFGS trainer with nthreads threads, or a naive one if nthreads is 0
+tnn_error init(tnn_trainer_class *t, size_t nthreads){
+  gsl_matrix *lset;
+  tnn_error ret;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  ret = nthreads == 0 ? tnn_trainer_class_init_nsgd(t, A, B, lset, LAMBDA, ETA, 0.0, 100, N)
+    : tnn_trainer_class_init_lbfgs(t, A, B, lset, LAMBDA, M, EPSILON, NITER, nthreads);
+  if(ret != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  return build(t);
+}
+
+//Build the modules, loss and regularizer of a trainer with fixed weights
+tnn_error build(tnn_trainer_class *t){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  tnn_error ret;
+  size_t i;
+
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Generate Q samples
+gsl_matrix *data(size_t **labels){
+  gsl_matrix *inputs;
+  size_t i, j;
+
+  inputs = gsl_matrix_alloc(Q, A);
+  *labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    (*labels)[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == (*labels)[i] ? 0.5 : 0.0));
+    }
+  }
+  return inputs;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_param *p;
+  tnn_state *sin, *sout;
+  gsl_vector_view in;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sin(&t->m, &sin);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < inputs->size1; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    gsl_blas_dcopy(&in.vector, &sin->x);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)inputs->size1 + LAMBDA*r;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
@@ -0,0 +1,283 @@
+/* Dummy Test 30 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_ps_init
+ * tnn_ps_serve
+ * tnn_ps_destroy
+ * tnn_ps_connect
+ * tnn_ps_pull
+ * tnn_ps_push
+ * tnn_ps_done
+ * tnn_ps_train
+ *
+ * With one worker and staleness 0, the server must follow the minibatch SGD trainer up to the rounding of the
+ * regularizer term. Then W worker processes train on their own shards with staleness S, and the numbers of
+ * updates applied and dropped and the objectives before and after are printed; the objective should drop.
+ * Finally, of 3 workers one sends a malformed push and one pulls and exits before the reply is written, both before
+ * the server starts; the server must drop them (without SIGPIPE) and serve the last one, which applies N updates.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_mbsgd.h>
+#include <tnn/tnn_ps.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 10 //Input size
+#define B 3 //Number of classes
+#define Q 1200 //Data size
+#define K 8 //Batch size
+#define W 3 //Workers
+#define S 4 //Staleness
+#define N 300 //Steps of each worker
+#define LAMBDA 0.001
+#define ETA 0.05
+
+tnn_error init(tnn_trainer_class *t, size_t niter);
+gsl_matrix *data(size_t **labels);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+tnn_error serve(tnn_ps *ps, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels, size_t n);
+tnn_error faulty(tnn_ps *ps, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_param *p;
+  tnn_ps ps;
+  gsl_matrix *inputs;
+  size_t *labels;
+  double f;
+
+  inputs = data(&labels);
+
+  //One worker without staleness against the minibatch trainer
+  printf("Building the trainers: %s %s\n", TEST_FUNC(init(&t1, N)), TEST_FUNC(init(&t2, N)));
+  tnn_machine_get_param(&t1.m, &p);
+  printf("Invalid workers (should be NO): %s\n", TEST_FUNC(tnn_ps_init(&ps, p, ETA, 0, 0)));
+  printf("Initializing the server: %s\n", TEST_FUNC(tnn_ps_init(&ps, p, ETA, 0, 1)));
+  printf("Serving 1 worker: %s, ", TEST_FUNC(serve(&ps, &t1, inputs, labels, 1)));
+  printf("version = %ld, pushed = %ld, dropped = %ld\n", ps.version, ps.pushed, ps.dropped);
+  printf("Destroying the server: %s\n", TEST_FUNC(tnn_ps_destroy(&ps)));
+  printf("Training minibatch: %s\n", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("Difference to the minibatch trainer: %g\n", diff(&t1, &t2));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //W workers with staleness S
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t1, N)));
+  f = objective(&t1, inputs, labels);
+  tnn_machine_get_param(&t1.m, &p);
+  printf("Initializing the server: %s\n", TEST_FUNC(tnn_ps_init(&ps, p, ETA, S, W)));
+  printf("Serving %d workers: %s, ", W, TEST_FUNC(serve(&ps, &t1, inputs, labels, W)));
+  printf("version = %ld, pushed = %ld, dropped = %ld\n", ps.version, ps.pushed, ps.dropped);
+  printf("Objective: before = %g, after = %g\n", f, objective(&t1, inputs, labels));
+  printf("Destroying the server: %s\n", TEST_FUNC(tnn_ps_destroy(&ps)));
+  tnn_trainer_class_destroy(&t1);
+
+  //Faulty workers among good ones
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t1, N)));
+  tnn_machine_get_param(&t1.m, &p);
+  printf("Initializing the server: %s\n", TEST_FUNC(tnn_ps_init(&ps, p, ETA, S, 3)));
+  printf("Serving faulty workers: %s, ", TEST_FUNC(faulty(&ps, &t1, inputs, labels)));
+  printf("version = %ld, pushed = %ld, dropped = %ld\n", ps.version, ps.pushed, ps.dropped);
+  printf("Destroying the server: %s\n", TEST_FUNC(tnn_ps_destroy(&ps)));
+  tnn_trainer_class_destroy(&t1);
+
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Fork n workers training on shards of the samples, and serve them
+tnn_error serve(tnn_ps *ps, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels, size_t n){
+  tnn_ps_worker w;
+  gsl_matrix_view shard;
+  tnn_error ret;
+  pid_t *pid;
+  size_t k, beg, end;
+  int status;
+
+  pid = (pid_t *)malloc(n*sizeof(pid_t));
+  for(k = 0; k < n; k = k + 1){
+    pid[k] = fork();
+    if(pid[k] == 0){
+      beg = inputs->size1*k/n;
+      end = inputs->size1*(k + 1)/n;
+      shard = gsl_matrix_submatrix(inputs, beg, 0, end - beg, inputs->size2);
+      if(tnn_ps_connect(ps, k, &w) != TNN_ERROR_SUCCESS
+	 || tnn_ps_train(&w, t, &shard.matrix, labels + beg, K, N) != TNN_ERROR_SUCCESS
+	 || tnn_ps_done(&w) != TNN_ERROR_SUCCESS){
+	_exit(1);
+      }
+      _exit(0);
+    }
+  }
+  ret = tnn_ps_serve(ps);
+  for(k = 0; k < n; k = k + 1){
+    waitpid(pid[k], &status, 0);
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+      ret = TNN_ERROR_PS_IO;
+    }
+  }
+  free(pid);
+  return ret;
+}
+
+//Serve a worker sending a malformed push, a worker closing before its pull is replied, and a good worker
+tnn_error faulty(tnn_ps *ps, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_ps_worker w;
+  tnn_ps_header h;
+  tnn_error ret;
+  pid_t pid[3];
+  size_t k;
+  int status;
+
+  //The faulty workers are done before the server starts
+  for(k = 0; k < 2; k = k + 1){
+    pid[k] = fork();
+    if(pid[k] == 0){
+      if(tnn_ps_connect(ps, k, &w) != TNN_ERROR_SUCCESS){
+	_exit(1);
+      }
+      h.op = k == 0 ? TNN_PS_OP_PUSH : TNN_PS_OP_PULL;
+      h.status = 0;
+      h.version = 0;
+      h.size = k == 0 ? 1 : 0;
+      _exit(write(w.fd, &h, sizeof(tnn_ps_header)) == (ssize_t)sizeof(tnn_ps_header) ? 0 : 1);
+    }
+    waitpid(pid[k], &status, 0);
+  }
+  pid[2] = fork();
+  if(pid[2] == 0){
+    if(tnn_ps_connect(ps, 2, &w) != TNN_ERROR_SUCCESS
+       || tnn_ps_train(&w, t, inputs, labels, K, N) != TNN_ERROR_SUCCESS
+       || tnn_ps_done(&w) != TNN_ERROR_SUCCESS){
+      _exit(1);
+    }
+    _exit(0);
+  }
+  ret = tnn_ps_serve(ps);
+  waitpid(pid[2], &status, 0);
+  if(!WIFEXITED(status) || WEXITSTATUS(status) != 0){
+    ret = TNN_ERROR_PS_IO;
+  }
+  return ret;
+}
+
+//Build a minibatch trainer with fixed weights
+tnn_error init(tnn_trainer_class *t, size_t niter){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_mbsgd(t, A, B, lset, LAMBDA, ETA, K, 0.0, 1, niter)) != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Generate Q samples
+gsl_matrix *data(size_t **labels){
+  gsl_matrix *inputs;
+  size_t i, j;
+
+  inputs = gsl_matrix_alloc(Q, A);
+  *labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    (*labels)[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == (*labels)[i] ? 0.5 : 0.0));
+    }
+  }
+  return inputs;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_param *p;
+  tnn_state *sin, *sout;
+  gsl_vector_view in;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sin(&t->m, &sin);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < inputs->size1; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    gsl_blas_dcopy(&in.vector, &sin->x);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)inputs->size1 + LAMBDA*r;
+}
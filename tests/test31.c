@@ -0,0 +1,189 @@
+/* Dummy Test 31 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_lazy_nsgd
+ * tnn_trainer_class_train_sparse_nsgd
+ *
+ * Without regularization, lazy and eager training of a sparse linear-bias model must give the same parameters.
+ * Then a model with A features (K nonzeros per sample) is trained with the L1 regularizer eagerly and lazily,
+ * and the times, objectives and numbers of zero weights printed; lazy training should be much faster at a
+ * similar objective, with many exact zeros. The L2 regularizer is tested lazily in test 32.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l1.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_sparse.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 20000 //Input features
+#define B 3 //Number of classes
+#define Q 2000 //Data size
+#define K 10 //Nonzeros per sample
+#define N 10000 //Steps
+#define LAMBDA 0.0001
+#define ETA 0.01
+
+tnn_error build(tnn_trainer_class *t, double lambda, int l1, int lazy);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+double objective(tnn_trainer_class *t, tnn_sparse *sp, size_t *labels, double lambda);
+size_t zeros(tnn_trainer_class *t);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_sparse sp;
+  struct timespec c;
+  size_t *labels;
+  size_t i, k;
+
+  //Generate the data
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  tnn_sparse_init(&sp, A, Q*K);
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    tnn_sparse_append(&sp, labels[i], 1.0);
+    for(k = 1; k < K; k = k + 1){
+      tnn_sparse_append(&sp, B + ((i*7919 + k*k*104729) % ((A - B)/K)) + k*((A - B)/K), sin((double)(i*K + k)));
+    }
+    tnn_sparse_end_row(&sp);
+  }
+
+  //Without regularization
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t1, 0.0, 1, 0)), TEST_FUNC(build(&t2, 0.0, 1, 1)));
+  printf("Training eager and lazy: %s %s\n", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t1, &sp, labels)),
+	 TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  printf("Difference without regularization: %g\n", diff(&t1, &t2));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //With the L1 regularizer
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t1, LAMBDA, 1, 0)), TEST_FUNC(build(&t2, LAMBDA, 1, 1)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training eager: %s, ", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t1, &sp, labels)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training lazy: %s, ", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  printf("%g s\n", elapsed(&c));
+  printf("Objective: eager = %g, lazy = %g\n", objective(&t1, &sp, labels, LAMBDA), objective(&t2, &sp, labels, LAMBDA));
+  printf("Zero weights of %d: eager = %ld, lazy = %ld\n", A*B, zeros(&t1), zeros(&t2));
+  printf("Destroying the trainers: %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t1)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+
+  tnn_sparse_destroy(&sp);
+  free(labels);
+
+  return 0;
+}
+
+//Build a sparse linear-bias trainer with the L1 or L2 regularizer, lazy or not
+tnn_error build(tnn_trainer_class *t, double lambda, int l1, int lazy){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, 1, B, lset, lambda, ETA, 0.0, 100, N)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear_sparse(&m->min, A, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = (l1 ? tnn_reg_init_l1(&t->r) : tnn_reg_init_l2(&t->r))) != TNN_ERROR_SUCCESS
+     || (ret = tnn_trainer_class_lazy_nsgd(t, lazy)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/1000.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, tnn_sparse *sp, size_t *labels, double lambda){
+  tnn_param *p;
+  tnn_state *sout;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < sp->size1; i = i + 1){
+    tnn_module_linear_sparse_input(&t->m.min, sp, i);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)sp->size1 + lambda*r;
+}
+
+//Number of zero weights in the sparse module
+size_t zeros(tnn_trainer_class *t){
+  size_t i, n;
+
+  for(n = 0, i = 0; i < t->m.min.w.size; i = i + 1){
+    n = n + (gsl_vector_get(&t->m.min.w.x, i) == 0.0 ? 1 : 0);
+  }
+  return n;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
@@ -0,0 +1,186 @@
+/* Dummy Test 32 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_lazy_nsgd
+ * tnn_trainer_class_train_sparse_nsgd
+ *
+ * A sparse linear-bias model with A features (K nonzeros per sample) is trained with the L2 regularizer eagerly
+ * and lazily, and the times, difference of the parameters and objectives printed; lazy training should be much
+ * faster, with parameters equal up to rounding. Then a strong regularizer makes the global scale fall below
+ * TNN_TRAINER_CLASS_NSGD_LAZY_RESCALE several times, and the difference must still be at the rounding level. A
+ * step size too large for the decay must be refused.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_sparse.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 20000 //Input features
+#define B 3 //Number of classes
+#define Q 2000 //Data size
+#define K 10 //Nonzeros per sample
+#define N 10000 //Steps
+#define LAMBDA 0.0001
+#define STRONG 2.0 //Decay of 0.96 per step
+#define ETA 0.01
+
+tnn_error build(tnn_trainer_class *t, double lambda, double eta, int lazy);
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2);
+double objective(tnn_trainer_class *t, tnn_sparse *sp, size_t *labels, double lambda);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t1, t2;
+  tnn_sparse sp;
+  struct timespec c;
+  size_t *labels;
+  size_t i, k;
+
+  //Generate the data
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  tnn_sparse_init(&sp, A, Q*K);
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    tnn_sparse_append(&sp, labels[i], 1.0);
+    for(k = 1; k < K; k = k + 1){
+      tnn_sparse_append(&sp, B + ((i*7919 + k*k*104729) % ((A - B)/K)) + k*((A - B)/K), sin((double)(i*K + k)));
+    }
+    tnn_sparse_end_row(&sp);
+  }
+
+  //With the L2 regularizer
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t1, LAMBDA, ETA, 0)), TEST_FUNC(build(&t2, LAMBDA, ETA, 1)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training eager: %s, ", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t1, &sp, labels)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training lazy: %s, ", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  printf("%g s\n", elapsed(&c));
+  printf("Difference: %g\n", diff(&t1, &t2));
+  printf("Objective: eager = %.12g, ", objective(&t1, &sp, labels, LAMBDA));
+  printf("lazy = %.12g\n", objective(&t2, &sp, labels, LAMBDA));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //Folding the scale into the weights
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t1, STRONG, ETA, 0)), TEST_FUNC(build(&t2, STRONG, ETA, 1)));
+  printf("Training eager and lazy: %s %s\n", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t1, &sp, labels)),
+	 TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  printf("Difference with rescaling: %g\n", diff(&t1, &t2));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //Step size too large for the decay
+  printf("Building the trainer: %s\n", TEST_FUNC(build(&t2, LAMBDA, 1.0/LAMBDA, 1)));
+  printf("Training lazily with a too large step (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)));
+  printf("Destroying the trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t2)));
+
+  tnn_sparse_destroy(&sp);
+  free(labels);
+
+  return 0;
+}
+
+//Build a sparse linear-bias trainer with the L2 regularizer, lazy or not
+tnn_error build(tnn_trainer_class *t, double lambda, double eta, int lazy){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, 1, B, lset, lambda, eta, 0.0, 100, N)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear_sparse(&m->min, A, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_trainer_class_lazy_nsgd(t, lazy)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/1000.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Largest difference between the parameters of two trainers
+double diff(tnn_trainer_class *t1, tnn_trainer_class *t2){
+  tnn_param *p1, *p2;
+  double d;
+  size_t i;
+
+  tnn_machine_get_param(&t1->m, &p1);
+  tnn_machine_get_param(&t2->m, &p2);
+  for(d = 0.0, i = 0; i < p1->size; i = i + 1){
+    d = fmax(d, fabs(gsl_vector_get(p1->x, i) - gsl_vector_get(p2->x, i)));
+  }
+  return d;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, tnn_sparse *sp, size_t *labels, double lambda){
+  tnn_param *p;
+  tnn_state *sout;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < sp->size1; i = i + 1){
+    tnn_module_linear_sparse_input(&t->m.min, sp, i);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)sp->size1 + lambda*r;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
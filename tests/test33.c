@@ -0,0 +1,218 @@
+/* Dummy Test 33 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_prox_nsgd
+ * tnn_trainer_class_sparsity_nsgd
+ * tnn_trainer_class_learn_nsgd
+ * tnn_trainer_class_train_nsgd
+ * tnn_trainer_class_train_sparse_nsgd
+ *
+ * The proximal step must be refused with the L2 regularizer. A linear-bias model whose inputs have A features, of
+ * which only B carry the label, is trained with the L1 regularizer by subgradient and by proximal steps, and the
+ * times, objectives and numbers of zero parameters printed; the proximal step should reach a similar objective
+ * with many weights of the noise features at exactly 0, while the subgradient leaves none. The zeros reported by
+ * the trainer must match those counted. Then a sparse model is trained eagerly and lazily with proximal steps,
+ * and the zeros reported printed with the counted ones.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l1.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+#include <tnn/tnn_sparse.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 200 //Input features
+#define B 3 //Number of classes
+#define Q 1000 //Data size
+#define F 5000 //Sparse input features
+#define K 10 //Nonzeros per sparse sample
+#define N 50000 //Steps
+#define LAMBDA 0.002
+#define ETA 0.01
+
+tnn_error build(tnn_trainer_class *t, size_t ninput, int l1, int prox, int lazy);
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+size_t zeros(tnn_trainer_class *t);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t1, t2, t3;
+  gsl_matrix *inputs;
+  gsl_vector_view in;
+  tnn_sparse sp;
+  struct timespec c;
+  size_t *labels;
+  size_t i, j, nzero;
+
+  //Generate the data: the first B features carry the label
+  inputs = gsl_matrix_alloc(Q, A);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  tnn_sparse_init(&sp, F, Q*K);
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, (j == labels[i] ? 1.0 : 0.0) + sin((double)(i*A + j))/4.0);
+    }
+    tnn_sparse_append(&sp, labels[i], 1.0);
+    for(j = 1; j < K; j = j + 1){
+      tnn_sparse_append(&sp, B + ((i*7919 + j*j*104729) % ((F - B)/K)) + j*((F - B)/K), sin((double)(i*K + j)));
+    }
+    tnn_sparse_end_row(&sp);
+  }
+
+  //The regularizer must be L1
+  printf("Building with L2: %s\n", TEST_FUNC(build(&t1, A, 0, 1, 0)));
+  printf("Training with L2 (should be NO): %s\n", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  in = gsl_matrix_row(inputs, 0);
+  printf("Learning with L2 (should be NO): %s\n", TEST_FUNC(tnn_trainer_class_learn(&t1, &in.vector, labels[0])));
+  tnn_trainer_class_destroy(&t1);
+
+  //Subgradient against proximal steps
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t1, A, 1, 0, 0)), TEST_FUNC(build(&t2, A, 1, 1, 0)));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training subgradient: %s, ", TEST_FUNC(tnn_trainer_class_train(&t1, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Training proximal: %s, ", TEST_FUNC(tnn_trainer_class_train(&t2, inputs, labels)));
+  printf("%g s\n", elapsed(&c));
+  printf("Objective: subgradient = %g, ", objective(&t1, inputs, labels));
+  printf("proximal = %g\n", objective(&t2, inputs, labels));
+  printf("Zero parameters of %d: subgradient = %ld, ", A*B + B, zeros(&t1));
+  printf("proximal = %ld\n", zeros(&t2));
+  printf("Getting the sparsity: %s, ", TEST_FUNC(tnn_trainer_class_sparsity_nsgd(&t2, &nzero)));
+  printf("%ld\n", nzero);
+  printf("Learning one sample: %s, ", TEST_FUNC(tnn_trainer_class_learn(&t2, &in.vector, labels[0])));
+  tnn_trainer_class_sparsity_nsgd(&t2, &nzero);
+  printf("reported = %ld, ", nzero);
+  printf("counted = %ld\n", zeros(&t2));
+  tnn_trainer_class_destroy(&t1);
+  tnn_trainer_class_destroy(&t2);
+
+  //Sparse inputs, eagerly and lazily
+  printf("Building the trainers: %s %s\n", TEST_FUNC(build(&t2, F, 1, 1, 0)), TEST_FUNC(build(&t3, F, 1, 1, 1)));
+  printf("Training eager and lazy: %s %s\n", TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t2, &sp, labels)),
+	 TEST_FUNC(tnn_trainer_class_train_sparse_nsgd(&t3, &sp, labels)));
+  tnn_trainer_class_sparsity_nsgd(&t2, &nzero);
+  printf("Zero parameters of %d: eager reported = %ld, ", F*B + B, nzero);
+  printf("counted = %ld; ", zeros(&t2));
+  tnn_trainer_class_sparsity_nsgd(&t3, &nzero);
+  printf("lazy reported = %ld, ", nzero);
+  printf("counted = %ld\n", zeros(&t3));
+  printf("Destroying the trainers: %s %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t2)),
+	 TEST_FUNC(tnn_trainer_class_destroy(&t3)));
+
+  tnn_sparse_destroy(&sp);
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build a linear-bias trainer (sparse if ninput is F) with the L1 or L2 regularizer, proximal and lazy or not
+tnn_error build(tnn_trainer_class *t, size_t ninput, int l1, int prox, int lazy){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, ninput == F ? 1 : ninput, B, lset, LAMBDA, ETA, 0.0, 100, N))
+     != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = (ninput == F ? tnn_module_init_linear_sparse(&m->min, F, h, p) : tnn_module_init_linear(&m->min, sin, h, p)))
+     != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = (l1 ? tnn_reg_init_l1(&t->r) : tnn_reg_init_l2(&t->r))) != TNN_ERROR_SUCCESS
+     || (ret = tnn_trainer_class_prox_nsgd(t, prox)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_trainer_class_lazy_nsgd(t, lazy)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/100.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_param *p;
+  tnn_state *sin, *sout;
+  gsl_vector_view in;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sin(&t->m, &sin);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < inputs->size1; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    gsl_blas_dcopy(&in.vector, &sin->x);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)inputs->size1 + LAMBDA*r;
+}
+
+//Number of zero parameters
+size_t zeros(tnn_trainer_class *t){
+  tnn_param *p;
+  size_t i, n;
+
+  tnn_machine_get_param(&t->m, &p);
+  for(n = 0, i = 0; i < p->size; i = i + 1){
+    n = n + (gsl_vector_get(p->x, i) == 0.0 ? 1 : 0);
+  }
+  return n;
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
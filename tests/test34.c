@@ -0,0 +1,189 @@
+/* Dummy Test 34 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_stop_nsgd
+ * tnn_trainer_class_train_nsgd
+ * tnn_trainer_class_titer_nsgd
+ *
+ * After a single step, the norm of the update accumulated by the trainer must equal the norm of the difference of
+ * the parameters. Then a linear-bias model is trained for at most N steps without a stopping criterion, with the
+ * epsilon criterion on the updates, and with the loss criterion delta; the steps executed, the average training
+ * loss of the last steps and the objectives are printed. Both criteria should stop well before N steps at an
+ * objective close to the full training. With a constant step size, the norm of the updates settles at the level
+ * of the gradient noise rather than going to 0, so EPSILON is set above it.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 20 //Input size
+#define B 3 //Number of classes
+#define Q 2000 //Data size
+#define N 400000 //Steps
+#define EITER 2000 //Steps between tests
+#define LAMBDA 0.001
+#define ETA 0.005
+#define EPSILON 0.017 //Above the norm the updates settle at with this step size
+#define DELTA 0.01
+
+tnn_error init(tnn_trainer_class *t, double epsilon, size_t eiter, size_t niter);
+gsl_matrix *data(size_t **labels);
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+int main(){
+  tnn_trainer_class t;
+  tnn_param *p;
+  gsl_matrix *inputs;
+  gsl_vector *x;
+  size_t *labels;
+  size_t titer;
+
+  inputs = data(&labels);
+
+  //The norm of a single update
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t, 0.0, 1, 1)));
+  printf("Invalid delta (should be NO): %s\n", TEST_FUNC(tnn_trainer_class_stop_nsgd(&t, -1.0)));
+  tnn_machine_get_param(&t.m, &p);
+  x = gsl_vector_alloc(p->size);
+  gsl_blas_dcopy(p->x, x);
+  printf("Training one step: %s, ", TEST_FUNC(tnn_trainer_class_train(&t, inputs, labels)));
+  gsl_blas_daxpy(-1.0, p->x, x);
+  printf("accumulated norm = %.12g, ", sqrt(((tnn_trainer_class_nsgd*)t.c)->snorm));
+  printf("difference norm = %.12g\n", gsl_blas_dnrm2(x));
+  gsl_vector_free(x);
+  tnn_trainer_class_destroy(&t);
+
+  //Without a stopping criterion
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t, 0.0, EITER, N)));
+  printf("Training without a criterion: %s, ", TEST_FUNC(tnn_trainer_class_train(&t, inputs, labels)));
+  tnn_trainer_class_titer_nsgd(&t, &titer);
+  printf("steps = %ld, ", titer);
+  printf("loss = %g, ", ((tnn_trainer_class_nsgd*)t.c)->aloss);
+  printf("objective = %.12g\n", objective(&t, inputs, labels));
+  tnn_trainer_class_destroy(&t);
+
+  //The epsilon criterion
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t, EPSILON, EITER, N)));
+  printf("Training with epsilon: %s, ", TEST_FUNC(tnn_trainer_class_train(&t, inputs, labels)));
+  tnn_trainer_class_titer_nsgd(&t, &titer);
+  printf("steps = %ld, ", titer);
+  printf("loss = %g, ", ((tnn_trainer_class_nsgd*)t.c)->aloss);
+  printf("objective = %.12g\n", objective(&t, inputs, labels));
+  tnn_trainer_class_destroy(&t);
+
+  //The loss criterion
+  printf("Building the trainer: %s, ", TEST_FUNC(init(&t, 0.0, EITER, N)));
+  printf("setting delta: %s\n", TEST_FUNC(tnn_trainer_class_stop_nsgd(&t, DELTA)));
+  printf("Training with delta: %s, ", TEST_FUNC(tnn_trainer_class_train(&t, inputs, labels)));
+  tnn_trainer_class_titer_nsgd(&t, &titer);
+  printf("steps = %ld, ", titer);
+  printf("loss = %g, ", ((tnn_trainer_class_nsgd*)t.c)->aloss);
+  printf("objective = %.12g\n", objective(&t, inputs, labels));
+  printf("Destroying the trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t)));
+
+  gsl_matrix_free(inputs);
+  free(labels);
+
+  return 0;
+}
+
+//Build a naive SGD trainer with fixed weights
+tnn_error init(tnn_trainer_class *t, double epsilon, size_t eiter, size_t niter){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h, *lo;
+  gsl_matrix *lset;
+  tnn_error ret;
+  size_t i;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, LAMBDA, ETA, epsilon, eiter, niter)) != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_module_init_bias(&m->mout, h, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  for(i = 0; i < p->size; i = i + 1){
+    gsl_vector_set(p->x, i, cos((double)i)/10.0);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Generate Q samples
+gsl_matrix *data(size_t **labels){
+  gsl_matrix *inputs;
+  size_t i, j;
+
+  inputs = gsl_matrix_alloc(Q, A);
+  *labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    (*labels)[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == (*labels)[i] ? 0.5 : 0.0));
+    }
+  }
+  return inputs;
+}
+
+//Average loss on the true labels plus the regularizer
+double objective(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_param *p;
+  tnn_state *sin, *sout;
+  gsl_vector_view in;
+  double l, r, d;
+  size_t i, j;
+
+  tnn_machine_get_param(&t->m, &p);
+  tnn_machine_get_sin(&t->m, &sin);
+  tnn_machine_get_sout(&t->m, &sout);
+  for(l = 0.0, i = 0; i < inputs->size1; i = i + 1){
+    in = gsl_matrix_row(inputs, i);
+    gsl_blas_dcopy(&in.vector, &sin->x);
+    tnn_machine_fprop(&t->m);
+    for(j = 0; j < B; j = j + 1){
+      d = gsl_vector_get(&sout->x, j) - (j == labels[i] ? 1.0 : 0.0);
+      l = l + d*d;
+    }
+  }
+  tnn_reg_l(&t->r, p->x, &r);
+  return l/(double)inputs->size1 + LAMBDA*r;
+}
@@ -0,0 +1,167 @@
+/* Dummy Test 35 for TNN Utilities
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Tests for the following utilities were performed:
+ * tnn_trainer_class_test
+ * tnn_trainer_class_test_parallel
+ * tnn_loss_clone
+ *
+ * A two-layer linear model (linear, bias, linear, bias) with random weights is tested on Q samples serially and
+ * with 1, 2 and T threads, and the times, losses and errors printed; the losses and errors must be identical to
+ * the serial test for every number of threads. Invalid threads and inputs must be refused, as must a loss without a
+ * clone method (the shares built until then are freed), and the trainer must still be usable after the parallel
+ * tests.
+ *
+ * Results:
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_loss_euclidean.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_reg_l2.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_nsgd.h>
+
+#define TEST_FUNC(func) (func==TNN_ERROR_SUCCESS?"YES":"NO")
+
+#define A 100 //Input size
+#define H 200 //Hidden size
+#define B 10 //Number of classes
+#define Q 20000 //Data size
+#define T 4 //Threads
+
+tnn_error init(tnn_trainer_class *t);
+double elapsed(struct timespec *c);
+
+int main(){
+  tnn_trainer_class t;
+  gsl_matrix *inputs, *wrong;
+  struct timespec c;
+  TNN_LOSS_FUNC_CLONE clone;
+  size_t *labels;
+  size_t threads[3] = {1, 2, T};
+  size_t i, j, k;
+  double l0, e0, l, e;
+
+  //Generate the data
+  inputs = gsl_matrix_alloc(Q, A);
+  wrong = gsl_matrix_alloc(Q, A + 1);
+  labels = (size_t *)malloc(Q*sizeof(size_t));
+  for(i = 0; i < Q; i = i + 1){
+    labels[i] = i % B;
+    for(j = 0; j < A; j = j + 1){
+      gsl_matrix_set(inputs, i, j, sin((double)(i*A + j)) + (j == labels[i] ? 1.0 : 0.0));
+    }
+  }
+
+  printf("Building the trainer: %s\n", TEST_FUNC(init(&t)));
+  printf("Invalid threads (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_test_parallel(&t, inputs, labels, 0, &l, &e)));
+  printf("Invalid inputs (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_test_parallel(&t, wrong, labels, T, &l, &e)));
+  clone = t.l.clone;
+  t.l.clone = NULL;
+  printf("Loss without a clone method (should be NO): %s\n",
+	 TEST_FUNC(tnn_trainer_class_test_parallel(&t, inputs, labels, T, &l, &e)));
+  t.l.clone = clone;
+
+  //Serial against parallel
+  clock_gettime(CLOCK_MONOTONIC, &c);
+  printf("Testing serially: %s, ", TEST_FUNC(tnn_trainer_class_test(&t, inputs, labels, &l0, &e0)));
+  printf("%g s, ", elapsed(&c));
+  printf("loss = %.17g, error = %g\n", l0, e0);
+  for(k = 0; k < 3; k = k + 1){
+    clock_gettime(CLOCK_MONOTONIC, &c);
+    printf("Testing with %ld threads: %s, ", threads[k],
+	   TEST_FUNC(tnn_trainer_class_test_parallel(&t, inputs, labels, threads[k], &l, &e)));
+    printf("%g s, ", elapsed(&c));
+    printf("identical: %s\n", l == l0 && e == e0 ? "YES" : "NO");
+  }
+
+  //The trainer after the parallel tests
+  printf("Training: %s\n", TEST_FUNC(tnn_trainer_class_train(&t, inputs, labels)));
+  printf("Testing serially: %s, ", TEST_FUNC(tnn_trainer_class_test(&t, inputs, labels, &l0, &e0)));
+  printf("with %d threads: %s, ", T, TEST_FUNC(tnn_trainer_class_test_parallel(&t, inputs, labels, T, &l, &e)));
+  printf("identical: %s, error = %g\n", l == l0 && e == e0 ? "YES" : "NO", e);
+  printf("Destroying the trainer: %s\n", TEST_FUNC(tnn_trainer_class_destroy(&t)));
+
+  gsl_matrix_free(inputs);
+  gsl_matrix_free(wrong);
+  free(labels);
+
+  return 0;
+}
+
+//Build a two-layer trainer with random weights
+tnn_error init(tnn_trainer_class *t){
+  tnn_machine *m;
+  tnn_param *p;
+  tnn_state *sin, *sout, *h1, *h2, *h3, *lo;
+  tnn_module *mod;
+  gsl_matrix *lset;
+  tnn_error ret;
+
+  lset = gsl_matrix_alloc(B, B);
+  gsl_matrix_set_identity(lset);
+  if((ret = tnn_trainer_class_init_nsgd(t, A, B, lset, 0.0001, 0.01, 0.0, 100, Q)) != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(lset);
+    return ret;
+  }
+  tnn_trainer_class_get_machine(t, &m);
+  tnn_machine_get_param(m, &p);
+  tnn_machine_get_sin(m, &sin);
+  tnn_machine_get_sout(m, &sout);
+  h1 = malloc(sizeof(tnn_state));
+  h2 = malloc(sizeof(tnn_state));
+  h3 = malloc(sizeof(tnn_state));
+  lo = malloc(sizeof(tnn_state));
+  tnn_state_init(h1, H);
+  tnn_state_init(h2, H);
+  tnn_state_init(h3, B);
+  tnn_state_init(lo, 1);
+  tnn_machine_state_alloc(m, h1);
+  tnn_machine_state_alloc(m, h2);
+  tnn_machine_state_alloc(m, h3);
+  tnn_machine_state_alloc(m, lo);
+  if((ret = tnn_module_init_linear(&m->min, sin, h1, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_bias(mod, h1, h2, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  mod = malloc(sizeof(tnn_module));
+  if((ret = tnn_module_init_linear(mod, h2, h3, p)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  tnn_machine_module_append(m, mod);
+  if((ret = tnn_module_init_bias(&m->mout, h3, sout, p)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_loss_init_euclidean(&t->l, sout, t->label, lo)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_reg_init_l2(&t->r)) != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+  return tnn_machine_randomize(m, 0.1);
+}
+
+//Seconds since c
+double elapsed(struct timespec *c){
+  struct timespec n;
+
+  clock_gettime(CLOCK_MONOTONIC, &n);
+  return (double)(n.tv_sec - c->tv_sec) + (double)(n.tv_nsec - c->tv_nsec)/1e9;
+}
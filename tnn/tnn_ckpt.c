@@ -0,0 +1,255 @@
+/* Thunder Neural Networks Trainer Checkpoint Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_ckpt_init(tnn_ckpt *ck, const char *file, tnn_trainer_class_type type, size_t psize, size_t ssize);
+ * tnn_error tnn_ckpt_snapshot(tnn_ckpt *ck, gsl_vector *p, gsl_vector *s, size_t titer);
+ * tnn_error tnn_ckpt_wait(tnn_ckpt *ck);
+ * tnn_error tnn_ckpt_destroy(tnn_ckpt *ck);
+ * tnn_error tnn_ckpt_load(const char *file, tnn_trainer_class_type type, gsl_vector *p, gsl_vector *s,
+ *                         size_t *titer);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_ckpt.h>
+
+//Write the staging buffer to the temporary file and rename it over the checkpoint
+static tnn_error tnn_ckpt_write(tnn_ckpt *ck){
+  tnn_ckpt_header h;
+  size_t n;
+  FILE *fp;
+
+  memcpy(h.magic, TNN_CKPT_FILE_MAGIC, 8);
+  h.version = TNN_CKPT_FILE_VERSION;
+  h.endian = TNN_CKPT_FILE_ENDIAN;
+  h.dsize = sizeof(double);
+  h.type = (uint64_t)ck->type;
+  h.psize = ck->psize;
+  h.ssize = ck->ssize;
+  h.titer = ck->titer;
+
+  fp = fopen(ck->temp, "wb");
+  if(fp == NULL){
+    return TNN_ERROR_FILE;
+  }
+  n = ck->psize + ck->ssize;
+  if(fwrite(&h, sizeof(tnn_ckpt_header), 1, fp) != 1
+     || fwrite(ck->buf, sizeof(double), n, fp) != n
+     || fflush(fp) != 0 || fsync(fileno(fp)) != 0){
+    fclose(fp);
+    remove(ck->temp);
+    return TNN_ERROR_FILE;
+  }
+  if(fclose(fp) != 0 || rename(ck->temp, ck->file) != 0){
+    remove(ck->temp);
+    return TNN_ERROR_FILE;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//The writer thread: write each pending snapshot until stopped
+static void *tnn_ckpt_run(void *arg){
+  tnn_ckpt *ck;
+  tnn_error ret;
+
+  ck = (tnn_ckpt *) arg;
+  pthread_mutex_lock(&ck->mutex);
+  for(;;){
+    while(ck->pending == 0 && ck->stop == 0){
+      pthread_cond_wait(&ck->cond, &ck->mutex);
+    }
+    if(ck->pending == 0){
+      break;
+    }
+
+    //The buffer is not touched by snapshots while pending
+    pthread_mutex_unlock(&ck->mutex);
+    ret = tnn_ckpt_write(ck);
+    pthread_mutex_lock(&ck->mutex);
+
+    ck->err = ret;
+    ck->pending = 0;
+    pthread_cond_broadcast(&ck->cond);
+  }
+  pthread_mutex_unlock(&ck->mutex);
+
+  return NULL;
+}
+
+//Initialize a checkpoint writer for a trainer of the type with psize parameters and ssize state values
+tnn_error tnn_ckpt_init(tnn_ckpt *ck, const char *file, tnn_trainer_class_type type, size_t psize, size_t ssize){
+  ck->file = (char *) malloc(strlen(file) + 1);
+  ck->temp = (char *) malloc(strlen(file) + 5);
+  ck->buf = (double *) malloc((psize + ssize)*sizeof(double));
+  if(ck->file == NULL || ck->temp == NULL || ck->buf == NULL){
+    free(ck->file);
+    free(ck->temp);
+    free(ck->buf);
+    return TNN_ERROR_ALLOC;
+  }
+  strcpy(ck->file, file);
+  strcpy(ck->temp, file);
+  strcat(ck->temp, ".tmp");
+
+  ck->type = type;
+  ck->psize = psize;
+  ck->ssize = ssize;
+  ck->titer = 0;
+  ck->pending = 0;
+  ck->stop = 0;
+  ck->err = TNN_ERROR_SUCCESS;
+
+  //Start the thread
+  pthread_mutex_init(&ck->mutex, NULL);
+  pthread_cond_init(&ck->cond, NULL);
+  if(pthread_create(&ck->thread, NULL, tnn_ckpt_run, ck) != 0){
+    pthread_cond_destroy(&ck->cond);
+    pthread_mutex_destroy(&ck->mutex);
+    free(ck->file);
+    free(ck->temp);
+    free(ck->buf);
+    return TNN_ERROR_CKPT_THREAD;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Copy the parameters p, the state s (NULL if ssize is 0) and titer, and write them in the background
+tnn_error tnn_ckpt_snapshot(tnn_ckpt *ck, gsl_vector *p, gsl_vector *s, size_t titer){
+  gsl_vector_view bv;
+  tnn_error ret;
+
+  //Check the sizes
+  if(p->size != ck->psize || (s == NULL ? 0 : s->size) != ck->ssize){
+    return TNN_ERROR_PARAM_INCOMP;
+  }
+
+  //Wait for the buffer
+  TNN_MACRO_ERRORTEST(tnn_ckpt_wait(ck), ret);
+
+  //Copy into the staging buffer
+  bv = gsl_vector_view_array(ck->buf, ck->psize);
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(p, &bv.vector));
+  if(s != NULL){
+    bv = gsl_vector_view_array(ck->buf + ck->psize, ck->ssize);
+    TNN_MACRO_GSLTEST(gsl_blas_dcopy(s, &bv.vector));
+  }
+
+  //Hand it to the thread
+  pthread_mutex_lock(&ck->mutex);
+  ck->titer = titer;
+  ck->pending = 1;
+  pthread_cond_broadcast(&ck->cond);
+  pthread_mutex_unlock(&ck->mutex);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Wait for the pending write and return its error
+tnn_error tnn_ckpt_wait(tnn_ckpt *ck){
+  tnn_error ret;
+
+  pthread_mutex_lock(&ck->mutex);
+  while(ck->pending != 0){
+    pthread_cond_wait(&ck->cond, &ck->mutex);
+  }
+  ret = ck->err;
+  ck->err = TNN_ERROR_SUCCESS;
+  pthread_mutex_unlock(&ck->mutex);
+
+  return ret;
+}
+
+//Finish the pending write and destroy the checkpoint writer
+tnn_error tnn_ckpt_destroy(tnn_ckpt *ck){
+  tnn_error ret;
+
+  ret = tnn_ckpt_wait(ck);
+
+  pthread_mutex_lock(&ck->mutex);
+  ck->stop = 1;
+  pthread_cond_broadcast(&ck->cond);
+  pthread_mutex_unlock(&ck->mutex);
+  pthread_join(ck->thread, NULL);
+
+  pthread_cond_destroy(&ck->cond);
+  pthread_mutex_destroy(&ck->mutex);
+  free(ck->file);
+  free(ck->temp);
+  free(ck->buf);
+
+  return ret;
+}
+
+//Load the checkpoint of a trainer of the type into p, s (NULL if none) and titer
+tnn_error tnn_ckpt_load(const char *file, tnn_trainer_class_type type, gsl_vector *p, gsl_vector *s,
+                        size_t *titer){
+  tnn_ckpt_header h;
+  gsl_vector *v[2];
+  size_t i, j;
+  double x;
+  FILE *fp;
+  tnn_error ret;
+
+  fp = fopen(file, "rb");
+  if(fp == NULL){
+    return TNN_ERROR_FILE;
+  }
+
+  //Check the header
+  ret = TNN_ERROR_SUCCESS;
+  if(fread(&h, sizeof(tnn_ckpt_header), 1, fp) != 1){
+    ret = TNN_ERROR_FILE;
+  } else if(memcmp(h.magic, TNN_CKPT_FILE_MAGIC, 8) != 0 || h.version != TNN_CKPT_FILE_VERSION
+            || h.endian != TNN_CKPT_FILE_ENDIAN || h.dsize != sizeof(double)){
+    ret = TNN_ERROR_FILE_FORMAT;
+  } else if(h.type != (uint64_t)type){
+    ret = TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  } else if(h.psize != p->size || h.ssize != (s == NULL ? 0 : s->size)){
+    ret = TNN_ERROR_PARAM_INCOMP;
+  }
+
+  //Read the values, in place when the vectors are contiguous
+  v[0] = p;
+  v[1] = s;
+  for(i = 0; i < 2 && ret == TNN_ERROR_SUCCESS; i = i + 1){
+    if(v[i] == NULL){
+      continue;
+    }
+    if(v[i]->stride == 1){
+      if(fread(v[i]->data, sizeof(double), v[i]->size, fp) != v[i]->size){
+	ret = TNN_ERROR_FILE;
+      }
+      continue;
+    }
+    for(j = 0; j < v[i]->size && ret == TNN_ERROR_SUCCESS; j = j + 1){
+      if(fread(&x, sizeof(double), 1, fp) != 1){
+	ret = TNN_ERROR_FILE;
+      } else {
+	gsl_vector_set(v[i], j, x);
+      }
+    }
+  }
+  fclose(fp);
+
+  if(ret == TNN_ERROR_SUCCESS){
+    *titer = h.titer;
+  }
+
+  return ret;
+}
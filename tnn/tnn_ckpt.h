@@ -0,0 +1,104 @@
+/* Thunder Neural Networks Trainer Checkpoint Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A checkpoint writer keeps a staging buffer of the size of the trainer state and a thread writing it to
+ * disk. A snapshot only copies the parameters, the optimizer state and the step counter into the buffer, so
+ * training stalls for a memcpy and not for the disk. The file is written under a temporary name and renamed
+ * over the previous checkpoint, so a crash during a write leaves the last complete checkpoint in place.
+ *
+ * There is only one staging buffer: a snapshot taken while the previous one is still being written waits
+ * for it to finish.
+ *
+ * This header defines the following structures:
+ * tnn_ckpt(char *file, char *temp, tnn_trainer_class_type type, size_t psize, size_t ssize, double *buf,
+ *          size_t titer, int pending, int stop, tnn_error err,
+ *          pthread_t thread, pthread_mutex_t mutex, pthread_cond_t cond)
+ * tnn_ckpt_header(char magic[8], uint32_t version, uint32_t endian, uint64_t dsize, uint64_t type,
+ *                 uint64_t psize, uint64_t ssize, uint64_t titer)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_ckpt_init(tnn_ckpt *ck, const char *file, tnn_trainer_class_type type, size_t psize, size_t ssize);
+ * tnn_error tnn_ckpt_snapshot(tnn_ckpt *ck, gsl_vector *p, gsl_vector *s, size_t titer);
+ * tnn_error tnn_ckpt_wait(tnn_ckpt *ck);
+ * tnn_error tnn_ckpt_destroy(tnn_ckpt *ck);
+ * tnn_error tnn_ckpt_load(const char *file, tnn_trainer_class_type type, gsl_vector *p, gsl_vector *s,
+ *                         size_t *titer);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_trainer_class.h>
+
+#ifndef TNN_CKPT_H
+#define TNN_CKPT_H
+
+//Checkpoint file format: header, parameters, then optimizer state
+#define TNN_CKPT_FILE_MAGIC "TNNCKPT1"
+#define TNN_CKPT_FILE_VERSION 1
+#define TNN_CKPT_FILE_ENDIAN 0x01020304
+
+//The checkpoint writer type
+typedef struct __STRUCT_tnn_ckpt{
+  //Checkpoint file and temporary file written before renaming
+  char *file;
+  char *temp;
+  //Trainer type
+  tnn_trainer_class_type type;
+  //Number of parameters and of optimizer state values
+  size_t psize;
+  size_t ssize;
+  //Staging buffer of psize + ssize values, and its step counter
+  double *buf;
+  size_t titer;
+  //Whether the buffer is waiting to be written and whether the thread should exit
+  int pending;
+  int stop;
+  //Error of the last write
+  tnn_error err;
+  //The thread and its synchronization
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+} tnn_ckpt;
+
+//Checkpoint file header
+typedef struct __STRUCT_tnn_ckpt_header{
+  //Magic string TNN_CKPT_FILE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_CKPT_FILE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Size of a value in bytes
+  uint64_t dsize;
+  //Trainer type
+  uint64_t type;
+  //Number of parameters and of optimizer state values
+  uint64_t psize;
+  uint64_t ssize;
+  //Steps executed
+  uint64_t titer;
+} tnn_ckpt_header;
+
+//Initialize a checkpoint writer for a trainer of the type with psize parameters and ssize state values
+tnn_error tnn_ckpt_init(tnn_ckpt *ck, const char *file, tnn_trainer_class_type type, size_t psize, size_t ssize);
+
+//Copy the parameters p, the state s (NULL if ssize is 0) and titer, and write them in the background
+//Returns the error of the previous write, if any.
+tnn_error tnn_ckpt_snapshot(tnn_ckpt *ck, gsl_vector *p, gsl_vector *s, size_t titer);
+
+//Wait for the pending write and return its error
+tnn_error tnn_ckpt_wait(tnn_ckpt *ck);
+
+//Finish the pending write and destroy the checkpoint writer
+tnn_error tnn_ckpt_destroy(tnn_ckpt *ck);
+
+//Load the checkpoint of a trainer of the type into p, s (NULL if none) and titer
+tnn_error tnn_ckpt_load(const char *file, tnn_trainer_class_type type, gsl_vector *p, gsl_vector *s,
+                        size_t *titer);
+
+#endif //TNN_CKPT_H
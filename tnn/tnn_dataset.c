@@ -0,0 +1,214 @@
+/* Thunder Neural Networks Dataset Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_dataset_write(const char *file, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_dataset_open(tnn_dataset *ds, const char *file);
+ * tnn_error tnn_dataset_advise(tnn_dataset *ds, size_t row);
+ * tnn_error tnn_dataset_read(tnn_dataset *ds, size_t row, size_t n, double *x, size_t *labels);
+ * tnn_error tnn_dataset_get_inputs(tnn_dataset *ds, gsl_matrix **inputs);
+ * tnn_error tnn_dataset_get_labels(tnn_dataset *ds, size_t **labels);
+ * tnn_error tnn_dataset_close(tnn_dataset *ds);
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_dataset.h>
+
+//Give advice on the pages of a range of rows
+static void tnn_dataset_madvise(tnn_dataset *ds, size_t row, size_t n, int advice){
+  size_t page, start, end;
+
+  if(row >= ds->inputs.size1){
+    return;
+  }
+  if(row + n > ds->inputs.size1){
+    n = ds->inputs.size1 - row;
+  }
+  page = (size_t)sysconf(_SC_PAGESIZE);
+  start = (size_t)((char *)ds->inputs.data - (char *)ds->map) + row*ds->inputs.size2*sizeof(double);
+  end = start + n*ds->inputs.size2*sizeof(double);
+  start = start/page*page;
+  madvise((char *)ds->map + start, end - start, advice);
+}
+
+tnn_error tnn_dataset_write(const char *file, gsl_matrix *inputs, size_t *labels){
+  tnn_dataset_header h;
+  gsl_vector_view row;
+  char pad[TNN_DATASET_FILE_ALIGN];
+  uint64_t lb;
+  size_t i;
+  FILE *fp;
+  tnn_error ret;
+
+  //Build the header
+  memcpy(h.magic, TNN_DATASET_FILE_MAGIC, 8);
+  h.version = TNN_DATASET_FILE_VERSION;
+  h.endian = TNN_DATASET_FILE_ENDIAN;
+  h.dsize = sizeof(double);
+  h.size1 = inputs->size1;
+  h.size2 = inputs->size2;
+  h.offset = (sizeof(tnn_dataset_header) + TNN_DATASET_FILE_ALIGN - 1)/TNN_DATASET_FILE_ALIGN*TNN_DATASET_FILE_ALIGN;
+  h.loffset = h.offset + h.size1*h.size2*sizeof(double);
+  memset(pad, 0, TNN_DATASET_FILE_ALIGN);
+
+  //Write the file row by row
+  if((fp = fopen(file, "wb")) == NULL){
+    return TNN_ERROR_FILE;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  if(fwrite(&h, sizeof(tnn_dataset_header), 1, fp) != 1
+     || fwrite(pad, 1, h.offset - sizeof(tnn_dataset_header), fp) != h.offset - sizeof(tnn_dataset_header)){
+    ret = TNN_ERROR_FILE;
+  }
+  for(i = 0; i < inputs->size1 && ret == TNN_ERROR_SUCCESS; i = i + 1){
+    row = gsl_matrix_row(inputs, i);
+    if(fwrite(row.vector.data, sizeof(double), inputs->size2, fp) != inputs->size2){
+      ret = TNN_ERROR_FILE;
+    }
+  }
+  for(i = 0; i < inputs->size1 && ret == TNN_ERROR_SUCCESS; i = i + 1){
+    lb = (uint64_t)labels[i];
+    if(fwrite(&lb, sizeof(uint64_t), 1, fp) != 1){
+      ret = TNN_ERROR_FILE;
+    }
+  }
+  if(fclose(fp) != 0){
+    ret = TNN_ERROR_FILE;
+  }
+
+  return ret;
+}
+
+tnn_error tnn_dataset_open(tnn_dataset *ds, const char *file){
+  tnn_dataset_header *h;
+  gsl_matrix_view mv;
+  struct stat st;
+  void *map;
+  int fd;
+
+  //Labels are mapped in place
+  if(sizeof(size_t) != sizeof(uint64_t)){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  //Map the file
+  if((fd = open(file, O_RDONLY)) < 0){
+    return TNN_ERROR_FILE;
+  }
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(tnn_dataset_header)){
+    close(fd);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED){
+    return TNN_ERROR_FILE;
+  }
+
+  //Check the header
+  h = (tnn_dataset_header *)map;
+  if(memcmp(h->magic, TNN_DATASET_FILE_MAGIC, 8) != 0 || h->version != TNN_DATASET_FILE_VERSION
+     || h->endian != TNN_DATASET_FILE_ENDIAN || h->dsize != sizeof(double) || h->size2 == 0
+     || h->offset % TNN_DATASET_FILE_ALIGN != 0 || h->offset < sizeof(tnn_dataset_header)
+     || h->loffset % sizeof(uint64_t) != 0 || h->loffset < h->offset + h->size1*h->size2*sizeof(double)
+     || h->loffset + h->size1*sizeof(uint64_t) > (uint64_t)st.st_size){
+    munmap(map, (size_t)st.st_size);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  //Point the inputs and labels at the mapping
+  ds->map = map;
+  ds->mapsize = (size_t)st.st_size;
+  ds->labels = (size_t *)((char *)map + h->loffset);
+  if(h->size1 > 0){
+    mv = gsl_matrix_view_array((double *)((char *)map + h->offset), h->size1, h->size2);
+    ds->inputs = mv.matrix;
+  } else {
+    ds->inputs.size1 = 0;
+    ds->inputs.size2 = h->size2;
+    ds->inputs.tda = h->size2;
+    ds->inputs.data = (double *)((char *)map + h->offset);
+    ds->inputs.block = NULL;
+    ds->inputs.owner = 0;
+  }
+
+  //Readahead in windows
+  ds->window = TNN_DATASET_WINDOW/(h->size2*sizeof(double));
+  if(ds->window == 0){
+    ds->window = 1;
+  }
+  ds->cur = (size_t)-1;
+  tnn_dataset_madvise(ds, 0, ds->inputs.size1, MADV_SEQUENTIAL);
+  tnn_dataset_madvise(ds, 0, ds->window, MADV_WILLNEED);
+  return tnn_dataset_advise(ds, 0);
+}
+
+tnn_error tnn_dataset_advise(tnn_dataset *ds, size_t row){
+  size_t w, next;
+
+  //Nothing to do inside the current window
+  w = row/ds->window;
+  if(w == ds->cur || row >= ds->inputs.size1){
+    return TNN_ERROR_SUCCESS;
+  }
+  ds->cur = w;
+
+  //Prefetch the next window (wrapping around for epochs) and drop the previous one
+  next = (w + 1)*ds->window < ds->inputs.size1 ? w + 1 : 0;
+  if(next != w){
+    tnn_dataset_madvise(ds, next*ds->window, ds->window, MADV_WILLNEED);
+  }
+  if(w > 0 && w - 1 != next){
+    tnn_dataset_madvise(ds, (w - 1)*ds->window, ds->window, MADV_DONTNEED);
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_dataset_read(tnn_dataset *ds, size_t row, size_t n, double *x, size_t *labels){
+  if(row + n > ds->inputs.size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  if(n == 0){
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Rows are contiguous in the mapping
+  tnn_dataset_madvise(ds, row, n, MADV_WILLNEED);
+  memcpy(x, ds->inputs.data + row*ds->inputs.size2, n*ds->inputs.size2*sizeof(double));
+  memcpy(labels, ds->labels + row, n*sizeof(size_t));
+  tnn_dataset_madvise(ds, row, n, MADV_DONTNEED);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_dataset_get_inputs(tnn_dataset *ds, gsl_matrix **inputs){
+  *inputs = &ds->inputs;
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_dataset_get_labels(tnn_dataset *ds, size_t **labels){
+  *labels = ds->labels;
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_dataset_close(tnn_dataset *ds){
+  if(ds->map != NULL){
+    munmap(ds->map, ds->mapsize);
+  }
+  ds->map = NULL;
+  ds->mapsize = 0;
+  ds->labels = NULL;
+  return TNN_ERROR_SUCCESS;
+}
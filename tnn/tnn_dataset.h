@@ -0,0 +1,98 @@
+/* Thunder Neural Networks Dataset Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A dataset is a binary file of fixed-width rows and labels, mapped into memory read-only. The rows are
+ * exposed as a gsl_matrix view, so every function taking inputs and labels works on it unchanged, and the
+ * kernel pages the file in and out as needed. Sequential readers call tnn_dataset_advise with their row
+ * cursor to prefetch the next window of rows and drop the one behind.
+ *
+ * This header defines the following structures:
+ * tnn_dataset(gsl_matrix inputs, size_t *labels, size_t window, size_t cur, void *map, size_t mapsize)
+ * tnn_dataset_header(char magic[8], uint32_t version, uint32_t endian, uint64_t dsize, uint64_t size1,
+ *                    uint64_t size2, uint64_t offset, uint64_t loffset)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_dataset_write(const char *file, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_dataset_open(tnn_dataset *ds, const char *file);
+ * tnn_error tnn_dataset_advise(tnn_dataset *ds, size_t row);
+ * tnn_error tnn_dataset_read(tnn_dataset *ds, size_t row, size_t n, double *x, size_t *labels);
+ * tnn_error tnn_dataset_get_inputs(tnn_dataset *ds, gsl_matrix **inputs);
+ * tnn_error tnn_dataset_get_labels(tnn_dataset *ds, size_t **labels);
+ * tnn_error tnn_dataset_close(tnn_dataset *ds);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+
+#ifndef TNN_DATASET_H
+#define TNN_DATASET_H
+
+//Dataset file format: header, zero padding, rows of doubles, then one 64-bit label per row
+#define TNN_DATASET_FILE_MAGIC "TNNDATA1"
+#define TNN_DATASET_FILE_VERSION 1
+#define TNN_DATASET_FILE_ENDIAN 0x01020304
+#define TNN_DATASET_FILE_ALIGN 64
+
+//Bytes of rows prefetched at a time
+#define TNN_DATASET_WINDOW 16777216
+
+//The dataset type
+typedef struct __STRUCT_tnn_dataset{
+  //Rows of inputs (a view of the mapping)
+  gsl_matrix inputs;
+  //Labels (in the mapping)
+  size_t *labels;
+  //Number of rows in a readahead window
+  size_t window;
+  //Current window
+  size_t cur;
+  //The mapping
+  void *map;
+  size_t mapsize;
+} tnn_dataset;
+
+//Dataset file header
+typedef struct __STRUCT_tnn_dataset_header{
+  //Magic string TNN_DATASET_FILE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_DATASET_FILE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Size of a value in bytes
+  uint64_t dsize;
+  //Number of rows and columns
+  uint64_t size1;
+  uint64_t size2;
+  //Byte offsets of the rows (a multiple of TNN_DATASET_FILE_ALIGN) and of the labels
+  uint64_t offset;
+  uint64_t loffset;
+} tnn_dataset_header;
+
+//Write inputs and labels to a dataset file
+tnn_error tnn_dataset_write(const char *file, gsl_matrix *inputs, size_t *labels);
+
+//Open a dataset file
+tnn_error tnn_dataset_open(tnn_dataset *ds, const char *file);
+
+//Tell the dataset that rows are read in sequence from row on
+//When row enters a new window, the next window is prefetched and the previous one is dropped from memory.
+tnn_error tnn_dataset_advise(tnn_dataset *ds, size_t row);
+
+//Copy n rows from row on into x (n*size2 values) and labels, and drop them from memory afterwards
+//The rows are read as one sequential range, for readers that visit blocks of rows in any order.
+tnn_error tnn_dataset_read(tnn_dataset *ds, size_t row, size_t n, double *x, size_t *labels);
+
+//Get the inputs of the dataset
+tnn_error tnn_dataset_get_inputs(tnn_dataset *ds, gsl_matrix **inputs);
+
+//Get the labels of the dataset
+tnn_error tnn_dataset_get_labels(tnn_dataset *ds, size_t **labels);
+
+//Close the dataset
+tnn_error tnn_dataset_close(tnn_dataset *ds);
+
+#endif //TNN_DATASET_H
@@ -14,9 +14,12 @@ typedef enum __ENUM_tnn_error{
   TNN_ERROR_FAILURE, //General failure
   TNN_ERROR_ALLOC, //Memory allocation error
   TNN_ERROR_GSL, //GSL routine error
+  TNN_ERROR_FILE, //File open, read, write or map error
+  TNN_ERROR_FILE_FORMAT, //Invalid file format or version
 
   TNN_ERROR_PARAM_VALID, //Valid state to add to param (wrong to do so)
   TNN_ERROR_PARAM_NEXIST, //State does not exist in param (for union and sub operation)
+  TNN_ERROR_PARAM_INCOMP, //Parameter file incompatible with the parameter
 
   TNN_ERROR_STATE_INVALID, //Invalid state
   TNN_ERROR_STATE_INCOMP, //Incompatible state
@@ -30,10 +33,13 @@ typedef enum __ENUM_tnn_error{
   TNN_ERROR_LOSS_FUNCNDEF, //Loss function undefined
 
   TNN_ERROR_MACHINE_NOMOD, //No modules in the machine
+  TNN_ERROR_MACHINE_NCHAIN, //Modules do not form a chain from sin to sout
+  TNN_ERROR_MACHINE_CHECKPOINT, //Machine is already checkpointed
 
   TNN_ERROR_TRAINER_CLASS_FUNCNDEF, //Trainer - classification function undefined
   TNN_ERROR_TRAINER_CLASS_MISTYPE, //Trainer - classification type mismatch
   TNN_ERROR_TRAINER_CLASS_NVALIDP, //Trainer - classification invalid input parameters
+  TNN_ERROR_TRAINER_CLASS_THREAD, //Trainer - classification threads could not be started
   
   TNN_ERROR_REG_FUNCNDEF, //Regularizer function undefined
   TNN_ERROR_REG_MISTYPE, //Regularizer type mismatch
@@ -42,6 +48,21 @@ typedef enum __ENUM_tnn_error{
   TNN_ERROR_PSTABLE_EXIST, //State already exist in the table
   TNN_ERROR_PSTABLE_NEXIST, //State does not exist in the table
 
+  TNN_ERROR_PROFILE_EXIST, //Object already profiled
+  TNN_ERROR_PROFILE_NEXIST, //Object is not profiled
+
+  TNN_ERROR_LOADER_NVALIDP, //Loader invalid input parameters
+  TNN_ERROR_LOADER_THREAD, //Loader thread could not be started
+
+  TNN_ERROR_CKPT_THREAD, //Checkpoint writer thread could not be started
+
+  TNN_ERROR_INGEST_THREAD, //Ingest threads could not be started
+
+  TNN_ERROR_STREAM_NVALIDP, //Stream invalid input parameters
+
+  TNN_ERROR_PS_NVALIDP, //Parameter server invalid input parameters
+  TNN_ERROR_PS_IO, //Parameter server socket error
+
   TNN_ERROR_SIZE //Size indicator
 } tnn_error;
 
@@ -0,0 +1,48 @@
+/* Thunder Neural Networks Export Program Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This program loads a machine written by tnn_machine_save and exports its forward propagation as a C source.
+ * Usage: tnn_export <machine file> <name> [output file]
+ * The source is written to standard output if no output file is given.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_machine.h>
+
+int main(int argc, char **argv){
+  tnn_machine m;
+  tnn_error ret;
+  FILE *fp;
+
+  if(argc < 3 || argc > 4){
+    fprintf(stderr, "Usage: %s <machine file> <name> [output file]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if((ret = tnn_machine_load(&m, argv[1])) != TNN_ERROR_SUCCESS){
+    fprintf(stderr, "%s: cannot load machine from %s (error %d)\n", argv[0], argv[1], (int)ret);
+    return EXIT_FAILURE;
+  }
+
+  fp = stdout;
+  if(argc == 4 && (fp = fopen(argv[3], "w")) == NULL){
+    fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[3]);
+    tnn_machine_destroy(&m);
+    return EXIT_FAILURE;
+  }
+
+  ret = tnn_machine_export_c(&m, fp, argv[2]);
+  if(fp != stdout && fclose(fp) != 0 && ret == TNN_ERROR_SUCCESS){
+    ret = TNN_ERROR_FILE;
+  }
+  tnn_machine_destroy(&m);
+  if(ret != TNN_ERROR_SUCCESS){
+    fprintf(stderr, "%s: cannot export machine as %s (error %d)\n", argv[0], argv[2], (int)ret);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,728 @@
+/* Thunder Neural Networks Text Ingest Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_ingest_dense(const char *file, tnn_ingest_format format, size_t ncol, size_t nthreads,
+ *                            gsl_matrix **inputs, size_t **labels);
+ * tnn_error tnn_ingest_sparse(const char *file, size_t ncol, size_t nthreads, tnn_sparse *inputs,
+ *                             size_t **labels);
+ * tnn_error tnn_ingest_dataset(const char *file, const char *cache, tnn_ingest_format format, size_t ncol,
+ *                              size_t nthreads, tnn_dataset *ds);
+ * tnn_error tnn_ingest_sparse_cached(const char *file, const char *cache, size_t ncol, size_t nthreads,
+ *                                    tnn_sparse *inputs, size_t **labels);
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_sparse.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_ingest.h>
+
+//A chunk of text parsed by one thread
+typedef struct __STRUCT_tnn_ingest_chunk{
+  //The text of whole lines
+  const char *beg;
+  const char *end;
+  //Format and pass (1 counts, 2 fills)
+  tnn_ingest_format format;
+  int pass;
+  //Number of columns (0 until the first CSV line when not given)
+  size_t ncol;
+  //Counted rows and nonzeros, and largest libsvm index
+  size_t rows;
+  size_t nnz;
+  size_t maxcol;
+  //First row and nonzero of the chunk in the outputs
+  size_t row0;
+  size_t nnz0;
+  //Outputs (one of m and s)
+  gsl_matrix *m;
+  tnn_sparse *s;
+  size_t *labels;
+  //Line buffer
+  char *line;
+  size_t lcap;
+  //Error of the chunk
+  tnn_error err;
+} tnn_ingest_chunk;
+
+//A mapped text file cut into chunks
+typedef struct __STRUCT_tnn_ingest_text{
+  char *map;
+  size_t size;
+  size_t n;
+  tnn_ingest_chunk *c;
+  //Totals after counting
+  size_t rows;
+  size_t nnz;
+  size_t ncol;
+} tnn_ingest_text;
+
+//Parse a label
+static tnn_error tnn_ingest_label(char *p, char **e, tnn_ingest_format format, size_t *label){
+  long l;
+
+  l = strtol(p, e, 10);
+  if(*e == p){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  if(l < 0){
+    if(format != TNN_INGEST_FORMAT_LIBSVM || l != -1){
+      return TNN_ERROR_FILE_FORMAT;
+    }
+    l = 0;
+  }
+  *label = (size_t)l;
+  return TNN_ERROR_SUCCESS;
+}
+
+//Parse a CSV line as row
+static tnn_error tnn_ingest_line_csv(tnn_ingest_chunk *c, char *p, size_t row){
+  tnn_error ret;
+  size_t label, j;
+  double v;
+  char *e;
+
+  TNN_MACRO_ERRORTEST(tnn_ingest_label(p, &e, c->format, &label), ret);
+  for(p = e; *p == ' ' || *p == '\t'; p = p + 1);
+
+  for(j = 0; *p == ','; j = j + 1){
+    p = p + 1;
+    if(c->pass == 1){
+      //Only the fields are counted
+      for(; *p != ',' && *p != '\0'; p = p + 1);
+    } else {
+      if(j >= c->ncol){
+	return TNN_ERROR_FILE_FORMAT;
+      }
+      v = strtod(p, &e);
+      if(e == p){
+	return TNN_ERROR_FILE_FORMAT;
+      }
+      gsl_matrix_set(c->m, row, j, v);
+      for(p = e; *p == ' ' || *p == '\t'; p = p + 1);
+    }
+  }
+  if(*p != '\0'){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  if(c->pass == 1 && c->ncol == 0){
+    c->ncol = j;
+  }
+  if(j != c->ncol){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  if(c->pass == 2){
+    c->labels[row] = label;
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Parse a libsvm line as row, whose nonzeros start at *nz
+static tnn_error tnn_ingest_line_libsvm(tnn_ingest_chunk *c, char *p, size_t row, size_t *nz){
+  tnn_error ret;
+  size_t label, prev;
+  unsigned long idx;
+  double v;
+  char *e;
+
+  TNN_MACRO_ERRORTEST(tnn_ingest_label(p, &e, c->format, &label), ret);
+
+  //Indices are 1-based and increasing
+  prev = 0;
+  for(p = e;;){
+    for(; *p == ' ' || *p == '\t'; p = p + 1);
+    if(*p == '\0'){
+      break;
+    }
+    idx = strtoul(p, &e, 10);
+    if(e == p || *e != ':' || idx <= prev){
+      return TNN_ERROR_FILE_FORMAT;
+    }
+    p = e + 1;
+    if(c->pass == 1){
+      for(; *p != ' ' && *p != '\t' && *p != '\0'; p = p + 1);
+      c->nnz = c->nnz + 1;
+      c->maxcol = idx > c->maxcol ? idx : c->maxcol;
+    } else {
+      v = strtod(p, &e);
+      if(e == p || idx > c->ncol){
+	return TNN_ERROR_FILE_FORMAT;
+      }
+      p = e;
+      if(c->m != NULL){
+	gsl_matrix_set(c->m, row, idx - 1, v);
+      } else {
+	c->s->ind[*nz] = idx - 1;
+	c->s->val[*nz] = v;
+	*nz = *nz + 1;
+      }
+    }
+    prev = idx;
+  }
+
+  if(c->pass == 2){
+    c->labels[row] = label;
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Parse the lines of a chunk
+static void *tnn_ingest_run(void *arg){
+  tnn_ingest_chunk *c;
+  const char *p, *q;
+  size_t n, row, nz;
+  char *line;
+
+  c = (tnn_ingest_chunk *)arg;
+  row = c->row0;
+  nz = c->nnz0;
+  if(c->pass == 1){
+    c->rows = 0;
+    c->nnz = 0;
+    c->maxcol = 0;
+  }
+
+  for(p = c->beg; p < c->end && c->err == TNN_ERROR_SUCCESS; p = q + 1){
+    q = (const char *)memchr(p, '\n', (size_t)(c->end - p));
+    if(q == NULL){
+      q = c->end;
+    }
+
+    //Copy the line so that the number parsers see its end
+    n = (size_t)(q - p);
+    if(n > 0 && p[n - 1] == '\r'){
+      n = n - 1;
+    }
+    if(n + 1 > c->lcap){
+      line = (char *) realloc(c->line, 2*(n + 1));
+      if(line == NULL){
+	c->err = TNN_ERROR_ALLOC;
+	break;
+      }
+      c->line = line;
+      c->lcap = 2*(n + 1);
+    }
+    memcpy(c->line, p, n);
+    c->line[n] = '\0';
+
+    //Skip empty and comment lines
+    for(line = c->line; *line == ' ' || *line == '\t'; line = line + 1);
+    if(*line == '\0' || *line == '#'){
+      continue;
+    }
+
+    if(c->format == TNN_INGEST_FORMAT_CSV){
+      c->err = tnn_ingest_line_csv(c, line, row);
+    } else {
+      c->err = tnn_ingest_line_libsvm(c, line, row, &nz);
+    }
+    if(c->pass == 2 && c->s != NULL){
+      c->s->ptr[row + 1] = nz;
+    }
+    row = row + 1;
+  }
+
+  if(c->pass == 1){
+    c->rows = row - c->row0;
+  }
+  return NULL;
+}
+
+//Run a pass over all the chunks, the first one in the calling thread
+static tnn_error tnn_ingest_pass(tnn_ingest_text *t, int pass){
+  pthread_t *th;
+  size_t k, started;
+  tnn_error ret;
+
+  th = (pthread_t *) malloc(t->n*sizeof(pthread_t));
+  if(th == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].pass = pass;
+    t->c[k].err = TNN_ERROR_SUCCESS;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+  for(started = 1; started < t->n; started = started + 1){
+    if(pthread_create(&th[started], NULL, tnn_ingest_run, &t->c[started]) != 0){
+      ret = TNN_ERROR_INGEST_THREAD;
+      break;
+    }
+  }
+  tnn_ingest_run(&t->c[0]);
+  for(k = 1; k < started; k = k + 1){
+    pthread_join(th[k], NULL);
+  }
+  free(th);
+
+  for(k = 0; k < t->n && ret == TNN_ERROR_SUCCESS; k = k + 1){
+    ret = t->c[k].err;
+  }
+  return ret;
+}
+
+//Release a text file
+static void tnn_ingest_close(tnn_ingest_text *t){
+  size_t k;
+
+  for(k = 0; k < t->n; k = k + 1){
+    free(t->c[k].line);
+  }
+  free(t->c);
+  munmap(t->map, t->size);
+}
+
+//Map a text file, cut it into chunks and count its rows, nonzeros and columns
+static tnn_error tnn_ingest_count(tnn_ingest_text *t, const char *file, tnn_ingest_format format, size_t ncol,
+				  size_t nthreads){
+  struct stat st;
+  const char *q;
+  size_t k, pos;
+  tnn_error ret;
+  int fd;
+
+  //Map the file
+  if((fd = open(file, O_RDONLY)) < 0){
+    return TNN_ERROR_FILE;
+  }
+  if(fstat(fd, &st) != 0){
+    close(fd);
+    return TNN_ERROR_FILE;
+  }
+  if(st.st_size == 0){
+    close(fd);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  t->size = (size_t)st.st_size;
+  t->map = (char *) mmap(NULL, t->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(t->map == MAP_FAILED){
+    return TNN_ERROR_FILE;
+  }
+  madvise(t->map, t->size, MADV_SEQUENTIAL);
+
+  //One chunk per thread, but not smaller than TNN_INGEST_CHUNK_MIN
+  if(nthreads == 0){
+    nthreads = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? (size_t)sysconf(_SC_NPROCESSORS_ONLN) : 1;
+  }
+  t->n = t->size/TNN_INGEST_CHUNK_MIN + 1 < nthreads ? t->size/TNN_INGEST_CHUNK_MIN + 1 : nthreads;
+  t->c = (tnn_ingest_chunk *) calloc(t->n, sizeof(tnn_ingest_chunk));
+  if(t->c == NULL){
+    munmap(t->map, t->size);
+    return TNN_ERROR_ALLOC;
+  }
+
+  //Each chunk starts after the first newline at or past its share of the file
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].format = format;
+    t->c[k].ncol = ncol;
+    if(k == 0){
+      t->c[k].beg = t->map;
+    } else {
+      pos = k*(t->size/t->n);
+      q = (const char *)memchr(t->map + pos - 1, '\n', t->size - pos + 1);
+      t->c[k].beg = q != NULL ? q + 1 : t->map + t->size;
+      if(t->c[k].beg < t->c[k - 1].beg){
+	t->c[k].beg = t->c[k - 1].beg;
+      }
+    }
+  }
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].end = k + 1 < t->n ? t->c[k + 1].beg : t->map + t->size;
+  }
+
+  //Count
+  if((ret = tnn_ingest_pass(t, 1)) != TNN_ERROR_SUCCESS){
+    tnn_ingest_close(t);
+    return ret;
+  }
+  t->rows = 0;
+  t->nnz = 0;
+  t->ncol = ncol;
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].row0 = t->rows;
+    t->c[k].nnz0 = t->nnz;
+    t->rows = t->rows + t->c[k].rows;
+    t->nnz = t->nnz + t->c[k].nnz;
+    if(t->c[k].rows == 0){
+      continue;
+    }
+    if(format == TNN_INGEST_FORMAT_CSV){
+      //Every chunk must agree on the columns
+      if(t->ncol == 0){
+	t->ncol = t->c[k].ncol;
+      } else if(t->c[k].ncol != t->ncol){
+	ret = TNN_ERROR_FILE_FORMAT;
+      }
+    } else if(ncol == 0){
+      t->ncol = t->c[k].maxcol > t->ncol ? t->c[k].maxcol : t->ncol;
+    }
+  }
+  if(ret == TNN_ERROR_SUCCESS && (t->rows == 0 || t->ncol == 0)){
+    ret = TNN_ERROR_FILE_FORMAT;
+  }
+  if(ret != TNN_ERROR_SUCCESS){
+    tnn_ingest_close(t);
+    return ret;
+  }
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].ncol = t->ncol;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Parse a counted text file into m or s, and labels
+static tnn_error tnn_ingest_fill(tnn_ingest_text *t, gsl_matrix *m, tnn_sparse *s, size_t *labels){
+  size_t k;
+
+  for(k = 0; k < t->n; k = k + 1){
+    t->c[k].m = m;
+    t->c[k].s = s;
+    t->c[k].labels = labels;
+  }
+  if(s != NULL){
+    s->ptr[0] = 0;
+  }
+  return tnn_ingest_pass(t, 2);
+}
+
+//Fill the key of a cache built with ncol and format
+static void tnn_ingest_key_set(tnn_ingest_key *k, size_t ncol, tnn_ingest_format format){
+  memcpy(k->magic, TNN_INGEST_KEY_MAGIC, 8);
+  k->ncol = ncol;
+  k->format = format;
+}
+
+//Whether the cache exists, is not older than the text, and has the key of ncol and format at byte offset off
+static int tnn_ingest_fresh(const char *file, const char *cache, size_t off, size_t ncol,
+			    tnn_ingest_format format){
+  struct stat sf, sc;
+  tnn_ingest_key k, kc;
+  FILE *fp;
+  int ok;
+
+  if(stat(file, &sf) != 0 || stat(cache, &sc) != 0 || sc.st_mtime < sf.st_mtime){
+    return 0;
+  }
+  if((fp = fopen(cache, "rb")) == NULL){
+    return 0;
+  }
+  tnn_ingest_key_set(&k, ncol, format);
+  ok = fseek(fp, (long)off, SEEK_SET) == 0 && fread(&kc, sizeof(tnn_ingest_key), 1, fp) == 1
+    && memcmp(kc.magic, k.magic, 8) == 0 && kc.ncol == k.ncol && kc.format == k.format;
+  fclose(fp);
+  return ok;
+}
+
+//Temporary name of a cache file, renamed over the cache once complete
+static char *tnn_ingest_temp(const char *cache){
+  char *temp;
+
+  temp = (char *) malloc(strlen(cache) + 5);
+  if(temp != NULL){
+    strcpy(temp, cache);
+    strcat(temp, ".tmp");
+  }
+  return temp;
+}
+
+//Parse a text file into a newly allocated matrix of ncol columns and label array, with nthreads threads
+tnn_error tnn_ingest_dense(const char *file, tnn_ingest_format format, size_t ncol, size_t nthreads,
+			   gsl_matrix **inputs, size_t **labels){
+  tnn_ingest_text t;
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_ingest_count(&t, file, format, ncol, nthreads), ret);
+
+  //Missing libsvm entries are zeros
+  *inputs = gsl_matrix_calloc(t.rows, t.ncol);
+  *labels = (size_t *) malloc(t.rows*sizeof(size_t));
+  if(*inputs == NULL || *labels == NULL){
+    if(*inputs != NULL){
+      gsl_matrix_free(*inputs);
+    }
+    free(*labels);
+    tnn_ingest_close(&t);
+    return TNN_ERROR_ALLOC;
+  }
+
+  ret = tnn_ingest_fill(&t, *inputs, NULL, *labels);
+  tnn_ingest_close(&t);
+  if(ret != TNN_ERROR_SUCCESS){
+    gsl_matrix_free(*inputs);
+    free(*labels);
+  }
+  return ret;
+}
+
+//Parse a libsvm file into a sparse matrix of ncol columns and a newly allocated label array
+tnn_error tnn_ingest_sparse(const char *file, size_t ncol, size_t nthreads, tnn_sparse *inputs,
+			    size_t **labels){
+  tnn_ingest_text t;
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_ingest_count(&t, file, TNN_INGEST_FORMAT_LIBSVM, ncol, nthreads), ret);
+
+  //Allocated to the exact counts
+  inputs->size1 = t.rows;
+  inputs->size2 = t.ncol;
+  inputs->nnz = t.nnz;
+  inputs->rcap = t.rows;
+  inputs->cap = t.nnz > 0 ? t.nnz : 1;
+  inputs->ptr = (size_t *) malloc((inputs->rcap + 1)*sizeof(size_t));
+  inputs->ind = (size_t *) malloc(inputs->cap*sizeof(size_t));
+  inputs->val = (double *) malloc(inputs->cap*sizeof(double));
+  *labels = (size_t *) malloc(t.rows*sizeof(size_t));
+  if(inputs->ptr == NULL || inputs->ind == NULL || inputs->val == NULL || *labels == NULL){
+    tnn_sparse_destroy(inputs);
+    free(*labels);
+    tnn_ingest_close(&t);
+    return TNN_ERROR_ALLOC;
+  }
+
+  ret = tnn_ingest_fill(&t, NULL, inputs, *labels);
+  tnn_ingest_close(&t);
+  if(ret != TNN_ERROR_SUCCESS){
+    tnn_sparse_destroy(inputs);
+    free(*labels);
+  }
+  return ret;
+}
+
+//Parse a text file straight into a new dataset file
+static tnn_error tnn_ingest_dataset_write(const char *file, const char *temp, tnn_ingest_format format,
+					  size_t ncol, size_t nthreads){
+  tnn_ingest_text t;
+  tnn_dataset_header h;
+  tnn_ingest_key k;
+  gsl_matrix_view mv;
+  size_t size;
+  char *map;
+  tnn_error ret;
+  int fd;
+
+  //Labels are written in place
+  if(sizeof(size_t) != sizeof(uint64_t)){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  TNN_MACRO_ERRORTEST(tnn_ingest_count(&t, file, format, ncol, nthreads), ret);
+
+  //Lay out the file as tnn_dataset_write does
+  memcpy(h.magic, TNN_DATASET_FILE_MAGIC, 8);
+  h.version = TNN_DATASET_FILE_VERSION;
+  h.endian = TNN_DATASET_FILE_ENDIAN;
+  h.dsize = sizeof(double);
+  h.size1 = t.rows;
+  h.size2 = t.ncol;
+  h.offset = (sizeof(tnn_dataset_header) + sizeof(tnn_ingest_key) + TNN_DATASET_FILE_ALIGN - 1)
+    /TNN_DATASET_FILE_ALIGN*TNN_DATASET_FILE_ALIGN;
+  h.loffset = h.offset + h.size1*h.size2*sizeof(double);
+  size = h.loffset + h.size1*sizeof(uint64_t);
+
+  //Map the new file, which reads as zeros
+  if((fd = open(temp, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0){
+    tnn_ingest_close(&t);
+    return TNN_ERROR_FILE;
+  }
+  if(ftruncate(fd, (off_t)size) != 0
+     || (map = (char *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED){
+    close(fd);
+    tnn_ingest_close(&t);
+    return TNN_ERROR_FILE;
+  }
+  memcpy(map, &h, sizeof(tnn_dataset_header));
+  tnn_ingest_key_set(&k, ncol, format);
+  memcpy(map + sizeof(tnn_dataset_header), &k, sizeof(tnn_ingest_key));
+
+  //Parse into the mapping
+  mv = gsl_matrix_view_array((double *)(map + h.offset), h.size1, h.size2);
+  ret = tnn_ingest_fill(&t, &mv.matrix, NULL, (size_t *)(map + h.loffset));
+  tnn_ingest_close(&t);
+  if(msync(map, size, MS_SYNC) != 0 && ret == TNN_ERROR_SUCCESS){
+    ret = TNN_ERROR_FILE;
+  }
+  munmap(map, size);
+  if(close(fd) != 0 && ret == TNN_ERROR_SUCCESS){
+    ret = TNN_ERROR_FILE;
+  }
+  return ret;
+}
+
+//Open the dataset cache of a text file, creating it from the text first if it is missing or out of date
+tnn_error tnn_ingest_dataset(const char *file, const char *cache, tnn_ingest_format format, size_t ncol,
+			     size_t nthreads, tnn_dataset *ds){
+  tnn_error ret;
+  char *temp;
+
+  if(!tnn_ingest_fresh(file, cache, sizeof(tnn_dataset_header), ncol, format)){
+    if((temp = tnn_ingest_temp(cache)) == NULL){
+      return TNN_ERROR_ALLOC;
+    }
+    ret = tnn_ingest_dataset_write(file, temp, format, ncol, nthreads);
+    if(ret == TNN_ERROR_SUCCESS && rename(temp, cache) != 0){
+      ret = TNN_ERROR_FILE;
+    }
+    if(ret != TNN_ERROR_SUCCESS){
+      remove(temp);
+    }
+    free(temp);
+    if(ret != TNN_ERROR_SUCCESS){
+      return ret;
+    }
+  }
+
+  return tnn_dataset_open(ds, cache);
+}
+
+//Write a sparse matrix and labels parsed with ncol to a sparse cache file
+static tnn_error tnn_ingest_sparse_write(const char *file, size_t ncol, tnn_sparse *s, size_t *labels){
+  tnn_ingest_sparse_header h;
+  tnn_ingest_key k;
+  FILE *fp;
+  tnn_error ret;
+
+  memcpy(h.magic, TNN_INGEST_SPARSE_MAGIC, 8);
+  h.version = TNN_INGEST_SPARSE_VERSION;
+  h.endian = TNN_INGEST_SPARSE_ENDIAN;
+  h.size1 = s->size1;
+  h.size2 = s->size2;
+  h.nnz = s->nnz;
+  tnn_ingest_key_set(&k, ncol, TNN_INGEST_FORMAT_LIBSVM);
+
+  if((fp = fopen(file, "wb")) == NULL){
+    return TNN_ERROR_FILE;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  if(fwrite(&h, sizeof(tnn_ingest_sparse_header), 1, fp) != 1
+     || fwrite(&k, sizeof(tnn_ingest_key), 1, fp) != 1
+     || fwrite(s->ptr, sizeof(uint64_t), s->size1 + 1, fp) != s->size1 + 1
+     || fwrite(s->ind, sizeof(uint64_t), s->nnz, fp) != s->nnz
+     || fwrite(s->val, sizeof(double), s->nnz, fp) != s->nnz
+     || fwrite(labels, sizeof(uint64_t), s->size1, fp) != s->size1){
+    ret = TNN_ERROR_FILE;
+  }
+  if(fclose(fp) != 0){
+    ret = TNN_ERROR_FILE;
+  }
+  return ret;
+}
+
+//Read a sparse cache file into a sparse matrix and a newly allocated label array
+static tnn_error tnn_ingest_sparse_read(const char *file, tnn_sparse *s, size_t **labels){
+  tnn_ingest_sparse_header h;
+  tnn_ingest_key k;
+  tnn_error ret;
+  size_t i;
+  FILE *fp;
+
+  if((fp = fopen(file, "rb")) == NULL){
+    return TNN_ERROR_FILE;
+  }
+  if(fread(&h, sizeof(tnn_ingest_sparse_header), 1, fp) != 1
+     || fread(&k, sizeof(tnn_ingest_key), 1, fp) != 1){
+    fclose(fp);
+    return TNN_ERROR_FILE;
+  }
+  if(memcmp(h.magic, TNN_INGEST_SPARSE_MAGIC, 8) != 0 || h.version != TNN_INGEST_SPARSE_VERSION
+     || h.endian != TNN_INGEST_SPARSE_ENDIAN || memcmp(k.magic, TNN_INGEST_KEY_MAGIC, 8) != 0
+     || h.size1 >= SIZE_MAX/sizeof(size_t) || h.nnz >= SIZE_MAX/sizeof(double)){
+    fclose(fp);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  s->size1 = h.size1;
+  s->size2 = h.size2;
+  s->nnz = h.nnz;
+  s->rcap = h.size1;
+  s->cap = h.nnz > 0 ? h.nnz : 1;
+  s->ptr = (size_t *) malloc((s->rcap + 1)*sizeof(size_t));
+  s->ind = (size_t *) malloc(s->cap*sizeof(size_t));
+  s->val = (double *) malloc(s->cap*sizeof(double));
+  *labels = (size_t *) malloc((h.size1 > 0 ? h.size1 : 1)*sizeof(size_t));
+  if(s->ptr == NULL || s->ind == NULL || s->val == NULL || *labels == NULL){
+    tnn_sparse_destroy(s);
+    free(*labels);
+    fclose(fp);
+    return TNN_ERROR_ALLOC;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+  if(fread(s->ptr, sizeof(uint64_t), s->size1 + 1, fp) != s->size1 + 1
+     || fread(s->ind, sizeof(uint64_t), s->nnz, fp) != s->nnz
+     || fread(s->val, sizeof(double), s->nnz, fp) != s->nnz
+     || fread(*labels, sizeof(uint64_t), s->size1, fp) != s->size1){
+    ret = TNN_ERROR_FILE;
+  } else if(s->ptr[0] != 0 || s->ptr[s->size1] != s->nnz){
+    ret = TNN_ERROR_FILE_FORMAT;
+  }
+
+  //The rows must be valid for every reader of the matrix
+  for(i = 0; i < s->size1 && ret == TNN_ERROR_SUCCESS; i = i + 1){
+    if(s->ptr[i + 1] < s->ptr[i]){
+      ret = TNN_ERROR_FILE_FORMAT;
+    }
+  }
+  for(i = 0; i < s->nnz && ret == TNN_ERROR_SUCCESS; i = i + 1){
+    if(s->ind[i] >= s->size2){
+      ret = TNN_ERROR_FILE_FORMAT;
+    }
+  }
+  fclose(fp);
+  if(ret != TNN_ERROR_SUCCESS){
+    tnn_sparse_destroy(s);
+    free(*labels);
+  }
+  return ret;
+}
+
+//Load the sparse cache of a libsvm file, creating it from the text first if it is missing or out of date
+tnn_error tnn_ingest_sparse_cached(const char *file, const char *cache, size_t ncol, size_t nthreads,
+				   tnn_sparse *inputs, size_t **labels){
+  tnn_error ret;
+  char *temp;
+
+  //Indices and labels are stored as uint64
+  if(sizeof(size_t) != sizeof(uint64_t)){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  if(tnn_ingest_fresh(file, cache, sizeof(tnn_ingest_sparse_header), ncol, TNN_INGEST_FORMAT_LIBSVM)){
+    return tnn_ingest_sparse_read(cache, inputs, labels);
+  }
+
+  TNN_MACRO_ERRORTEST(tnn_ingest_sparse(file, ncol, nthreads, inputs, labels), ret);
+  if((temp = tnn_ingest_temp(cache)) == NULL){
+    ret = TNN_ERROR_ALLOC;
+  } else {
+    ret = tnn_ingest_sparse_write(temp, ncol, inputs, *labels);
+    if(ret == TNN_ERROR_SUCCESS && rename(temp, cache) != 0){
+      ret = TNN_ERROR_FILE;
+    }
+    if(ret != TNN_ERROR_SUCCESS){
+      remove(temp);
+    }
+    free(temp);
+  }
+  if(ret != TNN_ERROR_SUCCESS){
+    tnn_sparse_destroy(inputs);
+    free(*labels);
+  }
+  return ret;
+}
@@ -0,0 +1,106 @@
+/* Thunder Neural Networks Text Ingest Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Ingest parses labelled samples from CSV or libsvm text. The file is mapped and cut into one chunk per thread
+ * at line boundaries. A first parallel pass counts the rows (and nonzeros) of each chunk, so that the output
+ * is allocated once, and a second parallel pass parses every chunk straight into its own rows.
+ *
+ * CSV lines are "label,x1,x2,...". libsvm lines are "label i:x i:x ..." with 1-based, increasing indices.
+ * Labels are non-negative integers, except that a libsvm label of -1 is read as 0. Empty lines and lines
+ * starting with '#' are skipped.
+ *
+ * The cached forms parse the text only when the binary cache file is missing, older than the text or built
+ * with another ncol or format, and otherwise load the cache directly: a tnn_dataset file for dense inputs, a
+ * sparse cache file for sparse ones. The ncol and format a cache was built with are kept in a tnn_ingest_key
+ * right after its header, which in a dataset file sits in the padding before the rows. The dataset file is
+ * filled in place through a mapping, so the parsed text never has to fit in memory. A sparse cache is checked
+ * to hold valid compressed rows when loaded.
+ *
+ * This header defines the following structures:
+ * tnn_ingest_format(TNN_INGEST_FORMAT_CSV, TNN_INGEST_FORMAT_LIBSVM)
+ * tnn_ingest_sparse_header(char magic[8], uint32_t version, uint32_t endian, uint64_t size1, uint64_t size2,
+ *                          uint64_t nnz)
+ * tnn_ingest_key(char magic[8], uint64_t ncol, uint64_t format)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_ingest_dense(const char *file, tnn_ingest_format format, size_t ncol, size_t nthreads,
+ *                            gsl_matrix **inputs, size_t **labels);
+ * tnn_error tnn_ingest_sparse(const char *file, size_t ncol, size_t nthreads, tnn_sparse *inputs,
+ *                             size_t **labels);
+ * tnn_error tnn_ingest_dataset(const char *file, const char *cache, tnn_ingest_format format, size_t ncol,
+ *                              size_t nthreads, tnn_dataset *ds);
+ * tnn_error tnn_ingest_sparse_cached(const char *file, const char *cache, size_t ncol, size_t nthreads,
+ *                                    tnn_sparse *inputs, size_t **labels);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_sparse.h>
+#include <tnn/tnn_dataset.h>
+
+#ifndef TNN_INGEST_H
+#define TNN_INGEST_H
+
+//Smallest share of the text given to a thread in bytes
+#define TNN_INGEST_CHUNK_MIN 1048576
+
+//Sparse cache file format: header, key, row pointers, column indices (all uint64), values, then uint64 labels
+#define TNN_INGEST_SPARSE_MAGIC "TNNSPRS1"
+#define TNN_INGEST_SPARSE_VERSION 2
+#define TNN_INGEST_SPARSE_ENDIAN 0x01020304
+
+//Magic string of the key following the header of a cache file
+#define TNN_INGEST_KEY_MAGIC "TNNINGK1"
+
+//Text formats
+typedef enum __ENUM_tnn_ingest_format{
+  TNN_INGEST_FORMAT_CSV, //label,x1,x2,...
+  TNN_INGEST_FORMAT_LIBSVM //label i:x i:x ...
+} tnn_ingest_format;
+
+//Sparse cache file header
+typedef struct __STRUCT_tnn_ingest_sparse_header{
+  //Magic string TNN_INGEST_SPARSE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_INGEST_SPARSE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Number of rows, columns and nonzeros
+  uint64_t size1;
+  uint64_t size2;
+  uint64_t nnz;
+} tnn_ingest_sparse_header;
+
+//Parameters a cache file was built with
+typedef struct __STRUCT_tnn_ingest_key{
+  //Magic string TNN_INGEST_KEY_MAGIC (without the terminating zero)
+  char magic[8];
+  //Number of columns asked for (0 if taken from the text) and text format
+  uint64_t ncol;
+  uint64_t format;
+} tnn_ingest_key;
+
+//Parse a text file into a newly allocated matrix of ncol columns and label array, with nthreads threads
+//If ncol is 0 it is taken from the text. If nthreads is 0 there is one per processor.
+tnn_error tnn_ingest_dense(const char *file, tnn_ingest_format format, size_t ncol, size_t nthreads,
+                           gsl_matrix **inputs, size_t **labels);
+
+//Parse a libsvm file into a sparse matrix of ncol columns and a newly allocated label array
+tnn_error tnn_ingest_sparse(const char *file, size_t ncol, size_t nthreads, tnn_sparse *inputs,
+                            size_t **labels);
+
+//Open the dataset cache of a text file, creating it from the text first if it is missing or out of date
+//A cache built with another ncol or format is out of date.
+tnn_error tnn_ingest_dataset(const char *file, const char *cache, tnn_ingest_format format, size_t ncol,
+                             size_t nthreads, tnn_dataset *ds);
+
+//Load the sparse cache of a libsvm file, creating it from the text first if it is missing or out of date
+//A cache built with another ncol is out of date, and a cache not holding valid compressed rows is an error.
+tnn_error tnn_ingest_sparse_cached(const char *file, const char *cache, size_t ncol, size_t nthreads,
+                                   tnn_sparse *inputs, size_t **labels);
+
+#endif //TNN_INGEST_H
@@ -0,0 +1,199 @@
+/* Thunder Neural Networks Loader Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_loader_init(tnn_loader *ld, TNN_LOADER_FUNC_FETCH fetch, void *src, size_t n, size_t size,
+ *                           size_t depth);
+ * tnn_error tnn_loader_pull(tnn_loader *ld, gsl_vector_view *x, size_t *label);
+ * tnn_error tnn_loader_release(tnn_loader *ld);
+ * tnn_error tnn_loader_destroy(tnn_loader *ld);
+ * tnn_error tnn_loader_fetch_matrix(void *src, size_t i, gsl_vector *x, size_t *label);
+ * tnn_error tnn_loader_fetch_dataset(void *src, size_t i, gsl_vector *x, size_t *label);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_loader.h>
+
+//The loader thread: fill the free slots in order until stopped or failed
+static void *tnn_loader_run(void *arg){
+  tnn_loader *ld;
+  gsl_vector_view x;
+  size_t slot, i;
+  tnn_error ret;
+
+  ld = (tnn_loader *) arg;
+  for(i = 0; ; i = (i + 1)%ld->n){
+    //Wait for a free slot
+    pthread_mutex_lock(&ld->mutex);
+    while(ld->stop == 0 && ld->head - ld->tail >= ld->depth){
+      pthread_cond_wait(&ld->empty, &ld->mutex);
+    }
+    if(ld->stop != 0){
+      pthread_mutex_unlock(&ld->mutex);
+      break;
+    }
+    slot = ld->head%ld->depth;
+    pthread_mutex_unlock(&ld->mutex);
+
+    //The slot is owned by this thread until head moves past it
+    x = gsl_vector_view_array(ld->buf + slot*ld->stride, ld->size);
+    ret = ld->fetch(ld->src, i, &x.vector, &ld->labels[slot]);
+
+    pthread_mutex_lock(&ld->mutex);
+    if(ret != TNN_ERROR_SUCCESS){
+      ld->err = ret;
+    } else {
+      ld->head = ld->head + 1;
+    }
+    pthread_cond_signal(&ld->full);
+    pthread_mutex_unlock(&ld->mutex);
+    if(ret != TNN_ERROR_SUCCESS){
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+//Initialize a loader of n samples of the size from src with depth slots, and start the thread
+tnn_error tnn_loader_init(tnn_loader *ld, TNN_LOADER_FUNC_FETCH fetch, void *src, size_t n, size_t size,
+                          size_t depth){
+  void *buf;
+
+  if(n < 1 || size < 1 || depth < 1){
+    return TNN_ERROR_LOADER_NVALIDP;
+  }
+
+  ld->fetch = fetch;
+  ld->src = src;
+  ld->n = n;
+  ld->size = size;
+  ld->depth = depth;
+  ld->head = 0;
+  ld->tail = 0;
+  ld->err = TNN_ERROR_SUCCESS;
+  ld->stop = 0;
+
+  //Pad the slots to whole alignment units so that every one of them is aligned
+  ld->stride = (size*sizeof(double) + TNN_LOADER_ALIGN - 1)/TNN_LOADER_ALIGN*TNN_LOADER_ALIGN/sizeof(double);
+  if(posix_memalign(&buf, TNN_LOADER_ALIGN, depth*ld->stride*sizeof(double)) != 0){
+    return TNN_ERROR_ALLOC;
+  }
+  ld->buf = (double *) buf;
+  ld->labels = (size_t *) malloc(depth*sizeof(size_t));
+  if(ld->labels == NULL){
+    free(ld->buf);
+    return TNN_ERROR_ALLOC;
+  }
+
+  //Start the thread
+  pthread_mutex_init(&ld->mutex, NULL);
+  pthread_cond_init(&ld->full, NULL);
+  pthread_cond_init(&ld->empty, NULL);
+  if(pthread_create(&ld->thread, NULL, tnn_loader_run, ld) != 0){
+    pthread_cond_destroy(&ld->empty);
+    pthread_cond_destroy(&ld->full);
+    pthread_mutex_destroy(&ld->mutex);
+    free(ld->labels);
+    free(ld->buf);
+    return TNN_ERROR_LOADER_THREAD;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Wait for the next sample and point x to it. It stays valid until tnn_loader_release.
+tnn_error tnn_loader_pull(tnn_loader *ld, gsl_vector_view *x, size_t *label){
+  size_t slot;
+  tnn_error ret;
+
+  pthread_mutex_lock(&ld->mutex);
+  while(ld->head == ld->tail && ld->err == TNN_ERROR_SUCCESS){
+    pthread_cond_wait(&ld->full, &ld->mutex);
+  }
+  if(ld->head == ld->tail){
+    ret = ld->err;
+    pthread_mutex_unlock(&ld->mutex);
+    return ret;
+  }
+  slot = ld->tail%ld->depth;
+  pthread_mutex_unlock(&ld->mutex);
+
+  *x = gsl_vector_view_array(ld->buf + slot*ld->stride, ld->size);
+  *label = ld->labels[slot];
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Give the slot of the last pulled sample back to the thread
+tnn_error tnn_loader_release(tnn_loader *ld){
+  pthread_mutex_lock(&ld->mutex);
+  if(ld->tail < ld->head){
+    ld->tail = ld->tail + 1;
+    pthread_cond_signal(&ld->empty);
+  }
+  pthread_mutex_unlock(&ld->mutex);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Stop the thread and destroy the loader
+tnn_error tnn_loader_destroy(tnn_loader *ld){
+  pthread_mutex_lock(&ld->mutex);
+  ld->stop = 1;
+  pthread_cond_signal(&ld->empty);
+  pthread_mutex_unlock(&ld->mutex);
+  pthread_join(ld->thread, NULL);
+
+  pthread_cond_destroy(&ld->empty);
+  pthread_cond_destroy(&ld->full);
+  pthread_mutex_destroy(&ld->mutex);
+  free(ld->labels);
+  free(ld->buf);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Fetch function for a tnn_loader_matrix source
+tnn_error tnn_loader_fetch_matrix(void *src, size_t i, gsl_vector *x, size_t *label){
+  tnn_loader_matrix *s;
+  gsl_vector_view in;
+
+  s = (tnn_loader_matrix *) src;
+  if(i >= s->inputs->size1 || x->size != s->inputs->size2){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  in = gsl_matrix_row(s->inputs, i);
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&in.vector, x));
+  *label = s->labels[i];
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Fetch function for a tnn_dataset source. Rows are read ahead as in tnn_dataset_advise.
+tnn_error tnn_loader_fetch_dataset(void *src, size_t i, gsl_vector *x, size_t *label){
+  tnn_dataset *ds;
+  gsl_vector_view in;
+  tnn_error ret;
+
+  ds = (tnn_dataset *) src;
+  if(i >= ds->inputs.size1 || x->size != ds->inputs.size2){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_dataset_advise(ds, i), ret);
+  in = gsl_matrix_row(&ds->inputs, i);
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&in.vector, x));
+  *label = ds->labels[i];
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/* Thunder Neural Networks Loader Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A loader runs a thread that fetches samples ahead of the trainer into a ring of depth slots. Each slot
+ * holds one decoded sample and its label, aligned to TNN_LOADER_ALIGN bytes. The thread blocks when all
+ * slots are full, so memory stays bounded by depth samples whatever the speed of the trainer. Samples are
+ * fetched in order from 0, wrapping around at n for the next epoch, by a user function that may read files,
+ * decode or preprocess. The trainer takes the oldest slot with tnn_loader_pull and gives it back with
+ * tnn_loader_release.
+ *
+ * There must be only one consumer.
+ *
+ * This header defines the following structures:
+ * tnn_loader(TNN_LOADER_FUNC_FETCH fetch, void *src, size_t n, size_t size, size_t depth, size_t stride,
+ *            double *buf, size_t *labels, size_t head, size_t tail, tnn_error err, int stop,
+ *            pthread_t thread, pthread_mutex_t mutex, pthread_cond_t full, pthread_cond_t empty)
+ * tnn_loader_matrix(gsl_matrix *inputs, size_t *labels)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_loader_init(tnn_loader *ld, TNN_LOADER_FUNC_FETCH fetch, void *src, size_t n, size_t size,
+ *                           size_t depth);
+ * tnn_error tnn_loader_pull(tnn_loader *ld, gsl_vector_view *x, size_t *label);
+ * tnn_error tnn_loader_release(tnn_loader *ld);
+ * tnn_error tnn_loader_destroy(tnn_loader *ld);
+ * tnn_error tnn_loader_fetch_matrix(void *src, size_t i, gsl_vector *x, size_t *label);
+ * tnn_error tnn_loader_fetch_dataset(void *src, size_t i, gsl_vector *x, size_t *label);
+ */
+
+#include <stddef.h>
+#include <pthread.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+
+#ifndef TNN_LOADER_H
+#define TNN_LOADER_H
+
+//Alignment of the slots in bytes
+#define TNN_LOADER_ALIGN 64
+
+//Fetch sample i of src into x and label
+typedef tnn_error (*TNN_LOADER_FUNC_FETCH)(void *src, size_t i, gsl_vector *x, size_t *label);
+
+//The loader type
+typedef struct __STRUCT_tnn_loader{
+  //Sample source
+  TNN_LOADER_FUNC_FETCH fetch;
+  void *src;
+  //Number of samples in the source and size of a sample
+  size_t n;
+  size_t size;
+  //Number of slots and distance between slots in doubles
+  size_t depth;
+  size_t stride;
+  //Slot buffers and labels
+  double *buf;
+  size_t *labels;
+  //Number of slots filled and released since init
+  size_t head;
+  size_t tail;
+  //Error of the fetch stopping the thread
+  tnn_error err;
+  //Whether the thread should exit
+  int stop;
+  //The thread and its synchronization
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t full;
+  pthread_cond_t empty;
+} tnn_loader;
+
+//Source of tnn_loader_fetch_matrix
+typedef struct __STRUCT_tnn_loader_matrix{
+  gsl_matrix *inputs;
+  size_t *labels;
+} tnn_loader_matrix;
+
+//Initialize a loader of n samples of the size from src with depth slots, and start the thread
+tnn_error tnn_loader_init(tnn_loader *ld, TNN_LOADER_FUNC_FETCH fetch, void *src, size_t n, size_t size,
+                          size_t depth);
+
+//Wait for the next sample and point x to it. It stays valid until tnn_loader_release.
+//If the thread stopped on an error, the samples fetched before it are still pulled, then the error is returned.
+tnn_error tnn_loader_pull(tnn_loader *ld, gsl_vector_view *x, size_t *label);
+
+//Give the slot of the last pulled sample back to the thread
+tnn_error tnn_loader_release(tnn_loader *ld);
+
+//Stop the thread and destroy the loader
+tnn_error tnn_loader_destroy(tnn_loader *ld);
+
+//Fetch function for a tnn_loader_matrix source
+tnn_error tnn_loader_fetch_matrix(void *src, size_t i, gsl_vector *x, size_t *label);
+
+//Fetch function for a tnn_dataset source. Rows are read ahead as in tnn_dataset_advise.
+tnn_error tnn_loader_fetch_dataset(void *src, size_t i, gsl_vector *x, size_t *label);
+
+#endif //TNN_LOADER_H
@@ -8,10 +8,13 @@
  * tnn_error tnn_loss_randomize(tnn_loss *l, double k);
  * tnn_error tnn_loss_destroy(tnn_loss *m);
  * tnn_error tnn_loss_debug(tnn_loss *l);
+ * tnn_error tnn_loss_clone(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
  */
 
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_pstable.h>
 #include <tnn/tnn_loss.h>
 
 //Polymorphic back-propagation method
@@ -79,3 +82,11 @@ tnn_error tnn_loss_debug(tnn_loss *l){
 
   return TNN_ERROR_LOSS_FUNCNDEF;
 }
+
+//Polymorphic clone method: clone l1 to l2, and use t to retrieve input/output.
+tnn_error tnn_loss_clone(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t){
+  if(l1->clone != NULL){
+    return (*l1->clone)(l1, l2, t);
+  }
+  return TNN_ERROR_LOSS_FUNCNDEF;
+}
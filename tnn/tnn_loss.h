@@ -7,7 +7,8 @@
  *           TNN_LOSS_FUNC_BPROP bprop,
  *           TNN_LOSS_FUNC_FPROP fprop,
  *           TNN_LOSS_FUNC_RANDOMIZE randomize,
- *           TNN_LOSS_FUNC_DESTROY destroy)
+ *           TNN_LOSS_FUNC_DESTROY destroy,
+ *           TNN_LOSS_FUNC_CLONE clone)
  *
  * This header defines the following polymorphic functions:
  * tnn_error tnn_loss_bprop(tnn_loss *l);
@@ -15,10 +16,13 @@
  * tnn_error tnn_loss_randomize(tnn_loss *l, double k);
  * tnn_error tnn_loss_destroy(tnn_loss *l);
  * tnn_error tnn_loss_debug(tnn_loss *l);
+ * tnn_error tnn_loss_clone(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
  */
 
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_pstable.h>
 
 #ifndef TNN_LOSS_H
 #define TNN_LOSS_H
@@ -39,6 +43,7 @@ typedef tnn_error (*TNN_LOSS_FUNC_FPROP) (struct __STRUCT_tnn_loss *loss);
 typedef tnn_error (*TNN_LOSS_FUNC_RANDOMIZE) (struct __STRUCT_tnn_loss *loss, double k);
 typedef tnn_error (*TNN_LOSS_FUNC_DESTROY) (struct __STRUCT_tnn_loss *loss);
 typedef tnn_error (*TNN_LOSS_FUNC_DEBUG) (struct __STRUCT_tnn_loss *loss);
+typedef tnn_error (*TNN_LOSS_FUNC_CLONE) (struct __STRUCT_tnn_loss *l1, struct __STRUCT_tnn_loss *l2, tnn_pstable *t);
 
 //The structure
 typedef struct __STRUCT_tnn_loss{
@@ -63,6 +68,11 @@ typedef struct __STRUCT_tnn_loss{
   TNN_LOSS_FUNC_DESTROY destroy;
   //Debug method
   TNN_LOSS_FUNC_DEBUG debug;
+  //Clone method
+  TNN_LOSS_FUNC_CLONE clone;
+  //Original propagation methods while profiled (see tnn_profile.h)
+  TNN_LOSS_FUNC_BPROP pbprop;
+  TNN_LOSS_FUNC_FPROP pfprop;
 } tnn_loss;
 
 //Polymorphic back-propagation method
@@ -75,5 +85,7 @@ tnn_error tnn_loss_randomize(tnn_loss *l, double k);
 tnn_error tnn_loss_destroy(tnn_loss *l);
 //Polymorphic debug method
 tnn_error tnn_loss_debug(tnn_loss *l);
+//Polymorphic clone method: clone l1 to l2, and use t to retrieve input/output.
+tnn_error tnn_loss_clone(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
 
 #endif //TNN_LOSS_H
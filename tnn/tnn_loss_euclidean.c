@@ -9,6 +9,7 @@
  * tnn_error tnn_loss_randomize_euclidean(tnn_loss *l, double k);
  * tnn_error tnn_loss_destroy_euclidean(tnn_loss *l);
  * tnn_error tnn_loss_debug_euclidean(tnn_loss *l);
+ * tnn_error tnn_loss_clone_euclidean(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
  */
 
 #include <stdbool.h>
@@ -22,6 +23,7 @@
 #include <tnn/tnn_macro.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
+#include <tnn/tnn_pstable.h>
 #include <tnn/tnn_loss.h>
 #include <tnn/tnn_loss_euclidean.h>
 
@@ -51,6 +53,7 @@ tnn_error tnn_loss_init_euclidean(tnn_loss *l, tnn_state *input1, tnn_state *inp
   l->randomize = &tnn_loss_randomize_euclidean;
   l->destroy = &tnn_loss_destroy_euclidean;
   l->debug = &tnn_loss_debug_euclidean;
+  l->clone = &tnn_loss_clone_euclidean;
 
   return TNN_ERROR_SUCCESS;
 }
@@ -143,3 +146,19 @@ tnn_error tnn_loss_debug_euclidean(tnn_loss *l){
   }
   return TNN_ERROR_SUCCESS;
 }
+
+tnn_error tnn_loss_clone_euclidean(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t){
+  tnn_state *input1, *input2, *output;
+  tnn_error ret;
+
+  //Routine check
+  if(l1->t != TNN_LOSS_TYPE_EUCLIDEAN){
+    return TNN_ERROR_LOSS_MISTYPE;
+  }
+
+  //Retrieve the inputs and output, and link them
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, l1->input1, &input1), ret);
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, l1->input2, &input2), ret);
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, l1->output, &output), ret);
+  return tnn_loss_init_euclidean(l2, input1, input2, output);
+}
@@ -8,11 +8,13 @@
  * tnn_error tnn_loss_fprop_euclidean(tnn_loss *l);
  * tnn_error tnn_loss_randomize_euclidean(tnn_loss *l, double k);
  * tnn_error tnn_loss_destroy_euclidean(tnn_loss *l);
+ * tnn_error tnn_loss_clone_euclidean(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
  */
 
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
+#include <tnn/tnn_pstable.h>
 #include <tnn/tnn_loss.h>
 
 #ifndef TNN_LOSS_EUCLIDEAN_H
@@ -25,5 +27,6 @@ tnn_error tnn_loss_fprop_euclidean(tnn_loss *l);
 tnn_error tnn_loss_randomize_euclidean(tnn_loss *l, double k);
 tnn_error tnn_loss_destroy_euclidean(tnn_loss *l);
 tnn_error tnn_loss_debug_euclidean(tnn_loss *l);
+tnn_error tnn_loss_clone_euclidean(tnn_loss *l1, tnn_loss *l2, tnn_pstable *t);
 
 #endif //TNN_LOSS_EUCLIDEAN_H
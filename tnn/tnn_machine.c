@@ -19,18 +19,112 @@
  * tnn_error tnn_machine_randomize(tnn_machine *m, double k);
  * tnn_error tnn_machine_destroy(tnn_machine *m);
  * tnn_error tnn_machine_debug(tnn_machine *m);
+ * tnn_error tnn_machine_export_c(tnn_machine *m, FILE *fp, const char *name);
+ * tnn_error tnn_machine_clone(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+ * tnn_error tnn_machine_replica(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+ * tnn_error tnn_machine_checkpoint(tnn_machine *m, size_t k);
+ * tnn_error tnn_machine_save(tnn_machine *m, const char *file);
+ * tnn_error tnn_machine_load(tnn_machine *m, const char *file);
  */
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdbool.h>
+#include <ctype.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_macro.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
 #include <tnn/tnn_module.h>
+#include <tnn/tnn_pstable.h>
 #include <tnn/tnn_machine.h>
+#include <tnn/tnn_module_linear.h>
+#include <tnn/tnn_module_bias.h>
+#include <tnn/tnn_module_sum.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_module_linear_int8.h>
 #include <tnn/utlist.h>
+#include <tnn/uthash.h>
+#include <tnn/utarray.h>
+
+//Index of an io state in the machine file
+typedef struct __STRUCT_tnn_machine_index{
+  tnn_state *key;
+  uint64_t i;
+  UT_hash_handle hh;
+} tnn_machine_index;
+
+//Next module in the sequence min, modules, mout
+static tnn_module *tnn_machine_module_next(tnn_machine *m, tnn_module *mod){
+  if(mod == &m->mout){
+    return NULL;
+  } else if(mod == &m->min){
+    return m->m != NULL ? m->m : &m->mout;
+  }
+  return mod->next != NULL ? mod->next : &m->mout;
+}
+
+//Previous module in the sequence min, modules, mout
+static tnn_module *tnn_machine_module_prev(tnn_machine *m, tnn_module *mod){
+  if(mod == &m->min){
+    return NULL;
+  } else if(mod == &m->mout){
+    return m->m != NULL ? m->m->prev : &m->min;
+  }
+  return mod == m->m ? &m->min : mod->prev;
+}
+
+//Back propagation by segments: recompute each segment from its checkpoint, then go backward through it
+static tnn_error tnn_machine_bprop_checkpoint(tnn_machine *m){
+  tnn_module *mod, *seg;
+  tnn_error ret;
+  size_t n, a, i, len;
+
+  //Number of modules and the start of the last segment
+  n = 0;
+  for(mod = &m->min; mod != NULL; mod = tnn_machine_module_next(m, mod)){
+    n = n + 1;
+  }
+  a = ((n - 1)/m->k)*m->k;
+  seg = &m->min;
+  for(i = 0; i < a; i = i + 1){
+    seg = tnn_machine_module_next(m, seg);
+  }
+
+  while(seg != NULL){
+    len = n - a < m->k ? n - a : m->k;
+
+    //Recompute the segment except for its last module, whose output is kept.
+    //The last segment wrote the slots most recently, so it needs no recomputation.
+    mod = seg;
+    for(i = 0; i + 1 < len; i = i + 1){
+      if(a + len < n){
+        TNN_MACRO_ERRORTEST(tnn_module_fprop(mod), ret);
+      }
+      mod = tnn_machine_module_next(m, mod);
+    }
+
+    //Backward through the segment
+    for(i = 0; i < len; i = i + 1){
+      TNN_MACRO_ERRORTEST(tnn_module_bprop(mod), ret);
+      mod = tnn_machine_module_prev(m, mod);
+    }
+
+    //Previous segment
+    if(a == 0){
+      break;
+    }
+    a = a - m->k;
+    for(i = 0; i < m->k; i = i + 1){
+      seg = tnn_machine_module_prev(m, seg);
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
 
 //Initialize the machine with designated input and output size
 tnn_error tnn_machine_init(tnn_machine *m, size_t ninput, size_t noutput){
@@ -53,6 +147,9 @@ tnn_error tnn_machine_init(tnn_machine *m, size_t ninput, size_t noutput){
   //Initialize the module lists
   m->m = NULL;
 
+  //No checkpointing
+  m->k = 1;
+
   //Allocate input and output
   TNN_MACRO_ERRORTEST(tnn_param_state_alloc(&m->io, m->sin),ret);
   TNN_MACRO_ERRORTEST(tnn_param_state_alloc(&m->io, m->sout),ret);
@@ -122,6 +219,11 @@ tnn_error tnn_machine_bprop(tnn_machine *m){
   tnn_module *mod;
   tnn_error ret;
 
+  //Recompute the segments if checkpointed
+  if(m->k > 1){
+    return tnn_machine_bprop_checkpoint(m);
+  }
+
   //backward from mout
   TNN_MACRO_ERRORTEST(tnn_module_bprop(&m->mout),ret);
 
@@ -307,3 +409,785 @@ tnn_error tnn_machine_debug(tnn_machine *m){
     return TNN_ERROR_SUCCESS;
   }
 }
+
+//Export the forward propagation of this machine as a standalone C source
+tnn_error tnn_machine_export_c(tnn_machine *m, FILE *fp, const char *name){
+  tnn_module *mod;
+  tnn_error ret;
+  size_t i, sin, sout;
+  const char *c;
+
+  //The name is used as a C identifier
+  if(name == NULL || name[0] == '\0' || isdigit((unsigned char)name[0])){
+    return TNN_ERROR_FAILURE;
+  }
+  for(c = name; *c != '\0'; c = c + 1){
+    if(!isalnum((unsigned char)*c) && *c != '_'){
+      return TNN_ERROR_FAILURE;
+    }
+  }
+
+  //Locate input and output
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(&m->io, m->sin, &sin), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(&m->io, m->sout, &sout), ret);
+
+  //Header and sizes
+  fprintf(fp, "/* %s: generated by tnn_machine_export_c\n", name);
+  fprintf(fp, " * Input size: %ld, output size: %ld, io size: %ld, parameter size: %ld\n",
+	  m->sin->size, m->sout->size, m->io.size, m->p.size);
+  fprintf(fp, " * Compile without floating-point contraction (e.g. -ffp-contract=off) to stay bit-identical.\n");
+  fprintf(fp, " */\n\n");
+  fprintf(fp, "#include <stddef.h>\n\n");
+  fprintf(fp, "#define ");
+  for(c = name; *c != '\0'; c = c + 1){
+    fputc(toupper((unsigned char)*c), fp);
+  }
+  fprintf(fp, "_NINPUT %ld\n", m->sin->size);
+  fprintf(fp, "#define ");
+  for(c = name; *c != '\0'; c = c + 1){
+    fputc(toupper((unsigned char)*c), fp);
+  }
+  fprintf(fp, "_NOUTPUT %ld\n", m->sout->size);
+  fprintf(fp, "#define ");
+  for(c = name; *c != '\0'; c = c + 1){
+    fputc(toupper((unsigned char)*c), fp);
+  }
+  fprintf(fp, "_NIO %ld\n\n", m->io.size);
+
+  //Weights (printed with enough digits to round-trip exactly)
+  fprintf(fp, "static const double %s_p[%ld] = {", name, m->p.size > 0 ? m->p.size : 1L);
+  for(i = 0; i < m->p.size; i = i + 1){
+    fprintf(fp, "%s%s%.17g", i == 0 ? "" : ",", i % 4 == 0 ? "\n  " : " ", gsl_vector_get(m->p.x, i));
+  }
+  if(m->p.size == 0){
+    fprintf(fp, "0.0");
+  }
+  fprintf(fp, "\n};\n\n");
+
+  //Forward propagation
+  fprintf(fp, "void %s_fprop(const double *input, double *output, double *io){\n", name);
+  fprintf(fp, "  {\n");
+  fprintf(fp, "    size_t i;\n");
+  fprintf(fp, "    for(i = 0; i < %ld; i = i + 1){\n", m->sin->size);
+  fprintf(fp, "      io[%ld + i] = input[i];\n", sin);
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
+  TNN_MACRO_ERRORTEST(tnn_module_exportc(&m->min, fp, name, &m->io, &m->p), ret);
+  DL_FOREACH(m->m, mod){
+    TNN_MACRO_ERRORTEST(tnn_module_exportc(mod, fp, name, &m->io, &m->p), ret);
+  }
+  TNN_MACRO_ERRORTEST(tnn_module_exportc(&m->mout, fp, name, &m->io, &m->p), ret);
+  fprintf(fp, "  {\n");
+  fprintf(fp, "    size_t i;\n");
+  fprintf(fp, "    for(i = 0; i < %ld; i = i + 1){\n", m->sout->size);
+  fprintf(fp, "      output[i] = io[%ld + i];\n", sout);
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
+  fprintf(fp, "}\n");
+
+  if(ferror(fp)){
+    return TNN_ERROR_FAILURE;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Clone the io states and modules of m1 to m2, allocating parameters in p (or sharing them if p is NULL)
+//On failure everything cloned so far is destroyed and m2 is left uninitialized (a given t keeps stale entries).
+static tnn_error tnn_machine_copy(tnn_machine *m1, tnn_machine *m2, tnn_param *p, tnn_pstable *t){
+  tnn_pstable table;
+  tnn_module *mel, *mod, *mtmp;
+  tnn_state *states, *sel, *stmp;
+  tnn_error ret;
+  bool min;
+
+  //Use a local table if none is given
+  if(t == NULL){
+    TNN_MACRO_ERRORTEST(tnn_pstable_init(&table), ret);
+    t = &table;
+  }
+
+  //Copy the io states
+  TNN_MACRO_ERRORTEST(tnn_param_init(&m2->io), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_init(&m2->p), ret);
+  m2->m = NULL;
+  m2->k = m1->k;
+  min = false;
+  if((ret = tnn_pstable_param_alloc(t, &m1->io, &m2->io)) != TNN_ERROR_SUCCESS ||
+     (ret = tnn_pstable_find(t, m1->sin, &m2->sin)) != TNN_ERROR_SUCCESS ||
+     (ret = tnn_pstable_find(t, m1->sout, &m2->sout)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+
+  //Clone the modules
+  if((ret = tnn_module_clone(&m1->min, &m2->min, p, t)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+  min = true;
+  DL_FOREACH(m1->m, mel){
+    mod = (tnn_module *)malloc(sizeof(tnn_module));
+    if(mod == NULL){
+      ret = TNN_ERROR_ALLOC;
+      goto fail;
+    }
+    if((ret = tnn_module_clone(mel, mod, p, t)) != TNN_ERROR_SUCCESS){
+      free(mod);
+      goto fail;
+    }
+    DL_APPEND(m2->m, mod);
+  }
+  if((ret = tnn_module_clone(&m1->mout, &m2->mout, p, t)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+
+  if(t == &table){
+    tnn_pstable_destroy(&table);
+  }
+
+  return TNN_ERROR_SUCCESS;
+
+ fail:
+  //Destroy the parameters, the modules cloned so far and the io states (as tnn_machine_destroy)
+  states = m2->io.states;
+  tnn_param_destroy(&m2->io);
+  tnn_param_destroy(&m2->p);
+  DL_FOREACH_SAFE(m2->m, mel, mtmp){
+    tnn_module_destroy(mel);
+    free(mel);
+  }
+  m2->m = NULL;
+  if(min == true){
+    tnn_module_destroy(&m2->min);
+  }
+  DL_FOREACH_SAFE(states, sel, stmp){
+    free(sel);
+  }
+  if(t == &table){
+    tnn_pstable_destroy(&table);
+  }
+  return ret;
+}
+
+//Clone m1 to m2, copying all the parameters and io states
+tnn_error tnn_machine_clone(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t){
+  return tnn_machine_copy(m1, m2, &m2->p, t);
+}
+
+//Make m2 a replica of m1 that shares the parameters of m1
+tnn_error tnn_machine_replica(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t){
+  return tnn_machine_copy(m1, m2, NULL, t);
+}
+
+//Checkpoint the machine with segments of k modules
+tnn_error tnn_machine_checkpoint(tnn_machine *m, size_t k){
+  tnn_module *mod;
+  tnn_state *s, **states, **slots, **slotof;
+  gsl_vector *x, *dx, *oldx, *olddx;
+  tnn_param io;
+  size_t n, ns, i, j, size;
+  bool updated;
+  tnn_error ret;
+
+  //Routine check
+  if(m->k > 1){
+    return TNN_ERROR_MACHINE_CHECKPOINT;
+  }
+
+  //Check the chain and count the modules
+  if(m->min.input != m->sin || m->mout.output != m->sout){
+    return TNN_ERROR_MACHINE_NCHAIN;
+  }
+  n = 0;
+  for(mod = &m->min; mod != NULL; mod = tnn_machine_module_next(m, mod)){
+    if(tnn_machine_module_next(m, mod) != NULL && tnn_machine_module_next(m, mod)->input != mod->output){
+      return TNN_ERROR_MACHINE_NCHAIN;
+    }
+    n = n + 1;
+  }
+
+  //Segment length
+  if(k == 0){
+    for(k = 1; k*k < n; k = k + 1);
+  }
+  if(k <= 1 || n <= 2){
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Collect the io states
+  ns = 0;
+  DL_FOREACH(m->io.states, s){
+    ns = ns + 1;
+  }
+  states = (tnn_state **)malloc(ns*sizeof(tnn_state *));
+  slotof = (tnn_state **)calloc(ns, sizeof(tnn_state *));
+  slots = (tnn_state **)calloc(k - 1, sizeof(tnn_state *));
+  oldx = (gsl_vector *)malloc(ns*sizeof(gsl_vector));
+  olddx = (gsl_vector *)malloc(ns*sizeof(gsl_vector));
+  if(states == NULL || slotof == NULL || slots == NULL || oldx == NULL || olddx == NULL){
+    ret = TNN_ERROR_ALLOC;
+    goto cleanup;
+  }
+  i = 0;
+  DL_FOREACH(m->io.states, s){
+    states[i] = s;
+    oldx[i] = s->x;
+    olddx[i] = s->dx;
+    i = i + 1;
+  }
+
+  //Assign the non-checkpoint outputs to slots by their position in the segment
+  j = 0;
+  for(mod = &m->min; mod != &m->mout; mod = tnn_machine_module_next(m, mod)){
+    if(j % k != k - 1 && mod->output->parent == NULL){
+      for(i = 0; i < ns; i = i + 1){
+	if(states[i] == mod->output){
+	  break;
+	}
+      }
+      if(i == ns){
+	ret = TNN_ERROR_PARAM_NEXIST;
+	goto cleanup;
+      }
+      if(slots[j % k] == NULL){
+	if((slots[j % k] = (tnn_state *)malloc(sizeof(tnn_state))) == NULL){
+	  ret = TNN_ERROR_ALLOC;
+	  goto cleanup;
+	}
+	tnn_state_init(slots[j % k], 0L);
+      }
+      if(slots[j % k]->size < mod->output->size){
+	slots[j % k]->size = mod->output->size;
+      }
+      slotof[i] = slots[j % k];
+    }
+    j = j + 1;
+  }
+
+  //Every sub-state must be placed in its parent, which must be an io state
+  for(i = 0; i < ns; i = i + 1){
+    if(states[i]->parent != NULL){
+      for(j = 0; j < ns && states[j] != states[i]->parent; j = j + 1);
+      if(j == ns){
+	ret = TNN_ERROR_PARAM_NEXIST;
+	goto cleanup;
+      }
+    }
+  }
+
+  //Reserve the new io: the kept top states and the slots
+  size = 0;
+  for(i = 0; i < ns; i = i + 1){
+    if(states[i]->parent == NULL && slotof[i] == NULL){
+      size = size + states[i]->size;
+    }
+  }
+  for(j = 0; j < k - 1; j = j + 1){
+    if(slots[j] != NULL){
+      size = size + slots[j]->size;
+    }
+  }
+  tnn_param_init(&io);
+  if((ret = tnn_param_reserve(&io, size)) != TNN_ERROR_SUCCESS){
+    goto cleanup;
+  }
+
+  //Detach the states, keeping the old vectors until the values are copied
+  //Nothing below can fail: the room is reserved and every parent is placed before its sub-states.
+  x = m->io.x;
+  dx = m->io.dx;
+  for(i = 0; i < ns; i = i + 1){
+    states[i]->valid = false;
+  }
+  m->io = io;
+
+  //Place the kept top states and the slots, then the slotted outputs and the other sub-states
+  for(i = 0; i < ns; i = i + 1){
+    if(states[i]->parent == NULL && slotof[i] == NULL){
+      tnn_param_state_alloc(&m->io, states[i]);
+    }
+  }
+  for(j = 0; j < k - 1; j = j + 1){
+    if(slots[j] != NULL){
+      tnn_param_state_alloc(&m->io, slots[j]);
+    }
+  }
+  for(i = 0; i < ns; i = i + 1){
+    if(slotof[i] != NULL){
+      tnn_param_state_sub(&m->io, slotof[i], states[i], 0L);
+    }
+  }
+  updated = true;
+  while(updated == true){
+    updated = false;
+    for(i = 0; i < ns; i = i + 1){
+      if(states[i]->valid == false && states[i]->parent->valid == true){
+	tnn_param_state_sub(&m->io, states[i]->parent, states[i], states[i]->offset);
+	updated = true;
+      }
+    }
+  }
+
+  //Copy the values of the kept states
+  for(i = 0; i < ns; i = i + 1){
+    if(slotof[i] == NULL && states[i]->parent == NULL){
+      gsl_vector_memcpy(&states[i]->x, &oldx[i]);
+      gsl_vector_memcpy(&states[i]->dx, &olddx[i]);
+    }
+  }
+  if(x != NULL){
+    gsl_vector_free(x);
+    gsl_vector_free(dx);
+  }
+  m->k = k;
+  ret = TNN_ERROR_SUCCESS;
+
+ cleanup:
+  //The slots are in io once placed and will be freed with the machine
+  if(ret != TNN_ERROR_SUCCESS && slots != NULL){
+    for(j = 0; j < k - 1; j = j + 1){
+      free(slots[j]);
+    }
+  }
+  free(states);
+  free(slotof);
+  free(slots);
+  free(oldx);
+  free(olddx);
+  return ret;
+}
+
+//Index of state s in the machine file (TNN_MACHINE_FILE_NSTATE if it is not an io state)
+static uint64_t tnn_machine_index_find(tnn_machine_index *index, tnn_state *s){
+  tnn_machine_index *el;
+
+  if(s == NULL){
+    return TNN_MACHINE_FILE_NSTATE;
+  }
+  HASH_FIND_PTR(index, &s, el);
+  return el != NULL ? el->i : TNN_MACHINE_FILE_NSTATE;
+}
+
+//Write the record of a module, its type data and its weights
+static tnn_error tnn_machine_save_module(tnn_machine *m, tnn_module *mod, tnn_machine_index *index, FILE *fp){
+  tnn_module_linear_int8 *c;
+  tnn_state **t;
+  uint64_t r[6], k;
+  size_t i, off;
+
+  r[0] = (uint64_t)mod->t;
+  r[1] = tnn_machine_index_find(index, mod->input);
+  r[2] = tnn_machine_index_find(index, mod->output);
+  r[3] = mod->w.valid == true ? mod->w.size : 0;
+  r[4] = 0;
+  r[5] = 0;
+  if(r[2] == TNN_MACHINE_FILE_NSTATE || (mod->input != NULL && r[1] == TNN_MACHINE_FILE_NSTATE)){
+    return TNN_ERROR_PARAM_NEXIST;
+  }
+  if(r[3] > 0 && tnn_param_state_offset(&m->p, &mod->w, &off) != TNN_ERROR_SUCCESS){
+    return TNN_ERROR_PARAM_INCOMP;
+  }
+
+  //Type constants
+  switch(mod->t){
+  case TNN_MODULE_TYPE_LINEAR:
+  case TNN_MODULE_TYPE_BIAS:
+    break;
+  case TNN_MODULE_TYPE_SUM:
+    r[4] = utarray_len(((tnn_module_sum*)mod->c)->sarray);
+    break;
+  case TNN_MODULE_TYPE_LINEAR_SPARSE:
+    r[4] = ((tnn_module_linear_sparse*)mod->c)->ninput;
+    break;
+  case TNN_MODULE_TYPE_LINEAR_INT8:
+    r[4] = ((tnn_module_linear_int8*)mod->c)->ninput;
+    r[5] = ((tnn_module_linear_int8*)mod->c)->noutput;
+    break;
+  default:
+    return TNN_ERROR_MODULE_FUNCNDEF;
+  }
+  if(fwrite(r, sizeof(uint64_t), 6, fp) != 6){
+    return TNN_ERROR_FILE;
+  }
+
+  //Type data
+  if(mod->t == TNN_MODULE_TYPE_SUM){
+    for(t = (tnn_state **)utarray_front(((tnn_module_sum*)mod->c)->sarray);
+	t != NULL;
+	t = (tnn_state **)utarray_next(((tnn_module_sum*)mod->c)->sarray, t)){
+      k = tnn_machine_index_find(index, *t);
+      if(fwrite(&k, sizeof(uint64_t), 1, fp) != 1){
+	return TNN_ERROR_FILE;
+      }
+    }
+  } else if(mod->t == TNN_MODULE_TYPE_LINEAR_INT8){
+    c = (tnn_module_linear_int8 *) mod->c;
+    if(fwrite(&c->sx, sizeof(double), 1, fp) != 1 || fwrite(c->scale, sizeof(double), c->noutput, fp) != c->noutput){
+      return TNN_ERROR_FILE;
+    }
+    for(i = 0; i < c->noutput; i = i + 1){
+      if(fwrite(c->w + i*c->stride, sizeof(int8_t), c->ninput, fp) != c->ninput){
+	return TNN_ERROR_FILE;
+      }
+    }
+  }
+
+  //Weights (a top state of p, so contiguous)
+  if(r[3] > 0 && fwrite(mod->w.x.data, sizeof(double), r[3], fp) != r[3]){
+    return TNN_ERROR_FILE;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Write the machine file
+static tnn_error tnn_machine_save_file(tnn_machine *m, tnn_machine_index *index, uint64_t *table, size_t n, FILE *fp){
+  tnn_machine_header h;
+  tnn_module *mod;
+  tnn_state **t;
+  tnn_error ret;
+  size_t i, psize, nmod;
+
+  //Sub-states made by sum modules are created again by them
+  psize = 0;
+  nmod = 0;
+  for(mod = &m->min; mod != NULL; mod = tnn_machine_module_next(m, mod)){
+    if(mod->t == TNN_MODULE_TYPE_SUM){
+      for(t = (tnn_state **)utarray_front(((tnn_module_sum*)mod->c)->sarray);
+	  t != NULL;
+	  t = (tnn_state **)utarray_next(((tnn_module_sum*)mod->c)->sarray, t)){
+	if((i = tnn_machine_index_find(index, *t)) == TNN_MACHINE_FILE_NSTATE){
+	  return TNN_ERROR_PARAM_NEXIST;
+	}
+	table[4*i] = TNN_MACHINE_FILE_STATE_MODULE;
+      }
+    }
+    psize = psize + (mod->w.valid == true ? mod->w.size : 0);
+    nmod = nmod + 1;
+  }
+
+  //Other sub-states are created before the modules
+  for(i = 0; i < n; i = i + 1){
+    if(table[4*i] == TNN_MACHINE_FILE_STATE_SUB && table[4*table[4*i + 2]] == TNN_MACHINE_FILE_STATE_MODULE){
+      return TNN_ERROR_PARAM_INCOMP;
+    }
+  }
+  if(psize != m->p.size){
+    return TNN_ERROR_PARAM_INCOMP;
+  }
+
+  memcpy(h.magic, TNN_MACHINE_FILE_MAGIC, 8);
+  h.version = TNN_MACHINE_FILE_VERSION;
+  h.endian = TNN_MACHINE_FILE_ENDIAN;
+  h.dsize = sizeof(double);
+  h.nstates = n;
+  h.iosize = m->io.size;
+  h.psize = psize;
+  h.nmod = nmod;
+  h.sin = tnn_machine_index_find(index, m->sin);
+  h.sout = tnn_machine_index_find(index, m->sout);
+  h.k = m->k;
+  if(fwrite(&h, sizeof(tnn_machine_header), 1, fp) != 1 || fwrite(table, sizeof(uint64_t), 4*n, fp) != 4*n){
+    return TNN_ERROR_FILE;
+  }
+  for(mod = &m->min; mod != NULL; mod = tnn_machine_module_next(m, mod)){
+    TNN_MACRO_ERRORTEST(tnn_machine_save_module(m, mod, index, fp), ret);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Save the topology and parameters of the machine
+tnn_error tnn_machine_save(tnn_machine *m, const char *file){
+  tnn_machine_index *index, *el, *tmp;
+  tnn_state *s;
+  uint64_t *table;
+  size_t n, i;
+  FILE *fp;
+  tnn_error ret;
+
+  //Number the io states
+  index = NULL;
+  n = 0;
+  ret = TNN_ERROR_SUCCESS;
+  DL_FOREACH(m->io.states, s){
+    if((el = (tnn_machine_index *)malloc(sizeof(tnn_machine_index))) == NULL){
+      ret = TNN_ERROR_ALLOC;
+      break;
+    }
+    el->key = s;
+    el->i = n;
+    HASH_ADD_PTR(index, key, el);
+    n = n + 1;
+  }
+
+  //State table
+  table = (uint64_t *)malloc((4*n + 1)*sizeof(uint64_t));
+  if(table == NULL && ret == TNN_ERROR_SUCCESS){
+    ret = TNN_ERROR_ALLOC;
+  }
+  i = 0;
+  DL_FOREACH(m->io.states, s){
+    if(ret != TNN_ERROR_SUCCESS){
+      break;
+    }
+    table[4*i] = s->parent == NULL ? TNN_MACHINE_FILE_STATE_TOP : TNN_MACHINE_FILE_STATE_SUB;
+    table[4*i + 1] = s->size;
+    table[4*i + 2] = tnn_machine_index_find(index, s->parent);
+    table[4*i + 3] = s->parent == NULL ? 0 : s->offset;
+    if(s->parent != NULL && table[4*i + 2] == TNN_MACHINE_FILE_NSTATE){
+      ret = TNN_ERROR_PARAM_NEXIST;
+    }
+    i = i + 1;
+  }
+
+  if(ret == TNN_ERROR_SUCCESS){
+    if((fp = fopen(file, "wb")) == NULL){
+      ret = TNN_ERROR_FILE;
+    } else {
+      ret = tnn_machine_save_file(m, index, table, n, fp);
+      if(fclose(fp) != 0 && ret == TNN_ERROR_SUCCESS){
+	ret = TNN_ERROR_FILE;
+      }
+    }
+  }
+
+  HASH_ITER(hh, index, el, tmp){
+    HASH_DEL(index, el);
+    free(el);
+  }
+  free(table);
+  return ret;
+}
+
+//State number i of the machine file, or NULL
+static tnn_state *tnn_machine_load_state(tnn_state **states, size_t n, uint64_t i){
+  return i < n ? states[i] : NULL;
+}
+
+//Build a module from its record
+static tnn_error tnn_machine_load_module(tnn_machine *m, tnn_module *mod, tnn_state **states, uint64_t *table,
+					 size_t n, FILE *fp){
+  tnn_module_linear_int8 *c;
+  tnn_state *in, *out, **t;
+  tnn_error ret;
+  uint64_t r[6], k;
+  size_t i;
+
+  if(fread(r, sizeof(uint64_t), 6, fp) != 6){
+    return TNN_ERROR_FILE;
+  }
+  in = tnn_machine_load_state(states, n, r[1]);
+  out = tnn_machine_load_state(states, n, r[2]);
+  if(out == NULL || (r[0] != TNN_MODULE_TYPE_LINEAR_SPARSE && in == NULL)){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  //Initialize by type, allocating in the reserved io and p
+  switch(r[0]){
+  case TNN_MODULE_TYPE_LINEAR:
+    TNN_MACRO_ERRORTEST(tnn_module_init_linear(mod, in, out, &m->p), ret);
+    break;
+  case TNN_MODULE_TYPE_BIAS:
+    TNN_MACRO_ERRORTEST(tnn_module_init_bias(mod, in, out, &m->p), ret);
+    break;
+  case TNN_MODULE_TYPE_SUM:
+    TNN_MACRO_ERRORTEST(tnn_module_init_sum(mod, in, out, &m->io), ret);
+    if(utarray_len(((tnn_module_sum*)mod->c)->sarray) != r[4]){
+      return TNN_ERROR_FILE_FORMAT;
+    }
+    for(t = (tnn_state **)utarray_front(((tnn_module_sum*)mod->c)->sarray);
+	t != NULL;
+	t = (tnn_state **)utarray_next(((tnn_module_sum*)mod->c)->sarray, t)){
+      if(fread(&k, sizeof(uint64_t), 1, fp) != 1){
+	return TNN_ERROR_FILE;
+      }
+      if(k >= n || table[4*k] != TNN_MACHINE_FILE_STATE_MODULE || states[k] != NULL || table[4*k + 1] != (*t)->size){
+	return TNN_ERROR_FILE_FORMAT;
+      }
+      states[k] = *t;
+    }
+    break;
+  case TNN_MODULE_TYPE_LINEAR_SPARSE:
+    TNN_MACRO_ERRORTEST(tnn_module_init_linear_sparse(mod, r[4], out, &m->p), ret);
+    break;
+  case TNN_MODULE_TYPE_LINEAR_INT8:
+    if(r[4] != in->size || r[5] != out->size){
+      return TNN_ERROR_FILE_FORMAT;
+    }
+    TNN_MACRO_ERRORTEST(tnn_module_init_linear(mod, in, out, &m->p), ret);
+    TNN_MACRO_ERRORTEST(tnn_module_linear_int8_alloc(mod, in->size, out->size), ret);
+    c = (tnn_module_linear_int8 *) mod->c;
+    if(fread(&c->sx, sizeof(double), 1, fp) != 1 || fread(c->scale, sizeof(double), c->noutput, fp) != c->noutput){
+      return TNN_ERROR_FILE;
+    }
+    for(i = 0; i < c->noutput; i = i + 1){
+      if(fread(c->w + i*c->stride, sizeof(int8_t), c->ninput, fp) != c->ninput){
+	return TNN_ERROR_FILE;
+      }
+    }
+    break;
+  default:
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  //Weights
+  if(r[3] != (mod->w.valid == true ? mod->w.size : 0)){
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  if(r[3] > 0 && fread(mod->w.x.data, sizeof(double), r[3], fp) != r[3]){
+    return TNN_ERROR_FILE;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Build the machine from the file after the state table
+//On failure everything built so far is destroyed, as in tnn_machine_copy. A module is linked before it is
+//loaded with no destroy method, so one that failed part way is destroyed if its init completed, and only
+//after the parameters, whose lists hold its weight state.
+static tnn_error tnn_machine_load_file(tnn_machine *m, tnn_machine_header *h, tnn_state **states, uint64_t *table,
+				       FILE *fp){
+  tnn_module *mod, *mel, *mtmp;
+  tnn_state *s, *io, *sel, *stmp;
+  tnn_error ret;
+  size_t i, n;
+
+  //Reserve io and p at their final sizes
+  n = h->nstates;
+  TNN_MACRO_ERRORTEST(tnn_param_init(&m->io), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_init(&m->p), ret);
+  m->m = NULL;
+  m->k = h->k;
+  m->min.destroy = NULL;
+  m->mout.destroy = NULL;
+  if((ret = tnn_param_reserve(&m->io, h->iosize)) != TNN_ERROR_SUCCESS
+     || (ret = tnn_param_reserve(&m->p, h->psize)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+
+  //Top states in order, then sub-states of earlier states
+  for(i = 0; i < n; i = i + 1){
+    if(table[4*i] == TNN_MACHINE_FILE_STATE_TOP){
+      if((s = (tnn_state *)malloc(sizeof(tnn_state))) == NULL){
+	ret = TNN_ERROR_ALLOC;
+	goto fail;
+      }
+      if((ret = tnn_state_init(s, table[4*i + 1])) != TNN_ERROR_SUCCESS
+	 || (ret = tnn_param_state_alloc(&m->io, s)) != TNN_ERROR_SUCCESS){
+	free(s);
+	goto fail;
+      }
+      states[i] = s;
+    } else if(table[4*i] != TNN_MACHINE_FILE_STATE_SUB && table[4*i] != TNN_MACHINE_FILE_STATE_MODULE){
+      ret = TNN_ERROR_FILE_FORMAT;
+      goto fail;
+    }
+  }
+  for(i = 0; i < n; i = i + 1){
+    if(table[4*i] == TNN_MACHINE_FILE_STATE_SUB){
+      if(table[4*i + 2] >= i || states[table[4*i + 2]] == NULL
+	 || table[4*i + 3] + table[4*i + 1] > states[table[4*i + 2]]->size){
+	ret = TNN_ERROR_FILE_FORMAT;
+	goto fail;
+      }
+      if((s = (tnn_state *)malloc(sizeof(tnn_state))) == NULL){
+	ret = TNN_ERROR_ALLOC;
+	goto fail;
+      }
+      if((ret = tnn_state_init(s, table[4*i + 1])) != TNN_ERROR_SUCCESS
+	 || (ret = tnn_param_state_sub(&m->io, states[table[4*i + 2]], s, table[4*i + 3])) != TNN_ERROR_SUCCESS){
+	free(s);
+	goto fail;
+      }
+      states[i] = s;
+    }
+  }
+  if(m->io.size != h->iosize || (m->sin = tnn_machine_load_state(states, n, h->sin)) == NULL
+     || (m->sout = tnn_machine_load_state(states, n, h->sout)) == NULL){
+    ret = TNN_ERROR_FILE_FORMAT;
+    goto fail;
+  }
+
+  //Modules in order
+  if((ret = tnn_machine_load_module(m, &m->min, states, table, n, fp)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+  for(i = 1; i + 1 < h->nmod; i = i + 1){
+    if((mod = (tnn_module *)malloc(sizeof(tnn_module))) == NULL){
+      ret = TNN_ERROR_ALLOC;
+      goto fail;
+    }
+    mod->destroy = NULL;
+    DL_APPEND(m->m, mod);
+    if((ret = tnn_machine_load_module(m, mod, states, table, n, fp)) != TNN_ERROR_SUCCESS){
+      goto fail;
+    }
+  }
+  if((ret = tnn_machine_load_module(m, &m->mout, states, table, n, fp)) != TNN_ERROR_SUCCESS){
+    goto fail;
+  }
+  if(m->p.size != h->psize){
+    ret = TNN_ERROR_FILE_FORMAT;
+    goto fail;
+  }
+
+  return TNN_ERROR_SUCCESS;
+
+ fail:
+  //Destroy the parameters, the modules loaded so far and the io states, including those of sum modules
+  io = m->io.states;
+  tnn_param_destroy(&m->io);
+  tnn_param_destroy(&m->p);
+  DL_FOREACH_SAFE(m->m, mel, mtmp){
+    tnn_module_destroy(mel);
+    free(mel);
+  }
+  m->m = NULL;
+  tnn_module_destroy(&m->min);
+  tnn_module_destroy(&m->mout);
+  DL_FOREACH_SAFE(io, sel, stmp){
+    free(sel);
+  }
+  return ret;
+}
+
+//Build an uninitialized machine from a file written by tnn_machine_save
+tnn_error tnn_machine_load(tnn_machine *m, const char *file){
+  tnn_machine_header h;
+  tnn_state **states;
+  uint64_t *table;
+  FILE *fp;
+  tnn_error ret;
+
+  if((fp = fopen(file, "rb")) == NULL){
+    return TNN_ERROR_FILE;
+  }
+
+  //Check the header
+  if(fread(&h, sizeof(tnn_machine_header), 1, fp) != 1){
+    fclose(fp);
+    return TNN_ERROR_FILE;
+  }
+  if(memcmp(h.magic, TNN_MACHINE_FILE_MAGIC, 8) != 0 || h.version != TNN_MACHINE_FILE_VERSION
+     || h.endian != TNN_MACHINE_FILE_ENDIAN || h.dsize != sizeof(double) || h.nmod < 2 || h.k == 0
+     || h.sin >= h.nstates || h.sout >= h.nstates || h.nstates > SIZE_MAX/(4*sizeof(uint64_t))){
+    fclose(fp);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+
+  //Read the state table and build
+  table = (uint64_t *)malloc(4*h.nstates*sizeof(uint64_t));
+  states = (tnn_state **)calloc(h.nstates, sizeof(tnn_state *));
+  if(table == NULL || states == NULL){
+    ret = TNN_ERROR_ALLOC;
+  } else if(fread(table, sizeof(uint64_t), 4*h.nstates, fp) != 4*h.nstates){
+    ret = TNN_ERROR_FILE;
+  } else {
+    ret = tnn_machine_load_file(m, &h, states, table, fp);
+  }
+
+  free(table);
+  free(states);
+  fclose(fp);
+  return ret;
+}
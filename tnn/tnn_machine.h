@@ -4,7 +4,9 @@
  *
  * This header defines the following structure:
  * tnn_machine(tnn_state sin, tnn_state sout, tnn_param io, tnn_module *m, tnn_param p,
- *             tnn_module min, tnn_module mout)
+ *             tnn_module min, tnn_module mout, size_t k)
+ * tnn_machine_header(char magic[8], uint32_t version, uint32_t endian, uint64_t dsize, uint64_t nstates,
+ *                    uint64_t iosize, uint64_t psize, uint64_t nmod, uint64_t sin, uint64_t sout, uint64_t k)
  *
  * This header defines the following functions:
  * tnn_error tnn_machine_init(tnn_machine *m, size_t ninput, size_t noutput);
@@ -23,13 +25,22 @@
  * tnn_error tnn_machine_randomize(tnn_machine *m, double k);
  * tnn_error tnn_machine_destroy(tnn_machine *m);
  * tnn_error tnn_machine_debug(tnn_machine *m);
+ * tnn_error tnn_machine_export_c(tnn_machine *m, FILE *fp, const char *name);
+ * tnn_error tnn_machine_clone(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+ * tnn_error tnn_machine_replica(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+ * tnn_error tnn_machine_checkpoint(tnn_machine *m, size_t k);
+ * tnn_error tnn_machine_save(tnn_machine *m, const char *file);
+ * tnn_error tnn_machine_load(tnn_machine *m, const char *file);
  */
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
 #include <tnn/tnn_module.h>
+#include <tnn/tnn_pstable.h>
 #include <tnn/utlist.h>
 
 #ifndef TNN_MACHINE_H
@@ -40,6 +51,20 @@
 #define DL_FOREACH_BACKWARD(head, el) \
   for(el=(head? head->prev : 0L); el; el=(el==head ? 0L : el->prev))
 
+//Machine file format: header, io state table of (kind, size, parent, offset), then for each module in order from
+//min to mout a record of (type, input, output, wsize, n1, n2), all as uint64, followed by the data of its type
+//and its wsize weights. States are referred to by their index in the table.
+#define TNN_MACHINE_FILE_MAGIC "TNNMACH1"
+#define TNN_MACHINE_FILE_VERSION 1
+#define TNN_MACHINE_FILE_ENDIAN 0x01020304
+
+//Kinds of io states in the machine file: allocated, sub-state of an earlier one, or created by a module
+#define TNN_MACHINE_FILE_STATE_TOP 0
+#define TNN_MACHINE_FILE_STATE_SUB 1
+#define TNN_MACHINE_FILE_STATE_MODULE 2
+//Index of a missing state
+#define TNN_MACHINE_FILE_NSTATE UINT64_MAX
+
 //The structure
 typedef struct __STRUCT_tnn_machine{
   //Input state: make min use it!
@@ -57,8 +82,33 @@ typedef struct __STRUCT_tnn_machine{
   tnn_module min;
   //Output module
   tnn_module mout;
+  //Checkpoint segment length: only every k-th module output is kept (1 keeps all of them)
+  size_t k;
 } tnn_machine;
 
+//Machine file header
+typedef struct __STRUCT_tnn_machine_header{
+  //Magic string TNN_MACHINE_FILE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_MACHINE_FILE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Size of a value in bytes
+  uint64_t dsize;
+  //Number of io states, and sizes of io and p
+  uint64_t nstates;
+  uint64_t iosize;
+  uint64_t psize;
+  //Number of modules, including min and mout
+  uint64_t nmod;
+  //Indices of the input and output states
+  uint64_t sin;
+  uint64_t sout;
+  //Checkpoint segment length
+  uint64_t k;
+} tnn_machine_header;
+
 //Initialize the machine with designated input and output size
 tnn_error tnn_machine_init(tnn_machine *m, size_t ninput, size_t noutput);
 
@@ -109,4 +159,38 @@ tnn_error tnn_machine_destroy(tnn_machine *m);
 //Run debug for all of the components.
 tnn_error tnn_machine_debug(tnn_machine *m);
 
+//Export the forward propagation of this machine as a standalone C source
+//The source defines <name>_fprop(const double *input, double *output, double *io), where io is a
+//work array of <NAME>_NIO doubles. Weights are embedded as constants and all the sizes are fixed,
+//so the result is bit-identical to tnn_machine_fprop on targets without fused multiply-add.
+tnn_error tnn_machine_export_c(tnn_machine *m, FILE *fp, const char *name);
+
+//Clone m1 to an uninitialized m2, copying all the parameters and io states
+//If t is not NULL, it must be initialized and receives the map from io states of m1 to those of m2.
+tnn_error tnn_machine_clone(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+
+//Make an uninitialized m2 a replica of m1: m2 owns copies of the io states but its modules
+//share the parameter states of m1, so any number of replicas cost only their activations.
+//Replicas can run fprop concurrently with each other. They must not run bprop (the gradients are shared)
+//and they become invalid once m1's parameter is reallocated or m1 is destroyed.
+//If t is not NULL, it must be initialized and receives the map from io states of m1 to those of m2.
+tnn_error tnn_machine_replica(tnn_machine *m1, tnn_machine *m2, tnn_pstable *t);
+
+//Checkpoint the machine with segments of k modules (k = 0 picks about the square root of the number of modules)
+//Only the output of the last module of each segment keeps its own storage in io. The other module outputs share
+//k-1 slots, and bprop recomputes each segment from its input checkpoint before propagating through it.
+//The modules must form a chain from sin to sout, and intermediate outputs must not be used outside of it.
+//The io states are reallocated (values of the kept states are preserved). This can only be done once.
+tnn_error tnn_machine_checkpoint(tnn_machine *m, size_t k);
+
+//Save the topology and parameters of the machine: its io states, module types and constants, and weights
+//Linear, bias, sum, sparse linear and int8 linear modules are supported. The weights of the modules must
+//make up all of p (a replica cannot be saved).
+tnn_error tnn_machine_save(tnn_machine *m, const char *file);
+
+//Build an uninitialized machine from a file written by tnn_machine_save
+//io and p are reserved at their final sizes first, so every state is placed without reallocation.
+//On failure nothing is left allocated and the machine stays uninitialized.
+tnn_error tnn_machine_load(tnn_machine *m, const char *file);
+
 #endif //TNN_MACHINE_H
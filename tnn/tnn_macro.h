@@ -5,6 +5,7 @@
  * This header defines the following macros:
  * TNN_MACRO_ERRORTEST
  * TNN_MACRO_GSLTEST
+ * TNN_MACRO_PREFETCH
  */
 
 #ifndef TNN_MACRO_H
@@ -20,4 +21,12 @@
     return TNN_ERROR_GSL;			\
   }
 
+//Software prefetch of the cache line at addr for reading (no-op without GCC builtins)
+#define TNN_MACRO_CACHE_LINE 64
+#if defined(__GNUC__)
+#define TNN_MACRO_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#else
+#define TNN_MACRO_PREFETCH(addr) ((void)(addr))
+#endif
+
 #endif //TNN_MACRO_H
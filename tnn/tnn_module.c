@@ -9,6 +9,7 @@
  * tnn_error tnn_module_destroy(tnn_module *m);
  * tnn_error tnn_module_debug(tnn_module *m);
  * tnn_error tnn_module_clone(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_exportc(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
 #include <tnn/tnn_error.h>
@@ -48,6 +49,7 @@ tnn_error tnn_module_destroy(tnn_module *m){
 }
 
 //Polymorphic clone method: clone m1 to m2, using p to allocate parameters, and use t to retrieve input/output.
+//If p is NULL, m2 shares the parameter states of m1 instead of copying them.
 tnn_error tnn_module_clone(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t){
   if(m1->clone != NULL){
     return (*m1->clone)(m1, m2, p, t);
@@ -55,6 +57,14 @@ tnn_error tnn_module_clone(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pst
   return TNN_ERROR_MODULE_FUNCNDEF;
 }
 
+//Polymorphic C code export method
+tnn_error tnn_module_exportc(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p){
+  if(m->exportc != NULL){
+    return (*m->exportc)(m, fp, name, io, p);
+  }
+  return TNN_ERROR_MODULE_FUNCNDEF;
+}
+
 //Polymorphic debug helper
 tnn_error tnn_module_debug(tnn_module *m){
   tnn_error ret;
@@ -8,7 +8,8 @@
  *            TNN_MODULE_FUNC_FPROP fprop,
  *            TNN_MODULE_FUNC_RANDOMIZE randomize,
  *            TNN_MODULE_FUNC_DESTROY destroy,
- *            TNN_MODULE_FUNC_CLONE clone,)
+ *            TNN_MODULE_FUNC_CLONE clone,
+ *            TNN_MODULE_FUNC_EXPORTC exportc)
  *
  * This header defines the following functions:
  * tnn_error tnn_module_bprop(tnn_module *m);
@@ -17,8 +18,10 @@
  * tnn_error tnn_module_destroy(tnn_module *m);
  * tnn_error tnn_module_debug(tnn_module *m);
  * tnn_error tnn_module_clone(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_exportc(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
+#include <stdio.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
@@ -39,6 +42,8 @@ typedef enum __ENUM_tnn_module_type{
   TNN_MODULE_TYPE_BRANCH, //Branch module
   TNN_MODULE_TYPE_CONV1, //1-D convolutional module
   TNN_MODULE_TYPE_CONV2, //2-D convolutional module
+  TNN_MODULE_TYPE_LINEAR_SPARSE, //Linear module with sparse input
+  TNN_MODULE_TYPE_LINEAR_INT8, //Linear module with int8 weights (inference only)
 
   TNN_MODULE_TYPE_SIZE //Size indicator (if you want to define your own polymorph-safe module, do it above this size.)
 } tnn_module_type;
@@ -51,6 +56,7 @@ typedef tnn_error (*TNN_MODULE_FUNC_RANDOMIZE) (struct __STRUCT_tnn_module *modu
 typedef tnn_error (*TNN_MODULE_FUNC_DESTROY) (struct __STRUCT_tnn_module *module);
 typedef tnn_error (*TNN_MODULE_FUNC_DEBUG) (struct __STRUCT_tnn_module *module);
 typedef tnn_error (*TNN_MODULE_FUNC_CLONE) (struct __STRUCT_tnn_module *m1, struct __STRUCT_tnn_module *m2, tnn_param *p, tnn_pstable *t);
+typedef tnn_error (*TNN_MODULE_FUNC_EXPORTC) (struct __STRUCT_tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
 
 //The structure
 typedef struct __STRUCT_tnn_module{
@@ -76,6 +82,11 @@ typedef struct __STRUCT_tnn_module{
   TNN_MODULE_FUNC_DEBUG debug;
   //Clone method
   TNN_MODULE_FUNC_CLONE clone;
+  //C code export method
+  TNN_MODULE_FUNC_EXPORTC exportc;
+  //Original propagation methods while profiled (see tnn_profile.h)
+  TNN_MODULE_FUNC_BPROP pbprop;
+  TNN_MODULE_FUNC_FPROP pfprop;
 
   //UTList operation support
   struct __STRUCT_tnn_module *prev;
@@ -93,6 +104,10 @@ tnn_error tnn_module_destroy(tnn_module *m);
 //Polymorphic debug method
 tnn_error tnn_module_debug(tnn_module *m);
 //Polymorphic clone method: clone m1 to m2, using p to allocate parameters, and use t to retrieve input/output.
+//If p is NULL, m2 shares the parameter states of m1 instead of copying them.
 tnn_error tnn_module_clone(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+//Polymorphic C code export method: write the fprop of m as C statements over the arrays io and <name>_p.
+//io and p are the parameters holding the module's states and weights, used to compute offsets.
+tnn_error tnn_module_exportc(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
 
 #endif //TNN_MODULE_H
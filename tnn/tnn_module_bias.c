@@ -9,9 +9,11 @@
  * tnn_error tnn_module_randomize_bias(tnn_module *m, double k);
  * tnn_error tnn_module_destroy_bias(tnn_module *m);
  * tnn_error tnn_module_debug_bias(tnn_module *m);
+ * tnn_error tnn_module_exportc_bias(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
@@ -54,6 +56,7 @@ tnn_error tnn_module_init_bias(tnn_module *m, tnn_state *input, tnn_state *outpu
   m->destroy = &tnn_module_destroy_bias;
   m->clone = &tnn_module_clone_bias;
   m->debug = &tnn_module_debug_bias;
+  m->exportc = &tnn_module_exportc_bias;
 
   return TNN_ERROR_SUCCESS;
 }
@@ -142,9 +145,14 @@ tnn_error tnn_module_clone_bias(tnn_module *m1, tnn_module *m2, tnn_param *p, tn
   //No constant paramters
   m2->c = NULL;
   
-  //Allocate the parameter states
-  tnn_state_init(&m2->w, m2->input->size);
-  TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+  //Allocate the parameter states, or share those of m1 if p is NULL
+  if(p != NULL){
+    tnn_state_init(&m2->w, m2->input->size);
+    TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+    TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_state_share(&m1->w, &m2->w), ret);
+  }
 
   //Store the functions
   m2->bprop = &tnn_module_bprop_bias;
@@ -153,9 +161,32 @@ tnn_error tnn_module_clone_bias(tnn_module *m1, tnn_module *m2, tnn_param *p, tn
   m2->destroy = &tnn_module_destroy_bias;
   m2->debug = &tnn_module_debug_bias;
   m2->clone = &tnn_module_clone_bias;
+  m2->exportc = &tnn_module_exportc_bias;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_exportc_bias(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p){
+  tnn_error ret;
+  size_t in, out, w;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_BIAS){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
 
-  //Copy the state
-  TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  //Locate the states
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, m->input, &in), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, m->output, &out), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(p, &m->w, &w), ret);
+
+  fprintf(fp, "  //Module (bias): %ld\n", m->input->size);
+  fprintf(fp, "  {\n");
+  fprintf(fp, "    size_t i;\n");
+  fprintf(fp, "    for(i = 0; i < %ld; i = i + 1){\n", m->input->size);
+  fprintf(fp, "      io[%ld + i] = io[%ld + i] + %s_p[%ld + i];\n", out, in, name, w);
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
 
   return TNN_ERROR_SUCCESS;
 }
@@ -9,9 +9,11 @@
  * tnn_error tnn_module_randomize_linear(tnn_module *m, double k);
  * tnn_error tnn_module_destroy_linear(tnn_module *m);
  * tnn_error tnn_module_debug(tnn_module *m);
+ * tnn_error tnn_module_exportc_linear(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <time.h>
@@ -51,6 +53,7 @@ tnn_error tnn_module_init_linear(tnn_module *m, tnn_state *input, tnn_state *out
   m->destroy = &tnn_module_destroy_linear;
   m->debug = &tnn_module_debug_linear;
   m->clone = &tnn_module_clone_linear;
+  m->exportc = &tnn_module_exportc_linear;
 
   return TNN_ERROR_SUCCESS;
 }
@@ -153,9 +156,14 @@ tnn_error tnn_module_clone_linear(tnn_module *m1, tnn_module *m2, tnn_param *p,
   //No constant paramters
   m2->c = NULL;
   
-  //Allocate the parameter states
-  tnn_state_init(&m2->w, m2->input->size*m2->output->size);
-  TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+  //Allocate the parameter states, or share those of m1 if p is NULL
+  if(p != NULL){
+    tnn_state_init(&m2->w, m2->input->size*m2->output->size);
+    TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+    TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_state_share(&m1->w, &m2->w), ret);
+  }
 
   //Store the functions
   m2->bprop = &tnn_module_bprop_linear;
@@ -164,9 +172,38 @@ tnn_error tnn_module_clone_linear(tnn_module *m1, tnn_module *m2, tnn_param *p,
   m2->destroy = &tnn_module_destroy_linear;
   m2->debug = &tnn_module_debug_linear;
   m2->clone = &tnn_module_clone_linear;
+  m2->exportc = &tnn_module_exportc_linear;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_exportc_linear(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p){
+  tnn_error ret;
+  size_t in, out, w;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
 
-  //Copy the state
-  TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  //Locate the states
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, m->input, &in), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, m->output, &out), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(p, &m->w, &w), ret);
+
+  //Same summation order as the reference gsl_blas_dgemv
+  fprintf(fp, "  //Module (linear): %ld -> %ld\n", m->input->size, m->output->size);
+  fprintf(fp, "  {\n");
+  fprintf(fp, "    size_t i, j;\n");
+  fprintf(fp, "    double s;\n");
+  fprintf(fp, "    for(i = 0; i < %ld; i = i + 1){\n", m->output->size);
+  fprintf(fp, "      s = 0.0;\n");
+  fprintf(fp, "      for(j = 0; j < %ld; j = j + 1){\n", m->input->size);
+  fprintf(fp, "        s = s + io[%ld + j]*%s_p[%ld + i*%ld + j];\n", in, name, w, m->input->size);
+  fprintf(fp, "      }\n");
+  fprintf(fp, "      io[%ld + i] = s;\n", out);
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
 
   return TNN_ERROR_SUCCESS;
 }
@@ -10,8 +10,11 @@
  * tnn_error tnn_module_destroy_linear(tnn_module *m);
  * tnn_error tnn_module_clone_linear(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t)
  * tnn_error tnn_module_debug_linear(tnn_module *m);
+ * tnn_error tnn_module_exportc_linear(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
+#include <stdio.h>
+
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
@@ -29,5 +32,6 @@ tnn_error tnn_module_randomize_linear(tnn_module *m, double k);
 tnn_error tnn_module_destroy_linear(tnn_module *m);
 tnn_error tnn_module_debug_linear(tnn_module *m);
 tnn_error tnn_module_clone_linear(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+tnn_error tnn_module_exportc_linear(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
 
 #endif //TNN_MODULE_LINEAR_H
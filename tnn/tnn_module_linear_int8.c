@@ -0,0 +1,307 @@
+/* Thunder Neural Networks Module - Int8 Linear Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_module_quantize_linear(tnn_module *m, double xmax);
+ * tnn_error tnn_module_linear_int8_alloc(tnn_module *m, size_t ninput, size_t noutput);
+ * tnn_error tnn_module_fprop_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_destroy_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_clone_linear_int8(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_debug_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_linear_int8_simd(int *simd);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_numeric.h>
+#include <tnn/tnn_module_linear_int8.h>
+
+//The AVX2 kernel is compiled for x86 with GCC-compatible compilers and chosen at run time
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TNN_MODULE_LINEAR_INT8_X86 1
+#include <immintrin.h>
+#else
+#define TNN_MODULE_LINEAR_INT8_X86 0
+#endif
+
+//Scalar dot product of n int8 values
+static int32_t tnn_module_linear_int8_dot(const int8_t *a, const int8_t *b, size_t n){
+  int32_t s;
+  size_t i;
+
+  s = 0;
+  for(i = 0; i < n; i = i + 1){
+    s = s + (int32_t)a[i]*(int32_t)b[i];
+  }
+  return s;
+}
+
+#if TNN_MODULE_LINEAR_INT8_X86
+//AVX2 dot product of n int8 values: a and b are aligned and n is a multiple of TNN_MODULE_LINEAR_INT8_ALIGN
+//The values are widened to int16 and multiplied-added in pairs into int32, so no intermediate saturates.
+__attribute__((target("avx2")))
+static int32_t tnn_module_linear_int8_dot_avx2(const int8_t *a, const int8_t *b, size_t n){
+  __m256i s0, s1, va, vb;
+  __m128i s;
+  size_t i;
+
+  s0 = _mm256_setzero_si256();
+  s1 = _mm256_setzero_si256();
+  for(i = 0; i < n; i = i + 32){
+    va = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(a + i)));
+    vb = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + i)));
+    s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(va, vb));
+    va = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(a + i + 16)));
+    vb = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + i + 16)));
+    s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(va, vb));
+  }
+  s0 = _mm256_add_epi32(s0, s1);
+  s = _mm_add_epi32(_mm256_castsi256_si128(s0), _mm256_extracti128_si256(s0, 1));
+  s = _mm_hadd_epi32(s, s);
+  s = _mm_hadd_epi32(s, s);
+  return (int32_t)_mm_cvtsi128_si32(s);
+}
+#endif
+
+//Quantize a value with the inverse scale, rounding to nearest and saturating to [-127, 127]
+static int8_t tnn_module_linear_int8_round(double v, double inv){
+  v = v*inv;
+  if(v > 127.0){
+    v = 127.0;
+  } else if(v < -127.0){
+    v = -127.0;
+  }
+  return (int8_t)lround(v);
+}
+
+//Get whether the SIMD kernel is available on this processor
+tnn_error tnn_module_linear_int8_simd(int *simd){
+#if TNN_MODULE_LINEAR_INT8_X86
+  __builtin_cpu_init();
+  *simd = __builtin_cpu_supports("avx2") ? 1 : 0;
+#else
+  *simd = 0;
+#endif
+  return TNN_ERROR_SUCCESS;
+}
+
+//Allocate the int8 data of a module for a ninput to noutput product, and make it an int8 linear module
+tnn_error tnn_module_linear_int8_alloc(tnn_module *m, size_t ninput, size_t noutput){
+  tnn_module_linear_int8 *c;
+  void *w, *xq;
+
+  c = (tnn_module_linear_int8 *) malloc(sizeof(tnn_module_linear_int8));
+  if(c == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  c->ninput = ninput;
+  c->noutput = noutput;
+  c->stride = (ninput + TNN_MODULE_LINEAR_INT8_ALIGN - 1)/TNN_MODULE_LINEAR_INT8_ALIGN*TNN_MODULE_LINEAR_INT8_ALIGN;
+  if(c->stride == 0){
+    c->stride = TNN_MODULE_LINEAR_INT8_ALIGN;
+  }
+  c->sx = 1.0;
+  c->scale = (double *) malloc((noutput > 0 ? noutput : 1)*sizeof(double));
+  if(c->scale == NULL){
+    free(c);
+    return TNN_ERROR_ALLOC;
+  }
+  if(posix_memalign(&w, TNN_MODULE_LINEAR_INT8_ALIGN, (noutput > 0 ? noutput : 1)*c->stride) != 0){
+    free(c->scale);
+    free(c);
+    return TNN_ERROR_ALLOC;
+  }
+  if(posix_memalign(&xq, TNN_MODULE_LINEAR_INT8_ALIGN, c->stride) != 0){
+    free(w);
+    free(c->scale);
+    free(c);
+    return TNN_ERROR_ALLOC;
+  }
+  c->w = (int8_t *) w;
+  c->xq = (int8_t *) xq;
+  memset(c->w, 0, (noutput > 0 ? noutput : 1)*c->stride);
+  memset(c->xq, 0, c->stride);
+  tnn_module_linear_int8_simd(&c->simd);
+
+  //Defined type
+  m->t = TNN_MODULE_TYPE_LINEAR_INT8;
+  m->c = c;
+
+  //Store the functions
+  m->bprop = NULL;
+  m->fprop = &tnn_module_fprop_linear_int8;
+  m->randomize = NULL;
+  m->destroy = &tnn_module_destroy_linear_int8;
+  m->debug = &tnn_module_debug_linear_int8;
+  m->clone = &tnn_module_clone_linear_int8;
+  m->exportc = NULL;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Convert a linear module to int8, for inputs of magnitude up to xmax
+tnn_error tnn_module_quantize_linear(tnn_module *m, double xmax){
+  tnn_error ret;
+  tnn_module_linear_int8 *c;
+  gsl_matrix w;
+  double a;
+  size_t i, j;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  if(m->input->valid != true || m->output->valid != true || m->w.valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+
+  TNN_MACRO_ERRORTEST(tnn_numeric_v2m(&m->w.x, &w, m->output->size, m->input->size),ret);
+  TNN_MACRO_ERRORTEST(tnn_module_linear_int8_alloc(m, m->input->size, m->output->size), ret);
+  c = (tnn_module_linear_int8 *) m->c;
+
+  //Symmetric scale of each row from its largest magnitude
+  for(i = 0; i < c->noutput; i = i + 1){
+    a = 0.0;
+    for(j = 0; j < c->ninput; j = j + 1){
+      a = fmax(a, fabs(gsl_matrix_get(&w, i, j)));
+    }
+    c->scale[i] = a > 0.0 ? a/127.0 : 1.0;
+    for(j = 0; j < c->ninput; j = j + 1){
+      c->w[i*c->stride + j] = tnn_module_linear_int8_round(gsl_matrix_get(&w, i, j), 1.0/c->scale[i]);
+    }
+  }
+  c->sx = xmax > 0.0 ? xmax/127.0 : 1.0;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_fprop_linear_int8(tnn_module *m){
+  tnn_module_linear_int8 *c;
+  int32_t s;
+  double inv;
+  size_t i;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_INT8){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  if(m->input->valid != true || m->output->valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+  c = (tnn_module_linear_int8 *) m->c;
+
+  //Quantize the input
+  inv = 1.0/c->sx;
+  for(i = 0; i < c->ninput; i = i + 1){
+    c->xq[i] = tnn_module_linear_int8_round(gsl_vector_get(&m->input->x, i), inv);
+  }
+
+  //Integer products, dequantized by the row and input scales
+  for(i = 0; i < c->noutput; i = i + 1){
+#if TNN_MODULE_LINEAR_INT8_X86
+    if(c->simd != 0){
+      s = tnn_module_linear_int8_dot_avx2(c->w + i*c->stride, c->xq, c->stride);
+    } else {
+      s = tnn_module_linear_int8_dot(c->w + i*c->stride, c->xq, c->ninput);
+    }
+#else
+    s = tnn_module_linear_int8_dot(c->w + i*c->stride, c->xq, c->ninput);
+#endif
+    gsl_vector_set(&m->output->x, i, (double)s*c->scale[i]*c->sx);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_destroy_linear_int8(tnn_module *m){
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_INT8){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+
+  free(((tnn_module_linear_int8*)m->c)->w);
+  free(((tnn_module_linear_int8*)m->c)->scale);
+  free(((tnn_module_linear_int8*)m->c)->xq);
+  free((tnn_module_linear_int8*)m->c);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_clone_linear_int8(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t){
+  tnn_error ret;
+  tnn_module_linear_int8 *c1, *c2;
+
+  //Routine check
+  if(m1->t != TNN_MODULE_TYPE_LINEAR_INT8){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  c1 = (tnn_module_linear_int8 *) m1->c;
+
+  //Retrieve input and output
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, m1->input, &m2->input), ret);
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, m1->output, &m2->output), ret);
+  if(m1->input->size != m2->input->size || m1->output->size != m2->output->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Keep the unused weight state in step with the linear module, so the parameter layout is unchanged
+  if(p != NULL){
+    tnn_state_init(&m2->w, m1->w.size);
+    TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+    TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_state_share(&m1->w, &m2->w), ret);
+  }
+
+  //Copy the quantized data. Each clone has its own input buffer.
+  TNN_MACRO_ERRORTEST(tnn_module_linear_int8_alloc(m2, c1->ninput, c1->noutput), ret);
+  c2 = (tnn_module_linear_int8 *) m2->c;
+  memcpy(c2->w, c1->w, c1->noutput*c1->stride);
+  memcpy(c2->scale, c1->scale, c1->noutput*sizeof(double));
+  c2->sx = c1->sx;
+  c2->simd = c1->simd;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_debug_linear_int8(tnn_module *m){
+  tnn_error ret;
+  tnn_module_linear_int8 *c;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_INT8){
+    printf("module (int8 linear) mistype\n");
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  c = (tnn_module_linear_int8 *) m->c;
+
+  printf("module (int8 linear) = %p, prev = %p, next = %p, type = %d, constant = %p\n", m, m->prev, m->next, m->t, m->c);
+  printf("bprop = %p, fprop = %p, randomize = %p, destroy = %p, debug = %p\n", m->bprop, m->fprop, m->randomize, m->destroy, m->debug);
+  printf("ninput = %ld, noutput = %ld, stride = %ld, sx = %g, simd = %d\n", c->ninput, c->noutput, c->stride, c->sx, c->simd);
+  printf("input: ");
+  if((ret = tnn_state_debug(m->input)) != TNN_ERROR_SUCCESS){
+    printf("module (int8 linear) debug error\n");
+    return ret;
+  }
+  printf("output: ");
+  if((ret = tnn_state_debug(m->output)) != TNN_ERROR_SUCCESS){
+    printf("module (int8 linear) debug error\n");
+    return ret;
+  }
+  return TNN_ERROR_SUCCESS;
+}
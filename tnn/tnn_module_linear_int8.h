@@ -0,0 +1,83 @@
+/* Thunder Neural Networks Module - Int8 Linear Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The int8 linear module is the inference form of a trained linear module. Each weight row is quantized to
+ * int8 with its own scale, and the input is quantized to int8 with a scale chosen by calibration (see
+ * tnn_quant.h). fprop computes the int32 dot products of the int8 rows and input, then dequantizes the output
+ * with the row and input scales. Rows are padded with zeros to TNN_MODULE_LINEAR_INT8_ALIGN bytes.
+ *
+ * The dot products use an AVX2 kernel when the processor has it, and a scalar one otherwise. The AVX2 kernel
+ * sign-extends both operands to int16 (cvtepi8_epi16) and multiply-adds them in pairs into int32 (madd_epi16);
+ * it does not use maddubs, which needs one unsigned operand and saturates its int16 pair sums. Both kernels
+ * compute the same exact integer sums. There is no bprop: the module is for inference only.
+ *
+ * Quantization does not release the double weights. The weight state of the linear module stays allocated in
+ * its parameter, unused, and a clone given its own parameter copies it, so every replica of a quantized
+ * machine still holds the double weights next to the int8 ones. This keeps the parameter layout of the
+ * machine, which replicas, trainers and tnn_machine_save rely on, but it means quantizing shrinks the saved
+ * int8 weights and the working set of fprop, not the memory of the machine.
+ *
+ * This header defines the following structure:
+ * tnn_module_linear_int8(size_t ninput, size_t noutput, size_t stride, int8_t *w, double *scale, double sx,
+ *                        int8_t *xq, int simd)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_module_quantize_linear(tnn_module *m, double xmax);
+ * tnn_error tnn_module_linear_int8_alloc(tnn_module *m, size_t ninput, size_t noutput);
+ * tnn_error tnn_module_fprop_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_destroy_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_clone_linear_int8(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_debug_linear_int8(tnn_module *m);
+ * tnn_error tnn_module_linear_int8_simd(int *simd);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_pstable.h>
+
+#ifndef TNN_MODULE_LINEAR_INT8_H
+#define TNN_MODULE_LINEAR_INT8_H
+
+//Alignment and padding of the rows in bytes
+#define TNN_MODULE_LINEAR_INT8_ALIGN 32
+
+//The structure
+typedef struct __STRUCT_tnn_module_linear_int8{
+  //Input and output sizes
+  size_t ninput;
+  size_t noutput;
+  //Distance between rows (ninput padded)
+  size_t stride;
+  //Quantized weights and the scale of each row
+  int8_t *w;
+  double *scale;
+  //Input scale
+  double sx;
+  //Quantized input buffer
+  int8_t *xq;
+  //Whether to use the SIMD kernel
+  int simd;
+} tnn_module_linear_int8;
+
+//Function definitions
+tnn_error tnn_module_fprop_linear_int8(tnn_module *m);
+tnn_error tnn_module_destroy_linear_int8(tnn_module *m);
+tnn_error tnn_module_clone_linear_int8(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+tnn_error tnn_module_debug_linear_int8(tnn_module *m);
+
+//Convert a linear module to int8, for inputs of magnitude up to xmax
+tnn_error tnn_module_quantize_linear(tnn_module *m, double xmax);
+
+//Allocate the int8 data of a module for a ninput to noutput product, and make it an int8 linear module
+//The quantized weights, scales and input scale are then filled by the caller.
+tnn_error tnn_module_linear_int8_alloc(tnn_module *m, size_t ninput, size_t noutput);
+
+//Get whether the SIMD kernel is available on this processor
+tnn_error tnn_module_linear_int8_simd(int *simd);
+
+#endif //TNN_MODULE_LINEAR_INT8_H
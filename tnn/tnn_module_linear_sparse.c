@@ -0,0 +1,276 @@
+/* Thunder Neural Networks Module - Sparse Linear Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_module_init_linear_sparse(tnn_module *m, size_t ninput, tnn_state *output, tnn_param *p);
+ * tnn_error tnn_module_linear_sparse_input(tnn_module *m, tnn_sparse *x, size_t row);
+ * tnn_error tnn_module_bprop_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_fprop_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_randomize_linear_sparse(tnn_module *m, double k);
+ * tnn_error tnn_module_destroy_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_clone_linear_sparse(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_debug_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_exportc_linear_sparse(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_sparse.h>
+#include <tnn/tnn_module_linear_sparse.h>
+
+//Allocate the constant parameter
+static tnn_error tnn_module_linear_sparse_alloc(tnn_module *m, size_t ninput){
+  tnn_module_linear_sparse *c;
+
+  c = (tnn_module_linear_sparse *) malloc(sizeof(tnn_module_linear_sparse));
+  if(c == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  c->ninput = ninput;
+  c->x = NULL;
+  c->row = 0;
+  c->touched = NULL;
+  c->ntouched = 0;
+  c->cap = 0;
+  m->c = c;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Store the functions
+static void tnn_module_linear_sparse_funcs(tnn_module *m){
+  m->bprop = &tnn_module_bprop_linear_sparse;
+  m->fprop = &tnn_module_fprop_linear_sparse;
+  m->randomize = &tnn_module_randomize_linear_sparse;
+  m->destroy = &tnn_module_destroy_linear_sparse;
+  m->debug = &tnn_module_debug_linear_sparse;
+  m->clone = &tnn_module_clone_linear_sparse;
+  m->exportc = &tnn_module_exportc_linear_sparse;
+}
+
+tnn_error tnn_module_init_linear_sparse(tnn_module *m, size_t ninput, tnn_state *output, tnn_param *p){
+  tnn_error ret;
+
+  //Defined type
+  m->t = TNN_MODULE_TYPE_LINEAR_SPARSE;
+
+  //Constant parameter is a new tnn_module_linear_sparse
+  TNN_MACRO_ERRORTEST(tnn_module_linear_sparse_alloc(m, ninput), ret);
+
+  //Allocate the parameter states
+  tnn_state_init(&m->w, ninput*output->size);
+  TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m->w), ret);
+
+  //The input is not a state
+  m->input = NULL;
+  m->output = output;
+
+  tnn_module_linear_sparse_funcs(m);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Set the input to row of x
+tnn_error tnn_module_linear_sparse_input(tnn_module *m, tnn_sparse *x, size_t row){
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  if(x->size2 != ((tnn_module_linear_sparse*)m->c)->ninput || row >= x->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  ((tnn_module_linear_sparse*)m->c)->x = x;
+  ((tnn_module_linear_sparse*)m->c)->row = row;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_bprop_linear_sparse(tnn_module *m){
+  tnn_module_linear_sparse *c;
+  gsl_vector_view dw;
+  size_t *touched;
+  size_t k, n;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  c = (tnn_module_linear_sparse*)m->c;
+  if(c->x == NULL || m->output->valid != true || m->w.valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+  n = c->x->ptr[c->row + 1] - c->x->ptr[c->row];
+
+  //Clear the rows of the last bprop, or everything the first time
+  if(c->touched == NULL){
+    gsl_vector_set_zero(&m->w.dx);
+  } else {
+    for(k = 0; k < c->ntouched; k = k + 1){
+      dw = gsl_vector_subvector(&m->w.dx, c->touched[k]*m->output->size, m->output->size);
+      gsl_vector_set_zero(&dw.vector);
+    }
+  }
+  if(c->touched == NULL || n > c->cap){
+    touched = (size_t *) realloc(c->touched, (n > 0 ? n : 1)*sizeof(size_t));
+    if(touched == NULL){
+      return TNN_ERROR_ALLOC;
+    }
+    c->touched = touched;
+    c->cap = n > 0 ? n : 1;
+  }
+
+  //bprop to dw: the outer product only fills the rows of the nonzero features
+  for(k = 0; k < n; k = k + 1){
+    c->touched[k] = c->x->ind[c->x->ptr[c->row] + k];
+    dw = gsl_vector_subvector(&m->w.dx, c->touched[k]*m->output->size, m->output->size);
+    TNN_MACRO_GSLTEST(gsl_blas_daxpy(c->x->val[c->x->ptr[c->row] + k], &m->output->dx, &dw.vector));
+  }
+  c->ntouched = n;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_fprop_linear_sparse(tnn_module *m){
+  tnn_module_linear_sparse *c;
+  gsl_vector_view w;
+  size_t k;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  c = (tnn_module_linear_sparse*)m->c;
+  if(c->x == NULL || m->output->valid != true || m->w.valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+
+  //Sum the weight rows of the nonzero features
+  gsl_vector_set_zero(&m->output->x);
+  for(k = c->x->ptr[c->row]; k < c->x->ptr[c->row + 1]; k = k + 1){
+    w = gsl_vector_subvector(&m->w.x, c->x->ind[k]*m->output->size, m->output->size);
+    TNN_MACRO_GSLTEST(gsl_blas_daxpy(c->x->val[k], &w.vector, &m->output->x));
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_randomize_linear_sparse(tnn_module *m, double k){
+  double z;
+  size_t i;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  if(m->output->valid != true || m->w.valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+
+  //Initialize
+  srand(time(NULL));
+  z = k/sqrt((double)((tnn_module_linear_sparse*)m->c)->ninput);
+
+  //Set every element
+  for(i = 0; i < m->w.size; i = i + 1){
+    gsl_vector_set(&m->w.x, i, 2.0*z*((double)rand()/(double)RAND_MAX) - z);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_destroy_linear_sparse(tnn_module *m){
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+
+  //Destroy the constant. The input matrix is not owned by the module.
+  free(((tnn_module_linear_sparse*)m->c)->touched);
+  free((tnn_module_linear_sparse*)m->c);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_clone_linear_sparse(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t){
+  tnn_error ret;
+  size_t ninput;
+
+  //Routine check
+  if(m1->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+
+  //Retrieve output
+  TNN_MACRO_ERRORTEST(tnn_pstable_find(t, m1->output, &m2->output), ret);
+  if(m1->output->size != m2->output->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  m2->input = NULL;
+
+  //Defined type
+  m2->t = TNN_MODULE_TYPE_LINEAR_SPARSE;
+
+  //Constant parameter is a new tnn_module_linear_sparse, with the same input as m1
+  ninput = ((tnn_module_linear_sparse*)m1->c)->ninput;
+  TNN_MACRO_ERRORTEST(tnn_module_linear_sparse_alloc(m2, ninput), ret);
+  ((tnn_module_linear_sparse*)m2->c)->x = ((tnn_module_linear_sparse*)m1->c)->x;
+  ((tnn_module_linear_sparse*)m2->c)->row = ((tnn_module_linear_sparse*)m1->c)->row;
+
+  //Allocate the parameter states, or share those of m1 if p is NULL
+  if(p != NULL){
+    tnn_state_init(&m2->w, ninput*m2->output->size);
+    TNN_MACRO_ERRORTEST(tnn_param_state_alloc(p,&m2->w), ret);
+    TNN_MACRO_ERRORTEST(tnn_state_copy(&m1->w, &m2->w), ret);
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_state_share(&m1->w, &m2->w), ret);
+  }
+
+  tnn_module_linear_sparse_funcs(m2);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_module_exportc_linear_sparse(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p){
+  //The exported function takes a dense input
+  return TNN_ERROR_MODULE_FUNCNDEF;
+}
+
+tnn_error tnn_module_debug_linear_sparse(tnn_module *m){
+  tnn_error ret;
+  tnn_module_linear_sparse *c;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+    printf("module (sparse linear) mistype\n");
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+  c = (tnn_module_linear_sparse*)m->c;
+
+  printf("module (sparse linear) = %p, prev = %p, next = %p, type = %d, constant = %p\n", m, m->prev, m->next, m->t, m->c);
+  printf("bprop = %p, fprop = %p, randomize = %p, destroy = %p, debug = %p\n", m->bprop, m->fprop, m->randomize, m->destroy, m->debug);
+  printf("ninput = %ld, x = %p, row = %ld, touched = %ld\n", c->ninput, c->x, c->row, c->ntouched);
+  printf("paramter: ");
+  if((ret = tnn_state_debug(&m->w)) != TNN_ERROR_SUCCESS){
+    printf("module (sparse linear) debug error\n");
+    return ret;
+  }
+  printf("output: ");
+  if((ret = tnn_state_debug(m->output)) != TNN_ERROR_SUCCESS){
+    printf("module (sparse linear) debug error\n");
+    return ret;
+  }
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/* Thunder Neural Networks Module - Sparse Linear Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The sparse linear module computes the same product as the linear module, but its input is a row of a
+ * tnn_sparse matrix instead of a state, set with tnn_module_linear_sparse_input before each fprop. The weights
+ * are stored transposed (one contiguous row of output size per input feature), so fprop and bprop only read
+ * and write the weight rows of the nonzero features. The gradient of the weights is zero outside those rows,
+ * as long as only this module writes it. There is no gradient with respect to the input.
+ *
+ * This header defines the following structure:
+ * tnn_module_linear_sparse(size_t ninput, tnn_sparse *x, size_t row, size_t *touched, size_t ntouched,
+ *                          size_t cap)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_module_init_linear_sparse(tnn_module *m, size_t ninput, tnn_state *output, tnn_param *p);
+ * tnn_error tnn_module_linear_sparse_input(tnn_module *m, tnn_sparse *x, size_t row);
+ * tnn_error tnn_module_bprop_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_fprop_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_randomize_linear_sparse(tnn_module *m, double k);
+ * tnn_error tnn_module_destroy_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_clone_linear_sparse(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+ * tnn_error tnn_module_debug_linear_sparse(tnn_module *m);
+ * tnn_error tnn_module_exportc_linear_sparse(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
+ */
+
+#include <stdio.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_pstable.h>
+#include <tnn/tnn_sparse.h>
+
+#ifndef TNN_MODULE_LINEAR_SPARSE_H
+#define TNN_MODULE_LINEAR_SPARSE_H
+
+//The structure
+typedef struct __STRUCT_tnn_module_linear_sparse{
+  //Number of input features
+  size_t ninput;
+  //Current input: row of x
+  tnn_sparse *x;
+  size_t row;
+  //Weight rows written by the last bprop (NULL before the first one)
+  size_t *touched;
+  size_t ntouched;
+  size_t cap;
+} tnn_module_linear_sparse;
+
+//Function definitions
+tnn_error tnn_module_init_linear_sparse(tnn_module *m, size_t ninput, tnn_state *output, tnn_param *p);
+tnn_error tnn_module_bprop_linear_sparse(tnn_module *m);
+tnn_error tnn_module_fprop_linear_sparse(tnn_module *m);
+tnn_error tnn_module_randomize_linear_sparse(tnn_module *m, double k);
+tnn_error tnn_module_destroy_linear_sparse(tnn_module *m);
+tnn_error tnn_module_clone_linear_sparse(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
+tnn_error tnn_module_debug_linear_sparse(tnn_module *m);
+tnn_error tnn_module_exportc_linear_sparse(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
+
+//Set the input to row of x
+tnn_error tnn_module_linear_sparse_input(tnn_module *m, tnn_sparse *x, size_t row);
+
+#endif //TNN_MODULE_LINEAR_SPARSE_H
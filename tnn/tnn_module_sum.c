@@ -11,9 +11,11 @@
  * tnn_error tnn_module_clone_sum(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *t);
  * tnn_error tnn_module_debug_sum(tnn_module *m);
  * tnn_error tnn_module_sum_get(tnn_module *m, tnn_state **t, size_t ind);
+ * tnn_error tnn_module_exportc_sum(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <tnn/tnn_error.h>
@@ -24,6 +26,7 @@
 #include <tnn/tnn_module_sum.h>
 #include <tnn/utarray.h>
 #include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
 
 tnn_error tnn_module_init_sum(tnn_module *m, tnn_state *input, tnn_state *output, tnn_param *io){
   tnn_error ret;
@@ -79,6 +82,7 @@ tnn_error tnn_module_init_sum(tnn_module *m, tnn_state *input, tnn_state *output
   m->destroy = &tnn_module_destroy_sum;
   m->clone = &tnn_module_clone_sum;
   m->debug = &tnn_module_debug_sum;
+  m->exportc = &tnn_module_exportc_sum;
   
   return TNN_ERROR_SUCCESS;
 }
@@ -116,7 +120,7 @@ tnn_error tnn_module_fprop_sum(tnn_module *m){
   }
 
   //fprop to output
-  TNN_MACRO_GSLTEST(gsl_blas_dscal(0.0, &m->output->x));
+  gsl_blas_dscal(0.0, &m->output->x);
   for(t = (tnn_state **)utarray_front(((tnn_module_sum*)m->c)->sarray);
       t != NULL;
       t = (tnn_state **)utarray_next(((tnn_module_sum*)m->c)->sarray, t)){
@@ -174,10 +178,6 @@ tnn_error tnn_module_clone_sum(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn
   //Find the sub states
   utarray_new(c->sarray, &sarray_icd);
   for(i = 0; i < utarray_len(((tnn_module_sum*)m1->c)->sarray); i = i + 1){
-    s2 = (tnn_state *) malloc(sizeof(tnn_state));
-    if(s2 == NULL){
-      return TNN_ERROR_ALLOC;
-    }
     s = (tnn_state **)utarray_eltptr(((tnn_module_sum*)m1->c)->sarray, i);
     s1 = *s;
     TNN_MACRO_ERRORTEST(tnn_pstable_find(t, s1, &s2), ret);
@@ -194,6 +194,7 @@ tnn_error tnn_module_clone_sum(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn
   m2->destroy = &tnn_module_destroy_sum;
   m2->debug = &tnn_module_debug_sum;
   m2->clone = &tnn_module_clone_sum;
+  m2->exportc = &tnn_module_exportc_sum;
 
   return TNN_ERROR_SUCCESS;
 }
@@ -250,3 +251,35 @@ tnn_error tnn_module_sum_get(tnn_module *m, tnn_state **t, size_t ind){
 
   return TNN_ERROR_SUCCESS;
 }
+
+tnn_error tnn_module_exportc_sum(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p){
+  tnn_error ret;
+  tnn_state **t;
+  size_t out, in;
+
+  //Routine check
+  if(m->t != TNN_MODULE_TYPE_SUM){
+    return TNN_ERROR_MODULE_MISTYPE;
+  }
+
+  //Locate the output
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, m->output, &out), ret);
+
+  //Same accumulation order as the reference fprop
+  fprintf(fp, "  //Module (sum): %ld -> %ld\n", m->input->size, m->output->size);
+  fprintf(fp, "  {\n");
+  fprintf(fp, "    size_t i;\n");
+  fprintf(fp, "    for(i = 0; i < %ld; i = i + 1){\n", m->output->size);
+  fprintf(fp, "      io[%ld + i] = 0.0", out);
+  for(t = (tnn_state **)utarray_front(((tnn_module_sum*)m->c)->sarray);
+      t != NULL;
+      t = (tnn_state **)utarray_next(((tnn_module_sum*)m->c)->sarray, t)){
+    TNN_MACRO_ERRORTEST(tnn_param_state_offset(io, *t, &in), ret);
+    fprintf(fp, " + io[%ld + i]", in);
+  }
+  fprintf(fp, ";\n");
+  fprintf(fp, "    }\n");
+  fprintf(fp, "  }\n");
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -14,8 +14,10 @@
  * tnn_error tnn_module_clone_sum(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *io);
  * tnn_error tnn_module_debug_sum(tnn_module *m);
  * tnn_error tnn_module_sum_get(tnn_module *m, tnn_state **t, size_t ind); 
+ * tnn_error tnn_module_exportc_sum(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
  */
 
+#include <stdio.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_module.h>
@@ -42,5 +44,6 @@ tnn_error tnn_module_destroy_sum(tnn_module *m);
 tnn_error tnn_module_clone_sum(tnn_module *m1, tnn_module *m2, tnn_param *p, tnn_pstable *io);
 tnn_error tnn_module_debug_sum(tnn_module *m);
 tnn_error tnn_module_sum_get(tnn_module *m, tnn_state **t, size_t ind); 
+tnn_error tnn_module_exportc_sum(tnn_module *m, FILE *fp, const char *name, tnn_param *io, tnn_param *p);
 
 #endif //TNN_MODULE_SUM_H
@@ -9,22 +9,103 @@
  * tnn_error tnn_param_destroy(tnn_param p);
  * tnn_error tnn_param_state_sub(tnn_param *p, tnn_state *s, tnn_state *t, size_t offset);
  * tnn_error tnn_param_debug(tnn_param *p);
+ * tnn_error tnn_param_state_offset(tnn_param *p, tnn_state *s, size_t *offset);
+ * tnn_error tnn_param_save(tnn_param *p, const char *file);
+ * tnn_error tnn_param_load(tnn_param *p, const char *file);
+ * tnn_error tnn_param_reserve(tnn_param *p, size_t size);
  */
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <gsl/gsl_vector.h>
 #include <tnn/utlist.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_param.h>
 #include <tnn/tnn_error.h>
 
+//Free the vectors, unmapping x if it was loaded from a file
+static void tnn_param_free(tnn_param *p){
+  gsl_vector_free(p->x);
+  gsl_vector_free(p->dx);
+  if(p->map != NULL){
+    munmap(p->map, p->mapsize);
+    p->map = NULL;
+    p->mapsize = 0;
+  }
+}
+
+//Point all the states to their places in x and dx
+static void tnn_param_renew(tnn_param *p){
+  gsl_vector_view xv;
+  gsl_vector_view dxv;
+  tnn_state *elt;
+  size_t i;
+
+  //Top states are stored in sequence
+  i = 0;
+  DL_FOREACH(p->states, elt){
+    if(elt->parent == NULL){
+      xv = gsl_vector_subvector(p->x, i, elt->size);
+      dxv = gsl_vector_subvector(p->dx, i, elt->size);
+      elt->x = xv.vector;
+      elt->dx = dxv.vector;
+      elt->valid = true;
+      i = i + elt->size;
+    }
+  }
+
+  //Substates are views of their parents
+  DL_FOREACH(p->states, elt){
+    if(elt->parent != NULL){
+      xv = gsl_vector_subvector(&elt->parent->x, elt->offset, elt->size);
+      dxv = gsl_vector_subvector(&elt->parent->dx, elt->offset, elt->size);
+      elt->x = xv.vector;
+      elt->dx = dxv.vector;
+      elt->valid = true;
+    }
+  }
+}
+
+//Number of values x and dx have room for
+static size_t tnn_param_capacity(tnn_param *p){
+  if(p->x == NULL || p->map != NULL || p->x->block == NULL || p->dx->block == NULL){
+    return p->size;
+  }
+  return p->x->block->size < p->dx->block->size ? p->x->block->size : p->dx->block->size;
+}
+
+//Place a top state at the end of x and dx, in room already reserved
+static void tnn_param_place(tnn_param *p, tnn_state *s){
+  gsl_vector_view xv;
+  gsl_vector_view dxv;
+
+  p->x->size = p->size + s->size;
+  p->dx->size = p->size + s->size;
+  DL_APPEND(p->states, s);
+  xv = gsl_vector_subvector(p->x, p->size, s->size);
+  dxv = gsl_vector_subvector(p->dx, p->size, s->size);
+  s->x = xv.vector;
+  s->dx = dxv.vector;
+  s->valid = true;
+  p->size = p->size + s->size;
+}
+
 //Initialize size to 0, pointers to NULL
 tnn_error tnn_param_init(tnn_param *p){
   p->x = NULL;
   p->dx = NULL;
   p->states = NULL;
   p->size = 0;
+  p->map = NULL;
+  p->mapsize = 0;
   return TNN_ERROR_SUCCESS;
 }
 
@@ -34,15 +115,19 @@ tnn_error tnn_param_state_alloc(tnn_param *p, tnn_state *s){
   gsl_vector *dx;
   gsl_vector_view xv;
   gsl_vector_view dxv;
-  tnn_state *elt;
-  tnn_state *tmp;
-  size_t i, size;
+  size_t size;
 
   //Routine check
   if(s->valid == true){
     return TNN_ERROR_PARAM_VALID;
   }
 
+  //Use the reserved room if there is enough
+  if(p->x != NULL && p->size + s->size <= tnn_param_capacity(p)){
+    tnn_param_place(p, s);
+    return TNN_ERROR_SUCCESS;
+  }
+
   //Allocate new vectors
   size = p->size + s->size;
   x = gsl_vector_alloc(size);
@@ -58,8 +143,9 @@ tnn_error tnn_param_state_alloc(tnn_param *p, tnn_state *s){
     dxv = gsl_vector_subvector(dx, 0, p->size);
     gsl_vector_memcpy(&xv.vector, p->x);
     gsl_vector_memcpy(&dxv.vector, p->dx);
-    gsl_vector_free(p->x);
-    gsl_vector_free(p->dx);
+  }
+  if(p->x != NULL){
+    tnn_param_free(p);
   }
   p->x = x;
   p->dx = dx;
@@ -68,29 +154,8 @@ tnn_error tnn_param_state_alloc(tnn_param *p, tnn_state *s){
   //Add this state to the list
   DL_APPEND(p->states, s);
 
-  //Renew the information stored in all lists
-  i = 0;
-  DL_FOREACH_SAFE(p->states, elt, tmp){
-    if(elt->parent == NULL){
-      xv = gsl_vector_subvector(p->x, i, elt->size);
-      dxv = gsl_vector_subvector(p->dx, i, elt->size);
-      elt->x = xv.vector;
-      elt->dx = dxv.vector;
-      elt->valid = true;
-      i = i + elt->size;
-    }
-  }
-
-  //Renew the information in all substates
-  DL_FOREACH_SAFE(p->states, elt, tmp){
-    if(elt->parent != NULL){
-      xv = gsl_vector_subvector(&elt->parent->x, elt->offset, elt->size);
-      dxv = gsl_vector_subvector(&elt->parent->dx, elt->offset, elt->size);
-      elt->x = xv.vector;
-      elt->dx = dxv.vector;
-      elt->valid = true;
-    }
-  }
+  //Renew the information stored in all states
+  tnn_param_renew(p);
 
   return TNN_ERROR_SUCCESS;
 }
@@ -101,15 +166,21 @@ tnn_error tnn_param_state_calloc(tnn_param *p, tnn_state *s){
   gsl_vector *dx;
   gsl_vector_view xv;
   gsl_vector_view dxv;
-  tnn_state *elt;
-  tnn_state *tmp;
-  size_t i, size;
+  size_t size;
 
   //Routine check
   if(s->valid == true){
     return TNN_ERROR_PARAM_VALID;
   }
 
+  //Use the reserved room if there is enough
+  if(p->x != NULL && p->size + s->size <= tnn_param_capacity(p)){
+    tnn_param_place(p, s);
+    gsl_vector_set_zero(&s->x);
+    gsl_vector_set_zero(&s->dx);
+    return TNN_ERROR_SUCCESS;
+  }
+
   //Allocate new vectors
   size = p->size + s->size;
   x = gsl_vector_calloc(size);
@@ -125,8 +196,9 @@ tnn_error tnn_param_state_calloc(tnn_param *p, tnn_state *s){
     dxv = gsl_vector_subvector(dx, 0, p->size);
     gsl_vector_memcpy(&xv.vector, p->x);
     gsl_vector_memcpy(&dxv.vector, p->dx);
-    gsl_vector_free(p->x);
-    gsl_vector_free(p->dx);
+  }
+  if(p->x != NULL){
+    tnn_param_free(p);
   }
   p->x = x;
   p->dx = dx;
@@ -135,29 +207,8 @@ tnn_error tnn_param_state_calloc(tnn_param *p, tnn_state *s){
   //Add this state to the list
   DL_APPEND(p->states, s);
 
-  //Renew the information stored in all lists
-  i = 0;
-  DL_FOREACH_SAFE(p->states, elt, tmp){
-    if(elt->parent == NULL){
-      xv = gsl_vector_subvector(p->x, i, elt->size);
-      dxv = gsl_vector_subvector(p->dx, i, elt->size);
-      elt->x = xv.vector;
-      elt->dx = dxv.vector;
-      elt->valid = true;
-      i = i + elt->size;
-    }
-  }
-
-  //Renew the information in all substates
-  DL_FOREACH_SAFE(p->states, elt, tmp){
-    if(elt->parent != NULL){
-      xv = gsl_vector_subvector(&elt->parent->x, elt->offset, elt->size);
-      dxv = gsl_vector_subvector(&elt->parent->dx, elt->offset, elt->size);
-      elt->x = xv.vector;
-      elt->dx = dxv.vector;
-      elt->valid = true;
-    }
-  }
+  //Renew the information stored in all states
+  tnn_param_renew(p);
 
   return TNN_ERROR_SUCCESS;
 }
@@ -168,15 +219,14 @@ tnn_error tnn_param_destroy(tnn_param *p){
   tnn_state *elt;
   tnn_state *tmp;
 
-  if(p->size > 0){
+  if(p->x != NULL){
     //Set all of the states to invalid
     DL_FOREACH_SAFE(p->states, elt, tmp){
       elt->valid = false;
     }
     p->states = NULL;
     //Free the vectors
-    gsl_vector_free(p->x);
-    gsl_vector_free(p->dx);
+    tnn_param_free(p);
     p->x = NULL;
     p->dx = NULL;
     //Set the size to be 0
@@ -247,3 +297,204 @@ tnn_error tnn_param_debug(tnn_param *p){
   }
   return TNN_ERROR_SUCCESS;
 }
+
+//Get the offset of a valid state's values inside p->x
+tnn_error tnn_param_state_offset(tnn_param *p, tnn_state *s, size_t *offset){
+  //Routine check
+  if(s->valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+  if(p->size == 0 || s->x.stride != 1){
+    return TNN_ERROR_PARAM_NEXIST;
+  }
+
+  //The state must lie inside the parameter vector
+  if(s->x.data < p->x->data || s->x.data + s->size > p->x->data + p->size){
+    return TNN_ERROR_PARAM_NEXIST;
+  }
+  *offset = (size_t)(s->x.data - p->x->data);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_param_save(tnn_param *p, const char *file){
+  tnn_param_header h;
+  tnn_state *elt;
+  uint64_t *table;
+  char pad[TNN_PARAM_FILE_ALIGN];
+  size_t n, i, off;
+  FILE *fp;
+  tnn_error ret;
+
+  //Build the state table
+  n = 0;
+  DL_FOREACH(p->states, elt){
+    n = n + 1;
+  }
+  table = (uint64_t *)malloc((2*n + 1)*sizeof(uint64_t));
+  if(table == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  i = 0;
+  DL_FOREACH(p->states, elt){
+    if((ret = tnn_param_state_offset(p, elt, &off)) != TNN_ERROR_SUCCESS){
+      free(table);
+      return ret;
+    }
+    table[2*i] = (uint64_t)elt->size;
+    table[2*i + 1] = (uint64_t)off;
+    i = i + 1;
+  }
+
+  //Build the header
+  memcpy(h.magic, TNN_PARAM_FILE_MAGIC, 8);
+  h.version = TNN_PARAM_FILE_VERSION;
+  h.endian = TNN_PARAM_FILE_ENDIAN;
+  h.dsize = sizeof(double);
+  h.size = p->size;
+  h.nstates = n;
+  h.offset = sizeof(tnn_param_header) + 2*n*sizeof(uint64_t);
+  h.offset = (h.offset + TNN_PARAM_FILE_ALIGN - 1)/TNN_PARAM_FILE_ALIGN*TNN_PARAM_FILE_ALIGN;
+  memset(pad, 0, TNN_PARAM_FILE_ALIGN);
+
+  //Write the file
+  if((fp = fopen(file, "wb")) == NULL){
+    free(table);
+    return TNN_ERROR_FILE;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  if(fwrite(&h, sizeof(tnn_param_header), 1, fp) != 1
+     || fwrite(table, sizeof(uint64_t), 2*n, fp) != 2*n
+     || fwrite(pad, 1, h.offset - sizeof(tnn_param_header) - 2*n*sizeof(uint64_t), fp)
+     != h.offset - sizeof(tnn_param_header) - 2*n*sizeof(uint64_t)
+     || (p->size > 0 && fwrite(p->x->data, sizeof(double), p->size, fp) != p->size)){
+    ret = TNN_ERROR_FILE;
+  }
+  if(fclose(fp) != 0){
+    ret = TNN_ERROR_FILE;
+  }
+  free(table);
+
+  return ret;
+}
+
+tnn_error tnn_param_load(tnn_param *p, const char *file){
+  tnn_param_header *h;
+  tnn_state *elt;
+  uint64_t *table;
+  gsl_vector *x;
+  gsl_vector_view xv;
+  struct stat st;
+  void *map;
+  size_t n, i, off;
+  int fd;
+  tnn_error ret;
+
+  //Map the file
+  if((fd = open(file, O_RDONLY)) < 0){
+    return TNN_ERROR_FILE;
+  }
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(tnn_param_header)){
+    close(fd);
+    return TNN_ERROR_FILE_FORMAT;
+  }
+  map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED){
+    return TNN_ERROR_FILE;
+  }
+
+  //Check the header
+  h = (tnn_param_header *)map;
+  n = 0;
+  DL_FOREACH(p->states, elt){
+    n = n + 1;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  if(memcmp(h->magic, TNN_PARAM_FILE_MAGIC, 8) != 0 || h->version != TNN_PARAM_FILE_VERSION
+     || h->endian != TNN_PARAM_FILE_ENDIAN || h->dsize != sizeof(double) || h->offset % TNN_PARAM_FILE_ALIGN != 0
+     || h->offset < sizeof(tnn_param_header) + 2*h->nstates*sizeof(uint64_t)
+     || h->offset + h->size*sizeof(double) > (uint64_t)st.st_size){
+    ret = TNN_ERROR_FILE_FORMAT;
+  } else if(h->size != p->size || h->nstates != n){
+    ret = TNN_ERROR_PARAM_INCOMP;
+  }
+
+  //Check the state table
+  table = (uint64_t *)((char *)map + sizeof(tnn_param_header));
+  i = 0;
+  DL_FOREACH(p->states, elt){
+    if(ret != TNN_ERROR_SUCCESS){
+      break;
+    }
+    if((ret = tnn_param_state_offset(p, elt, &off)) == TNN_ERROR_SUCCESS
+       && (table[2*i] != elt->size || table[2*i + 1] != off)){
+      ret = TNN_ERROR_PARAM_INCOMP;
+    }
+    i = i + 1;
+  }
+  if(ret != TNN_ERROR_SUCCESS || p->size == 0){
+    munmap(map, (size_t)st.st_size);
+    return ret;
+  }
+
+  //Point x at the mapping
+  x = (gsl_vector *)malloc(sizeof(gsl_vector));
+  if(x == NULL){
+    munmap(map, (size_t)st.st_size);
+    return TNN_ERROR_ALLOC;
+  }
+  xv = gsl_vector_view_array((double *)((char *)map + h->offset), p->size);
+  *x = xv.vector;
+  gsl_vector_free(p->x);
+  if(p->map != NULL){
+    munmap(p->map, p->mapsize);
+  }
+  p->x = x;
+  p->map = map;
+  p->mapsize = (size_t)st.st_size;
+
+  //Renew the information stored in all states
+  tnn_param_renew(p);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Reserve room for size values, so that states allocated up to it are placed without reallocating
+tnn_error tnn_param_reserve(tnn_param *p, size_t size){
+  gsl_vector *x;
+  gsl_vector *dx;
+
+  if(size <= tnn_param_capacity(p)){
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Allocate the room and keep the values
+  x = gsl_vector_alloc(size);
+  dx = gsl_vector_alloc(size);
+  if(x == NULL || dx == NULL){
+    if(x != NULL){
+      gsl_vector_free(x);
+    }
+    if(dx != NULL){
+      gsl_vector_free(dx);
+    }
+    return TNN_ERROR_ALLOC;
+  }
+  x->size = p->size;
+  dx->size = p->size;
+  if(p->size > 0){
+    gsl_vector_memcpy(x, p->x);
+    gsl_vector_memcpy(dx, p->dx);
+  }
+  if(p->x != NULL){
+    tnn_param_free(p);
+  }
+  p->x = x;
+  p->dx = dx;
+
+  //Renew the information stored in all states
+  tnn_param_renew(p);
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -3,7 +3,9 @@
  * Version 0.1, 02/19/2012
  *
  * This header defines the following structure:
- * tnn_param(gsl_vector *x, gsl_vector *dx, tnn_state *states, size_t size)
+ * tnn_param(gsl_vector *x, gsl_vector *dx, tnn_state *states, size_t size, void *map, size_t mapsize)
+ * tnn_param_header(char magic[8], uint32_t version, uint32_t endian, uint64_t dsize, uint64_t size,
+ *                  uint64_t nstates, uint64_t offset)
  *
  * This header defines the following functions:
  * tnn_error tnn_param_init(tnn_param *p);
@@ -12,9 +14,14 @@
  * tnn_error tnn_param_destroy(tnn_param p);
  * tnn_error tnn_param_state_sub(tnn_param *p, tnn_state *s, tnn_state *t, size_t offset);
  * tnn_error tnn_param_debug(tnn_param *p);
+ * tnn_error tnn_param_state_offset(tnn_param *p, tnn_state *s, size_t *offset);
+ * tnn_error tnn_param_save(tnn_param *p, const char *file);
+ * tnn_error tnn_param_load(tnn_param *p, const char *file);
+ * tnn_error tnn_param_reserve(tnn_param *p, size_t size);
  */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <gsl/gsl_vector.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_error.h>
@@ -22,13 +29,40 @@
 #ifndef TNN_PARAM_H
 #define TNN_PARAM_H
 
+//Parameter file format: header, state table of (size, offset) pairs, zero padding, then x
+#define TNN_PARAM_FILE_MAGIC "TNNPARAM"
+#define TNN_PARAM_FILE_VERSION 1
+#define TNN_PARAM_FILE_ENDIAN 0x01020304
+#define TNN_PARAM_FILE_ALIGN 64
+
 typedef struct __STRUCT_tnn_param{
   gsl_vector *x;
   gsl_vector *dx;
   tnn_state *states;
   size_t size;
+  //Mapping of the file x was loaded from (NULL if x is allocated)
+  void *map;
+  size_t mapsize;
 } tnn_param;
 
+//Parameter file header
+typedef struct __STRUCT_tnn_param_header{
+  //Magic string TNN_PARAM_FILE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_PARAM_FILE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Size of a value in bytes
+  uint64_t dsize;
+  //Number of values
+  uint64_t size;
+  //Number of states in the table
+  uint64_t nstates;
+  //Byte offset of the values, a multiple of TNN_PARAM_FILE_ALIGN
+  uint64_t offset;
+} tnn_param_header;
+
 //Initialize size to 0, pointers to NULL
 tnn_error tnn_param_init(tnn_param *p);
 
@@ -46,4 +80,19 @@ tnn_error tnn_param_state_sub(tnn_param *p, tnn_state *s, tnn_state *t, size_t o
 //Debug info from paramters
 tnn_error tnn_param_debug(tnn_param *p);
 
+//Get the offset of a valid state's values inside p->x
+tnn_error tnn_param_state_offset(tnn_param *p, tnn_state *s, size_t *offset);
+
+//Save the values of the parameter to a binary file
+tnn_error tnn_param_save(tnn_param *p, const char *file);
+
+//Load the values of the parameter from a binary file by mapping it into memory (no copy)
+//The states of p must already be allocated and match the state table of the file. x becomes a private
+//mapping of the file: pages are shared across processes until written, and writes never reach the file.
+tnn_error tnn_param_load(tnn_param *p, const char *file);
+
+//Reserve room for size values in x and dx
+//States allocated while the total fits are placed in the room, without reallocating or moving the others.
+tnn_error tnn_param_reserve(tnn_param *p, size_t size);
+
 #endif //TNN_PARAM_H
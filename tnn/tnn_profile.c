@@ -0,0 +1,524 @@
+/* Thunder Neural Networks Profiler Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_profile_init(tnn_profile *f);
+ * tnn_error tnn_profile_add_module(tnn_profile *f, tnn_module *m);
+ * tnn_error tnn_profile_add_machine(tnn_profile *f, tnn_machine *m);
+ * tnn_error tnn_profile_add_loss(tnn_profile *f, tnn_loss *l);
+ * tnn_error tnn_profile_add_reg(tnn_profile *f, tnn_reg *r);
+ * tnn_error tnn_profile_add_trainer_class(tnn_profile *f, tnn_trainer_class *t);
+ * tnn_error tnn_profile_reset(tnn_profile *f);
+ * tnn_error tnn_profile_report(tnn_profile *f, FILE *fp);
+ * tnn_error tnn_profile_report_csv(tnn_profile *f, FILE *fp);
+ * tnn_error tnn_profile_destroy(tnn_profile *f);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <tnn/uthash.h>
+#include <tnn/utlist.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear_sparse.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_profile.h>
+
+//Global table of all profiled objects, used by the wrappers to find their statistics
+//The wrappers read it under the read lock; adding and destroying profiles write it under the write lock.
+static tnn_profile_el *tnn_profile_table = NULL;
+static pthread_rwlock_t tnn_profile_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+//Monotonic wall-clock time in seconds
+static double tnn_profile_now(){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+}
+
+//Estimate the cost of one module call (d = 0 for fprop, d = 1 for bprop)
+static void tnn_profile_cost_module(tnn_module *m, int d, double *flops, double *bytes){
+  double in, out, w;
+  in = m->input != NULL ? (double)m->input->size : 0.0;
+  out = m->output != NULL ? (double)m->output->size : 0.0;
+  w = (double)m->w.size;
+  switch(m->t){
+  case TNN_MODULE_TYPE_LINEAR:
+    //fprop: y = Wx; bprop: dx = W'dy, dW = dy x'
+    *flops = d == 0 ? 2.0*in*out : 4.0*in*out;
+    *bytes = d == 0 ? 8.0*(w + in + out) : 8.0*(4.0*w + 2.0*in + 2.0*out);
+    break;
+  case TNN_MODULE_TYPE_LINEAR_SPARSE:
+    //Only the weight rows of the nonzero features: in counts the nonzeros of the current input
+    in = ((tnn_module_linear_sparse*)m->c)->x != NULL
+      ? (double)(((tnn_module_linear_sparse*)m->c)->x->ptr[((tnn_module_linear_sparse*)m->c)->row + 1]
+                 - ((tnn_module_linear_sparse*)m->c)->x->ptr[((tnn_module_linear_sparse*)m->c)->row]) : 0.0;
+    *flops = 2.0*in*out;
+    *bytes = d == 0 ? 8.0*(in*out + 2.0*in + out) : 8.0*(4.0*in*out + 2.0*in + out);
+    break;
+  case TNN_MODULE_TYPE_BIAS:
+    //fprop: y = x + b; bprop: dx = dy, db = dy
+    *flops = d == 0 ? out : 0.0;
+    *bytes = d == 0 ? 8.0*(in + w + out) : 8.0*(2.0*out + in + w);
+    break;
+  case TNN_MODULE_TYPE_SUM:
+    //fprop: y = sum of inputs; bprop: dx_i = dy
+    *flops = d == 0 ? in : 0.0;
+    *bytes = d == 0 ? 8.0*(in + 2.0*out) : 8.0*(2.0*in);
+    break;
+  default:
+    //Unknown cost: count only the data touched
+    *flops = 0.0;
+    *bytes = d == 0 ? 8.0*(in + w + out) : 16.0*(in + w + out);
+    break;
+  }
+}
+
+//Estimate the cost of one loss call
+static void tnn_profile_cost_loss(tnn_loss *l, int d, double *flops, double *bytes){
+  double n;
+  n = l->input1 != NULL ? (double)l->input1->size : 0.0;
+  switch(l->t){
+  case TNN_LOSS_TYPE_EUCLIDEAN:
+    //fprop: l = |x-y|^2; bprop: dx = 2dl(x-y), dy = -dx
+    *flops = d == 0 ? 3.0*n : 4.0*n;
+    *bytes = d == 0 ? 8.0*3.0*n : 8.0*7.0*n;
+    break;
+  default:
+    *flops = 0.0;
+    *bytes = d == 0 ? 8.0*2.0*n : 8.0*4.0*n;
+    break;
+  }
+}
+
+//Estimate the cost of one regularizer call (d = 0 for l, d = 1 for d)
+static void tnn_profile_cost_reg(tnn_reg *r, int d, size_t size, double *flops, double *bytes){
+  double n;
+  n = (double)size;
+  switch(r->t){
+  case TNN_REG_TYPE_L1:
+    *flops = n;
+    *bytes = d == 0 ? 8.0*n : 16.0*n;
+    break;
+  case TNN_REG_TYPE_L2:
+    *flops = 2.0*n;
+    *bytes = d == 0 ? 8.0*n : 8.0*4.0*n;
+    break;
+  default:
+    *flops = 0.0;
+    *bytes = d == 0 ? 8.0*n : 16.0*n;
+    break;
+  }
+}
+
+//Find the element of a profiled object (NULL for a copy of it)
+static tnn_profile_el *tnn_profile_find(void *key){
+  tnn_profile_el *el;
+  HASH_FIND_PTR(tnn_profile_table, &key, el);
+  return el;
+}
+
+//Account one call to an element
+//The read lock only keeps the element alive, so concurrent calls to one object are serialized by its mutex.
+static void tnn_profile_account(tnn_profile_el *el, int d, double t, double flops, double bytes){
+  pthread_mutex_lock(&el->mutex);
+  el->count[d] = el->count[d] + 1;
+  el->time[d] = el->time[d] + t;
+  el->flops[d] = el->flops[d] + flops;
+  el->bytes[d] = el->bytes[d] + bytes;
+  pthread_mutex_unlock(&el->mutex);
+}
+
+//Wrappers of the profiled methods
+//The original methods are kept on the object, so a by-value copy of a profiled object still works: it is not
+//in the table and runs without being accounted.
+static tnn_error tnn_profile_fprop_module(tnn_module *m){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*m->pfprop)(m);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(m)) != NULL){
+    tnn_profile_cost_module(m, 0, &flops, &bytes);
+    tnn_profile_account(el, 0, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+static tnn_error tnn_profile_bprop_module(tnn_module *m){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*m->pbprop)(m);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(m)) != NULL){
+    tnn_profile_cost_module(m, 1, &flops, &bytes);
+    tnn_profile_account(el, 1, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+static tnn_error tnn_profile_fprop_loss(tnn_loss *l){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*l->pfprop)(l);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(l)) != NULL){
+    tnn_profile_cost_loss(l, 0, &flops, &bytes);
+    tnn_profile_account(el, 0, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+static tnn_error tnn_profile_bprop_loss(tnn_loss *l){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*l->pbprop)(l);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(l)) != NULL){
+    tnn_profile_cost_loss(l, 1, &flops, &bytes);
+    tnn_profile_account(el, 1, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+static tnn_error tnn_profile_l_reg(tnn_reg *r, gsl_vector *w, double *l){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*r->pl)(r, w, l);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(r)) != NULL){
+    tnn_profile_cost_reg(r, 0, w->size, &flops, &bytes);
+    tnn_profile_account(el, 0, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+static tnn_error tnn_profile_d_reg(tnn_reg *r, gsl_vector *w, gsl_vector *d){
+  tnn_profile_el *el;
+  tnn_error ret;
+  double t, flops, bytes;
+  t = tnn_profile_now();
+  ret = (*r->pd)(r, w, d);
+  t = tnn_profile_now() - t;
+  pthread_rwlock_rdlock(&tnn_profile_lock);
+  if((el = tnn_profile_find(r)) != NULL){
+    tnn_profile_cost_reg(r, 1, w->size, &flops, &bytes);
+    tnn_profile_account(el, 1, t, flops, bytes);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+
+//Create and register a new element
+static tnn_error tnn_profile_new(tnn_profile *f, void *key, tnn_profile_kind kind, int type, tnn_profile_el **el){
+  if(tnn_profile_find(key) != NULL){
+    return TNN_ERROR_PROFILE_EXIST;
+  }
+  if((*el = (tnn_profile_el*)calloc(1, sizeof(tnn_profile_el))) == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  pthread_mutex_init(&(*el)->mutex, NULL);
+  (*el)->key = key;
+  (*el)->kind = kind;
+  (*el)->type = type;
+  (*el)->index = f->length;
+  HASH_ADD_PTR(tnn_profile_table, key, *el);
+  DL_APPEND(f->els, *el);
+  f->length = f->length + 1;
+  return TNN_ERROR_SUCCESS;
+}
+
+//Name of the type of an element
+static const char *tnn_profile_name(tnn_profile_el *el){
+  if(el->kind == TNN_PROFILE_KIND_MODULE){
+    switch(el->type){
+    case TNN_MODULE_TYPE_LINEAR: return "linear";
+    case TNN_MODULE_TYPE_BIAS: return "bias";
+    case TNN_MODULE_TYPE_TANH: return "tanh";
+    case TNN_MODULE_TYPE_SOFTMAX: return "softmax";
+    case TNN_MODULE_TYPE_NEGEXP: return "negexp";
+    case TNN_MODULE_TYPE_SUM: return "sum";
+    case TNN_MODULE_TYPE_BRANCH: return "branch";
+    case TNN_MODULE_TYPE_CONV1: return "conv1";
+    case TNN_MODULE_TYPE_CONV2: return "conv2";
+    default: return "module";
+    }
+  } else if(el->kind == TNN_PROFILE_KIND_LOSS){
+    switch(el->type){
+    case TNN_LOSS_TYPE_EUCLIDEAN: return "loss_euclidean";
+    case TNN_LOSS_TYPE_CROSSENTTROPY: return "loss_crossentropy";
+    default: return "loss";
+    }
+  } else {
+    switch(el->type){
+    case TNN_REG_TYPE_L1: return "reg_l1";
+    case TNN_REG_TYPE_L2: return "reg_l2";
+    default: return "reg";
+    }
+  }
+}
+
+//Name of the direction of an element
+static const char *tnn_profile_direction(tnn_profile_el *el, int d){
+  if(el->kind == TNN_PROFILE_KIND_REG){
+    return d == 0 ? "l" : "d";
+  }
+  return d == 0 ? "fprop" : "bprop";
+}
+
+//Sort records by descending time
+//A record holds a copy of the statistics, taken under the mutex of the element.
+typedef struct __STRUCT_tnn_profile_rec{
+  tnn_profile_el *el;
+  int d;
+  size_t count;
+  double time;
+  double flops;
+  double bytes;
+} tnn_profile_rec;
+static int tnn_profile_compare(const void *a, const void *b){
+  const tnn_profile_rec *ra, *rb;
+  ra = (const tnn_profile_rec*)a;
+  rb = (const tnn_profile_rec*)b;
+  if(ra->time > rb->time) return -1;
+  if(ra->time < rb->time) return 1;
+  return 0;
+}
+
+//Copy the statistics of an element in direction d to a record
+static void tnn_profile_snapshot(tnn_profile_el *el, int d, tnn_profile_rec *rec){
+  pthread_mutex_lock(&el->mutex);
+  rec->el = el;
+  rec->d = d;
+  rec->count = el->count[d];
+  rec->time = el->time[d];
+  rec->flops = el->flops[d];
+  rec->bytes = el->bytes[d];
+  pthread_mutex_unlock(&el->mutex);
+}
+
+//Initialize the profile
+tnn_error tnn_profile_init(tnn_profile *f){
+  f->els = NULL;
+  f->length = 0L;
+  return TNN_ERROR_SUCCESS;
+}
+
+//Profile a module
+tnn_error tnn_profile_add_module(tnn_profile *f, tnn_module *m){
+  tnn_profile_el *el;
+  tnn_error ret;
+
+  pthread_rwlock_wrlock(&tnn_profile_lock);
+  if((ret = tnn_profile_new(f, m, TNN_PROFILE_KIND_MODULE, m->t, &el)) == TNN_ERROR_SUCCESS){
+    m->pfprop = m->fprop;
+    m->pbprop = m->bprop;
+    if(m->fprop != NULL){
+      m->fprop = &tnn_profile_fprop_module;
+    }
+    if(m->bprop != NULL){
+      m->bprop = &tnn_profile_bprop_module;
+    }
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+
+//Profile all the modules of a machine (min, modules, mout)
+tnn_error tnn_profile_add_machine(tnn_profile *f, tnn_machine *m){
+  tnn_module *mod;
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_profile_add_module(f, &m->min), ret);
+  DL_FOREACH(m->m, mod){
+    TNN_MACRO_ERRORTEST(tnn_profile_add_module(f, mod), ret);
+  }
+  TNN_MACRO_ERRORTEST(tnn_profile_add_module(f, &m->mout), ret);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Profile a loss
+tnn_error tnn_profile_add_loss(tnn_profile *f, tnn_loss *l){
+  tnn_profile_el *el;
+  tnn_error ret;
+
+  pthread_rwlock_wrlock(&tnn_profile_lock);
+  if((ret = tnn_profile_new(f, l, TNN_PROFILE_KIND_LOSS, l->t, &el)) == TNN_ERROR_SUCCESS){
+    l->pfprop = l->fprop;
+    l->pbprop = l->bprop;
+    if(l->fprop != NULL){
+      l->fprop = &tnn_profile_fprop_loss;
+    }
+    if(l->bprop != NULL){
+      l->bprop = &tnn_profile_bprop_loss;
+    }
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+
+//Profile a regularizer
+tnn_error tnn_profile_add_reg(tnn_profile *f, tnn_reg *r){
+  tnn_profile_el *el;
+  tnn_error ret;
+
+  pthread_rwlock_wrlock(&tnn_profile_lock);
+  if((ret = tnn_profile_new(f, r, TNN_PROFILE_KIND_REG, r->t, &el)) == TNN_ERROR_SUCCESS){
+    r->pl = r->l;
+    r->pd = r->d;
+    if(r->l != NULL){
+      r->l = &tnn_profile_l_reg;
+    }
+    if(r->d != NULL){
+      r->d = &tnn_profile_d_reg;
+    }
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  return ret;
+}
+
+//Profile the machine, loss and regularizer of a trainer
+tnn_error tnn_profile_add_trainer_class(tnn_profile *f, tnn_trainer_class *t){
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_profile_add_machine(f, &t->m), ret);
+  TNN_MACRO_ERRORTEST(tnn_profile_add_loss(f, &t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_profile_add_reg(f, &t->r), ret);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Zero all the statistics
+tnn_error tnn_profile_reset(tnn_profile *f){
+  tnn_profile_el *el;
+  int d;
+
+  DL_FOREACH(f->els, el){
+    pthread_mutex_lock(&el->mutex);
+    for(d = 0; d < 2; d = d + 1){
+      el->count[d] = 0L;
+      el->time[d] = 0.0;
+      el->flops[d] = 0.0;
+      el->bytes[d] = 0.0;
+    }
+    pthread_mutex_unlock(&el->mutex);
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Print a report sorted by time
+tnn_error tnn_profile_report(tnn_profile *f, FILE *fp){
+  tnn_profile_rec *recs;
+  tnn_profile_el *el;
+  size_t i, n;
+  int d;
+  double total, time;
+
+  //Collect the records that were called at least once
+  if(f->length == 0L){
+    return TNN_ERROR_SUCCESS;
+  }
+  if((recs = (tnn_profile_rec*)malloc(2*f->length*sizeof(tnn_profile_rec))) == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  n = 0;
+  total = 0.0;
+  DL_FOREACH(f->els, el){
+    for(d = 0; d < 2; d = d + 1){
+      tnn_profile_snapshot(el, d, &recs[n]);
+      if(recs[n].count > 0){
+        total = total + recs[n].time;
+        n = n + 1;
+      }
+    }
+  }
+  qsort(recs, n, sizeof(tnn_profile_rec), &tnn_profile_compare);
+
+  //Print the table
+  fprintf(fp, "%5s %-18s %-5s %10s %12s %12s %7s %10s %10s\n",
+          "index", "object", "call", "count", "total(ms)", "avg(us)", "%time", "GFLOP/s", "GB/s");
+  for(i = 0; i < n; i = i + 1){
+    el = recs[i].el;
+    d = recs[i].d;
+    time = recs[i].time;
+    fprintf(fp, "%5ld %-18s %-5s %10ld %12.3f %12.3f %7.2f %10.3f %10.3f\n",
+            el->index, tnn_profile_name(el), tnn_profile_direction(el, d), recs[i].count,
+            1e3*time, 1e6*time/(double)recs[i].count, total > 0.0 ? 100.0*time/total : 0.0,
+            time > 0.0 ? 1e-9*recs[i].flops/time : 0.0, time > 0.0 ? 1e-9*recs[i].bytes/time : 0.0);
+  }
+  fprintf(fp, "Total: %.3f ms\n", 1e3*total);
+
+  free(recs);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Print the statistics as CSV, in the order of addition
+tnn_error tnn_profile_report_csv(tnn_profile *f, FILE *fp){
+  tnn_profile_rec rec;
+  tnn_profile_el *el;
+  int d;
+
+  fprintf(fp, "index,object,call,count,seconds,flops,bytes\n");
+  DL_FOREACH(f->els, el){
+    for(d = 0; d < 2; d = d + 1){
+      tnn_profile_snapshot(el, d, &rec);
+      fprintf(fp, "%ld,%s,%s,%ld,%.9g,%.17g,%.17g\n", el->index, tnn_profile_name(el),
+              tnn_profile_direction(el, d), rec.count, rec.time, rec.flops, rec.bytes);
+    }
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Restore the original methods of all profiled objects and free the profile
+tnn_error tnn_profile_destroy(tnn_profile *f){
+  tnn_profile_el *el, *tmp;
+  tnn_module *m;
+  tnn_loss *l;
+  tnn_reg *r;
+
+  pthread_rwlock_wrlock(&tnn_profile_lock);
+  DL_FOREACH_SAFE(f->els, el, tmp){
+    if(el->kind == TNN_PROFILE_KIND_MODULE){
+      m = (tnn_module*)el->key;
+      m->fprop = m->pfprop;
+      m->bprop = m->pbprop;
+    } else if(el->kind == TNN_PROFILE_KIND_LOSS){
+      l = (tnn_loss*)el->key;
+      l->fprop = l->pfprop;
+      l->bprop = l->pbprop;
+    } else {
+      r = (tnn_reg*)el->key;
+      r->l = r->pl;
+      r->d = r->pd;
+    }
+    HASH_DEL(tnn_profile_table, el);
+    DL_DELETE(f->els, el);
+    pthread_mutex_destroy(&el->mutex);
+    free(el);
+  }
+  pthread_rwlock_unlock(&tnn_profile_lock);
+  f->length = 0L;
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/* Thunder Neural Networks Profiler Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The profiler replaces the fprop/bprop methods of modules and losses (and the l/d methods of regularizers)
+ * by timing wrappers, and restores them when destroyed. Nothing is changed for objects that are not profiled,
+ * so there is no cost at all when profiling is off. The original methods are kept on the object itself, so a
+ * by-value copy of a profiled object (e.g. the loss of a trainer worker) runs normally but is not accounted.
+ * Profiles can be added and destroyed while other threads run profiled objects, and a profiled object can be
+ * run by several threads at once: each element has its own mutex, taken only to account a call, so threads
+ * running different objects do not contend.
+ *
+ * This header defines the following structures:
+ * tnn_profile_el(void *key, tnn_profile_kind kind, int type, size_t index, size_t count[2], double time[2], double flops[2], double bytes[2], pthread_mutex_t mutex, hh, prev, next)
+ * tnn_profile(tnn_profile_el *els, size_t length)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_profile_init(tnn_profile *f);
+ * tnn_error tnn_profile_add_module(tnn_profile *f, tnn_module *m);
+ * tnn_error tnn_profile_add_machine(tnn_profile *f, tnn_machine *m);
+ * tnn_error tnn_profile_add_loss(tnn_profile *f, tnn_loss *l);
+ * tnn_error tnn_profile_add_reg(tnn_profile *f, tnn_reg *r);
+ * tnn_error tnn_profile_add_trainer_class(tnn_profile *f, tnn_trainer_class *t);
+ * tnn_error tnn_profile_reset(tnn_profile *f);
+ * tnn_error tnn_profile_report(tnn_profile *f, FILE *fp);
+ * tnn_error tnn_profile_report_csv(tnn_profile *f, FILE *fp);
+ * tnn_error tnn_profile_destroy(tnn_profile *f);
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <tnn/uthash.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_trainer_class.h>
+
+#ifndef TNN_PROFILE_H
+#define TNN_PROFILE_H
+
+//Profiled object kinds
+typedef enum __ENUM_tnn_profile_kind{
+  TNN_PROFILE_KIND_MODULE, //Module: fprop and bprop
+  TNN_PROFILE_KIND_LOSS, //Loss: fprop and bprop
+  TNN_PROFILE_KIND_REG, //Regularizer: l and d
+
+  TNN_PROFILE_KIND_SIZE //Size indicator
+} tnn_profile_kind;
+
+//Element of the profile: statistics of one object. Index 0 is forward (fprop, l), 1 is backward (bprop, d).
+typedef struct __STRUCT_tnn_profile_el{
+  //Key of the element (the profiled object)
+  void *key;
+  //Kind of the object
+  tnn_profile_kind kind;
+  //Type of the object (module, loss or regularizer type)
+  int type;
+  //Order of addition to the profile
+  size_t index;
+  //Number of calls
+  size_t count[2];
+  //Wall-clock time in seconds
+  double time[2];
+  //Estimated floating-point operations
+  double flops[2];
+  //Estimated bytes moved
+  double bytes[2];
+  //Lock of the statistics
+  pthread_mutex_t mutex;
+  //UTHash handler (global table of profiled objects)
+  UT_hash_handle hh;
+  //UTList support (elements of one profile)
+  struct __STRUCT_tnn_profile_el *prev;
+  struct __STRUCT_tnn_profile_el *next;
+} tnn_profile_el;
+
+//The profile type
+typedef struct __STRUCT_tnn_profile{
+  //The elements
+  tnn_profile_el *els;
+  //The length
+  size_t length;
+} tnn_profile;
+
+//Initialize the profile
+tnn_error tnn_profile_init(tnn_profile *f);
+
+//Profile a module
+tnn_error tnn_profile_add_module(tnn_profile *f, tnn_module *m);
+
+//Profile all the modules of a machine (min, modules, mout)
+tnn_error tnn_profile_add_machine(tnn_profile *f, tnn_machine *m);
+
+//Profile a loss
+tnn_error tnn_profile_add_loss(tnn_profile *f, tnn_loss *l);
+
+//Profile a regularizer
+tnn_error tnn_profile_add_reg(tnn_profile *f, tnn_reg *r);
+
+//Profile the machine, loss and regularizer of a trainer (modules must be set up already)
+tnn_error tnn_profile_add_trainer_class(tnn_profile *f, tnn_trainer_class *t);
+
+//Zero all the statistics
+tnn_error tnn_profile_reset(tnn_profile *f);
+
+//Print a report sorted by time
+tnn_error tnn_profile_report(tnn_profile *f, FILE *fp);
+
+//Print the statistics as CSV, in the order of addition
+tnn_error tnn_profile_report_csv(tnn_profile *f, FILE *fp);
+
+//Restore the original methods of all profiled objects and free the profile
+//Must be called before the profiled objects are destroyed.
+tnn_error tnn_profile_destroy(tnn_profile *f);
+
+#endif //TNN_PROFILE_H
@@ -0,0 +1,460 @@
+/* Thunder Neural Networks Parameter Server Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_ps_init(tnn_ps *ps, tnn_param *p, double eta, size_t staleness, size_t n);
+ * tnn_error tnn_ps_serve(tnn_ps *ps);
+ * tnn_error tnn_ps_destroy(tnn_ps *ps);
+ * tnn_error tnn_ps_connect(tnn_ps *ps, size_t k, tnn_ps_worker *w);
+ * tnn_error tnn_ps_pull(tnn_ps_worker *w, tnn_param *p);
+ * tnn_error tnn_ps_push(tnn_ps_worker *w, double *g, bool *applied);
+ * tnn_error tnn_ps_done(tnn_ps_worker *w);
+ * tnn_error tnn_ps_train(tnn_ps_worker *w, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+ *                        size_t batch, size_t niter);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_ps.h>
+
+//Write n bytes to a socket. A closed peer gives an error (EPIPE) instead of SIGPIPE.
+static tnn_error tnn_ps_write(int fd, const void *buf, size_t n){
+  const char *c;
+  ssize_t k;
+
+  for(c = (const char *)buf; n > 0; c = c + k, n = n - (size_t)k){
+    k = send(fd, c, n, MSG_NOSIGNAL);
+    if(k < 0 && errno == EINTR){
+      k = 0;
+    } else if(k <= 0){
+      return TNN_ERROR_PS_IO;
+    }
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Read n bytes from a socket. *eof is set if it was closed before any byte was read.
+static tnn_error tnn_ps_read(int fd, void *buf, size_t n, bool *eof){
+  char *c;
+  ssize_t k;
+
+  *eof = false;
+  for(c = (char *)buf; n > 0; c = c + k, n = n - (size_t)k){
+    k = read(fd, c, n);
+    if(k < 0 && errno == EINTR){
+      k = 0;
+    } else if(k == 0 && c == (char *)buf){
+      *eof = true;
+      return TNN_ERROR_SUCCESS;
+    } else if(k <= 0){
+      return TNN_ERROR_PS_IO;
+    }
+  }
+  return TNN_ERROR_SUCCESS;
+}
+
+//Close a socket if it is open
+static void tnn_ps_close(int *fd){
+  if(*fd >= 0){
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+//Initialize a parameter server for n workers on the master parameter p
+tnn_error tnn_ps_init(tnn_ps *ps, tnn_param *p, double eta, size_t staleness, size_t n){
+  int sv[2];
+  size_t k;
+
+  //Check the parameters
+  if(n < 1 || eta < 0 || p->size == 0 || p->x->stride != 1){
+    return TNN_ERROR_PS_NVALIDP;
+  }
+
+  ps->p = p;
+  ps->eta = eta;
+  ps->staleness = staleness;
+  ps->n = n;
+  ps->version = 0;
+  ps->pushed = 0;
+  ps->dropped = 0;
+  ps->sfd = (int *) malloc(n*sizeof(int));
+  ps->wfd = (int *) malloc(n*sizeof(int));
+  ps->buf = (double *) malloc(p->size*sizeof(double));
+  if(ps->sfd == NULL || ps->wfd == NULL || ps->buf == NULL){
+    free(ps->sfd);
+    free(ps->wfd);
+    free(ps->buf);
+    ps->sfd = NULL;
+    ps->wfd = NULL;
+    ps->buf = NULL;
+    return TNN_ERROR_ALLOC;
+  }
+  for(k = 0; k < n; k = k + 1){
+    ps->sfd[k] = -1;
+    ps->wfd[k] = -1;
+  }
+
+  //Create the sockets
+  for(k = 0; k < n; k = k + 1){
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0){
+      tnn_ps_destroy(ps);
+      return TNN_ERROR_PS_IO;
+    }
+    ps->sfd[k] = sv[0];
+    ps->wfd[k] = sv[1];
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Handle one request on socket k. *open is cleared when the worker is done.
+static tnn_error tnn_ps_request(tnn_ps *ps, size_t k, bool *open){
+  tnn_ps_header h;
+  tnn_error ret;
+  double *restrict x, *restrict g;
+  double eta;
+  size_t i, n;
+  bool eof;
+
+  TNN_MACRO_ERRORTEST(tnn_ps_read(ps->sfd[k], &h, sizeof(tnn_ps_header), &eof), ret);
+  if(eof == true || h.op == TNN_PS_OP_DONE){
+    *open = false;
+    return TNN_ERROR_SUCCESS;
+  }
+  n = ps->p->size;
+
+  if(h.op == TNN_PS_OP_PULL){
+    h.status = 1;
+    h.version = ps->version;
+    h.size = n;
+    TNN_MACRO_ERRORTEST(tnn_ps_write(ps->sfd[k], &h, sizeof(tnn_ps_header)), ret);
+    return tnn_ps_write(ps->sfd[k], ps->p->x->data, n*sizeof(double));
+  } else if(h.op == TNN_PS_OP_PUSH && h.size == n){
+    TNN_MACRO_ERRORTEST(tnn_ps_read(ps->sfd[k], ps->buf, n*sizeof(double), &eof), ret);
+    if(eof == true){
+      return TNN_ERROR_PS_IO;
+    }
+    ps->pushed = ps->pushed + 1;
+    if(ps->version - (size_t)h.version <= ps->staleness){
+      x = ps->p->x->data;
+      g = ps->buf;
+      eta = ps->eta;
+      for(i = 0; i < n; i = i + 1){
+	x[i] = x[i] - eta*g[i];
+      }
+      ps->version = ps->version + 1;
+      h.status = 1;
+    } else {
+      ps->dropped = ps->dropped + 1;
+      h.status = 0;
+    }
+    h.version = ps->version;
+    h.size = 0;
+    return tnn_ps_write(ps->sfd[k], &h, sizeof(tnn_ps_header));
+  }
+
+  return TNN_ERROR_PS_IO;
+}
+
+//Serve the workers until all of them are done
+//A worker whose request fails (closed socket, read or write error, malformed request) is dropped, and the others
+//are still served.
+tnn_error tnn_ps_serve(tnn_ps *ps){
+  struct pollfd *fds;
+  tnn_error ret;
+  size_t k, left;
+  bool open;
+
+  //The worker ends belong to the worker processes
+  for(k = 0; k < ps->n; k = k + 1){
+    tnn_ps_close(&ps->wfd[k]);
+  }
+
+  fds = (struct pollfd *) malloc(ps->n*sizeof(struct pollfd));
+  if(fds == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+  for(left = 0, k = 0; k < ps->n; k = k + 1){
+    left = left + (ps->sfd[k] >= 0 ? 1 : 0);
+  }
+  while(left > 0 && ret == TNN_ERROR_SUCCESS){
+    for(k = 0; k < ps->n; k = k + 1){
+      fds[k].fd = ps->sfd[k];
+      fds[k].events = POLLIN;
+      fds[k].revents = 0;
+    }
+    if(poll(fds, (nfds_t)ps->n, -1) < 0){
+      if(errno == EINTR){
+	continue;
+      }
+      ret = TNN_ERROR_PS_IO;
+      break;
+    }
+
+    //Requests are handled in the order of the workers among those ready
+    for(k = 0; k < ps->n; k = k + 1){
+      if(ps->sfd[k] < 0 || fds[k].revents == 0){
+	continue;
+      }
+      open = true;
+      if(tnn_ps_request(ps, k, &open) != TNN_ERROR_SUCCESS || open == false){
+	tnn_ps_close(&ps->sfd[k]);
+	left = left - 1;
+      }
+    }
+  }
+
+  free(fds);
+  return ret;
+}
+
+//Destroy the parameter server
+tnn_error tnn_ps_destroy(tnn_ps *ps){
+  size_t k;
+
+  if(ps->sfd != NULL && ps->wfd != NULL){
+    for(k = 0; k < ps->n; k = k + 1){
+      tnn_ps_close(&ps->sfd[k]);
+      tnn_ps_close(&ps->wfd[k]);
+    }
+  }
+  free(ps->sfd);
+  free(ps->wfd);
+  free(ps->buf);
+  ps->sfd = NULL;
+  ps->wfd = NULL;
+  ps->buf = NULL;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Connect as worker k in a forked worker process
+tnn_error tnn_ps_connect(tnn_ps *ps, size_t k, tnn_ps_worker *w){
+  size_t i;
+
+  if(k >= ps->n || ps->wfd[k] < 0){
+    return TNN_ERROR_PS_NVALIDP;
+  }
+
+  w->fd = ps->wfd[k];
+  w->size = ps->p->size;
+  w->staleness = ps->staleness;
+  w->version = 0;
+  w->seen = 0;
+  w->pushed = 0;
+  w->dropped = 0;
+
+  //Keep only the worker end of socket k
+  ps->wfd[k] = -1;
+  for(i = 0; i < ps->n; i = i + 1){
+    tnn_ps_close(&ps->sfd[i]);
+    tnn_ps_close(&ps->wfd[i]);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Pull the master parameter into p->x
+tnn_error tnn_ps_pull(tnn_ps_worker *w, tnn_param *p){
+  tnn_ps_header h;
+  tnn_error ret;
+  bool eof;
+
+  if(p->size != w->size || p->x->stride != 1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  h.op = TNN_PS_OP_PULL;
+  h.status = 0;
+  h.version = 0;
+  h.size = 0;
+  TNN_MACRO_ERRORTEST(tnn_ps_write(w->fd, &h, sizeof(tnn_ps_header)), ret);
+  TNN_MACRO_ERRORTEST(tnn_ps_read(w->fd, &h, sizeof(tnn_ps_header), &eof), ret);
+  if(eof == true || h.size != w->size){
+    return TNN_ERROR_PS_IO;
+  }
+  TNN_MACRO_ERRORTEST(tnn_ps_read(w->fd, p->x->data, w->size*sizeof(double), &eof), ret);
+  if(eof == true){
+    return TNN_ERROR_PS_IO;
+  }
+  w->version = (size_t)h.version;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Push a gradient g computed on the version of the last pull
+tnn_error tnn_ps_push(tnn_ps_worker *w, double *g, bool *applied){
+  tnn_ps_header h;
+  tnn_error ret;
+  bool eof;
+
+  h.op = TNN_PS_OP_PUSH;
+  h.status = 0;
+  h.version = w->version;
+  h.size = w->size;
+  TNN_MACRO_ERRORTEST(tnn_ps_write(w->fd, &h, sizeof(tnn_ps_header)), ret);
+  TNN_MACRO_ERRORTEST(tnn_ps_write(w->fd, g, w->size*sizeof(double)), ret);
+  TNN_MACRO_ERRORTEST(tnn_ps_read(w->fd, &h, sizeof(tnn_ps_header), &eof), ret);
+  if(eof == true){
+    return TNN_ERROR_PS_IO;
+  }
+  *applied = (h.status == 1);
+  w->pushed = w->pushed + 1;
+  if(*applied == false){
+    w->dropped = w->dropped + 1;
+  }
+
+  //Server version after this push, to decide on the next pull
+  w->seen = (size_t)h.version;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Tell the server this worker is done
+tnn_error tnn_ps_done(tnn_ps_worker *w){
+  tnn_ps_header h;
+  tnn_error ret;
+
+  h.op = TNN_PS_OP_DONE;
+  h.status = 0;
+  h.version = w->version;
+  h.size = 0;
+  ret = tnn_ps_write(w->fd, &h, sizeof(tnn_ps_header));
+  tnn_ps_close(&w->fd);
+
+  return ret;
+}
+
+//Forward and backward propagate one sample, and store (first) or add its parameter gradient into g
+static tnn_error tnn_ps_sample(tnn_trainer_class *t, tnn_state *sin, tnn_param *p, gsl_vector *input,
+                               size_t label, double *g, int first){
+  gsl_vector_view lb;
+  tnn_error ret;
+  double *restrict gg, *restrict dx;
+  size_t i;
+
+  //Check the label
+  if(label >= t->lset->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  lb = gsl_matrix_row(t->lset, label);
+
+  //Copy the data into the input/label and do forward and backward propagation
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(input, &sin->x));
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&lb.vector, &t->label->x));
+  TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
+
+  //Accumulate the gradient
+  gg = g;
+  dx = p->dx->data;
+  if(first){
+    memcpy(gg, dx, p->size*sizeof(double));
+  } else {
+    for(i = 0; i < p->size; i = i + 1){
+      gg[i] = gg[i] + dx[i];
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Train on the samples as a worker
+tnn_error tnn_ps_train(tnn_ps_worker *w, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                       size_t batch, size_t niter){
+  tnn_state *sin;
+  tnn_param *p;
+  tnn_error ret;
+  gsl_vector_view in;
+  double *g, *restrict dx;
+  double a;
+  size_t s, b, i, j;
+  bool applied;
+
+  //Check the input
+  if(batch < 1 || inputs->size1 == 0){
+    return TNN_ERROR_PS_NVALIDP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin),ret);
+  if(inputs->size2 != sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  if(p->size != w->size || p->x->stride != 1 || p->dx->stride != 1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Set the loss output dx to be 1
+  gsl_vector_set(&t->l.output->dx, 0, 1.0);
+
+  g = (double *) malloc(p->size*sizeof(double));
+  if(g == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+
+  ret = tnn_ps_pull(w, p);
+  a = 1.0/(double)batch;
+  for(s = 0; s < niter && ret == TNN_ERROR_SUCCESS; s = s + 1){
+
+    //Average gradient of the batch
+    for(b = 0; b < batch && ret == TNN_ERROR_SUCCESS; b = b + 1){
+      j = (s*batch + b)%inputs->size1;
+      in = gsl_matrix_row(inputs, j);
+      ret = tnn_ps_sample(t, sin, p, &in.vector, labels[j], g, b == 0);
+    }
+    if(ret != TNN_ERROR_SUCCESS){
+      break;
+    }
+    for(i = 0; i < p->size; i = i + 1){
+      g[i] = a*g[i];
+    }
+
+    //Add the regularizer, using p->dx for its derivative
+    if(t->r.d != NULL && t->lambda != 0.0){
+      if((ret = tnn_reg_d(&t->r, p->x, p->dx)) != TNN_ERROR_SUCCESS){
+	break;
+      }
+      dx = p->dx->data;
+      for(i = 0; i < p->size; i = i + 1){
+	g[i] = g[i] + t->lambda*dx[i];
+      }
+    }
+
+    //Push, and pull again once the parameter held is too stale
+    if((ret = tnn_ps_push(w, g, &applied)) != TNN_ERROR_SUCCESS){
+      break;
+    }
+    if(applied == false || w->seen - w->version >= w->staleness){
+      ret = tnn_ps_pull(w, p);
+    }
+  }
+
+  free(g);
+  return ret;
+}
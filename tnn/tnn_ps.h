@@ -0,0 +1,122 @@
+/* Thunder Neural Networks Parameter Server Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A parameter server owns the master parameter of a machine and serves worker processes on the same host over
+ * Unix stream sockets. Workers pull the parameter, compute minibatch gradients on their own shard of the data,
+ * and push them back; the server applies each gradient pushed as x = x - eta*g in the order they arrive, and
+ * counts the updates as its version.
+ *
+ * Staleness is bounded: a gradient computed on version v is only applied while the server version is at most
+ * v + staleness, and dropped otherwise. A worker pulls again once the version it is working on is staleness
+ * updates behind, so with staleness 0 every step is taken on the current parameter.
+ *
+ * The sockets are created by tnn_ps_init, before forking the workers. Each worker process connects with its
+ * index, and the server process calls tnn_ps_serve, which returns once every worker is done.
+ *
+ * This header defines the following structures:
+ * tnn_ps(tnn_param *p, double eta, size_t staleness, size_t n, int *sfd, int *wfd, size_t version,
+ *        size_t pushed, size_t dropped, double *buf)
+ * tnn_ps_worker(int fd, size_t size, size_t staleness, size_t version, size_t seen, size_t pushed, size_t dropped)
+ * tnn_ps_header(uint32_t op, uint32_t status, uint64_t version, uint64_t size)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_ps_init(tnn_ps *ps, tnn_param *p, double eta, size_t staleness, size_t n);
+ * tnn_error tnn_ps_serve(tnn_ps *ps);
+ * tnn_error tnn_ps_destroy(tnn_ps *ps);
+ * tnn_error tnn_ps_connect(tnn_ps *ps, size_t k, tnn_ps_worker *w);
+ * tnn_error tnn_ps_pull(tnn_ps_worker *w, tnn_param *p);
+ * tnn_error tnn_ps_push(tnn_ps_worker *w, double *g, bool *applied);
+ * tnn_error tnn_ps_done(tnn_ps_worker *w);
+ * tnn_error tnn_ps_train(tnn_ps_worker *w, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+ *                        size_t batch, size_t niter);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_trainer_class.h>
+
+#ifndef TNN_PS_H
+#define TNN_PS_H
+
+//Requests of a worker
+#define TNN_PS_OP_PULL 1
+#define TNN_PS_OP_PUSH 2
+#define TNN_PS_OP_DONE 3
+
+//The parameter server type
+typedef struct __STRUCT_tnn_ps{
+  //Master parameter
+  tnn_param *p;
+  //Step size and staleness bound
+  double eta;
+  size_t staleness;
+  //Number of workers, and the server and worker ends of their sockets (-1 once closed)
+  size_t n;
+  int *sfd;
+  int *wfd;
+  //Updates applied, gradients received and gradients dropped for being too stale
+  size_t version;
+  size_t pushed;
+  size_t dropped;
+  //Receive buffer of p->size values
+  double *buf;
+} tnn_ps;
+
+//A connection of a worker process
+typedef struct __STRUCT_tnn_ps_worker{
+  //Socket to the server
+  int fd;
+  //Size of the parameter
+  size_t size;
+  //Staleness bound of the server
+  size_t staleness;
+  //Version of the last pull, version of the server after the last push, and the gradients pushed and dropped
+  size_t version;
+  size_t seen;
+  size_t pushed;
+  size_t dropped;
+} tnn_ps_worker;
+
+//Message header, followed by size values for pulls replied and pushes
+typedef struct __STRUCT_tnn_ps_header{
+  uint32_t op;
+  uint32_t status;
+  uint64_t version;
+  uint64_t size;
+} tnn_ps_header;
+
+//Initialize a parameter server for n workers on the master parameter p (which must not be reallocated)
+tnn_error tnn_ps_init(tnn_ps *ps, tnn_param *p, double eta, size_t staleness, size_t n);
+
+//Serve the workers until all of them are done (or have closed their socket). Called in the server process.
+//A worker whose request fails is dropped without stopping the others.
+tnn_error tnn_ps_serve(tnn_ps *ps);
+
+//Destroy the parameter server, closing the sockets left open in this process
+tnn_error tnn_ps_destroy(tnn_ps *ps);
+
+//Connect as worker k in a forked worker process. The sockets of the server and of the other workers are closed,
+//and ps must not be used further in this process.
+tnn_error tnn_ps_connect(tnn_ps *ps, size_t k, tnn_ps_worker *w);
+
+//Pull the master parameter into p->x
+tnn_error tnn_ps_pull(tnn_ps_worker *w, tnn_param *p);
+
+//Push a gradient g of the size of the parameter, computed on the version of the last pull
+tnn_error tnn_ps_push(tnn_ps_worker *w, double *g, bool *applied);
+
+//Tell the server this worker is done, and close the socket
+tnn_error tnn_ps_done(tnn_ps_worker *w);
+
+//Train on the samples as a worker: each of the niter steps pushes the average gradient of batch samples plus the
+//regularizer, taken in order from the rows of inputs. The parameter of the machine is pulled first, and again
+//whenever the version it holds is staleness updates behind the server.
+tnn_error tnn_ps_train(tnn_ps_worker *w, tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                       size_t batch, size_t niter);
+
+#endif //TNN_PS_H
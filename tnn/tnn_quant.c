@@ -0,0 +1,238 @@
+/* Thunder Neural Networks Quantization Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_quant_calibrate(tnn_machine *m, gsl_matrix *samples, gsl_vector *xmax);
+ * tnn_error tnn_quant_machine(tnn_machine *m, gsl_matrix *samples);
+ * tnn_error tnn_quant_save(tnn_machine *m, const char *file);
+ * tnn_error tnn_quant_load(tnn_machine *m, const char *file);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_module_linear_int8.h>
+#include <tnn/tnn_quant.h>
+
+//Next module in the sequence min, modules, mout
+static tnn_module *tnn_quant_next(tnn_machine *m, tnn_module *mod){
+  if(mod == &m->mout){
+    return NULL;
+  } else if(mod == &m->min){
+    return m->m != NULL ? m->m : &m->mout;
+  }
+  return mod->next != NULL ? mod->next : &m->mout;
+}
+
+//Number of modules in the machine
+static size_t tnn_quant_count(tnn_machine *m){
+  tnn_module *mod;
+  size_t n;
+
+  n = 0;
+  for(mod = &m->min; mod != NULL; mod = tnn_quant_next(m, mod)){
+    n = n + 1;
+  }
+  return n;
+}
+
+//Run the rows of samples through the machine and store in xmax the largest input magnitude of each module
+tnn_error tnn_quant_calibrate(tnn_machine *m, gsl_matrix *samples, gsl_vector *xmax){
+  tnn_error ret;
+  tnn_module *mod;
+  gsl_vector_view in;
+  size_t i, k;
+
+  if(samples->size2 != m->sin->size || xmax->size != tnn_quant_count(m)){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  gsl_vector_set_zero(xmax);
+  for(i = 0; i < samples->size1; i = i + 1){
+    in = gsl_matrix_row(samples, i);
+    TNN_MACRO_GSLTEST(gsl_blas_dcopy(&in.vector, &m->sin->x));
+    TNN_MACRO_ERRORTEST(tnn_machine_fprop(m), ret);
+    for(mod = &m->min, k = 0; mod != NULL; mod = tnn_quant_next(m, mod), k = k + 1){
+      if(mod->input != NULL && mod->input->valid == true){
+	gsl_vector_set(xmax, k, fmax(gsl_vector_get(xmax, k), fabs(gsl_vector_get(&mod->input->x, gsl_blas_idamax(&mod->input->x)))));
+      }
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Calibrate with the rows of samples and convert every linear module of the machine to int8
+tnn_error tnn_quant_machine(tnn_machine *m, gsl_matrix *samples){
+  tnn_error ret;
+  tnn_module *mod;
+  gsl_vector *xmax;
+  size_t k;
+
+  xmax = gsl_vector_alloc(tnn_quant_count(m));
+  if(xmax == NULL){
+    return TNN_ERROR_GSL;
+  }
+  if((ret = tnn_quant_calibrate(m, samples, xmax)) != TNN_ERROR_SUCCESS){
+    gsl_vector_free(xmax);
+    return ret;
+  }
+
+  for(mod = &m->min, k = 0; mod != NULL; mod = tnn_quant_next(m, mod), k = k + 1){
+    if(mod->t == TNN_MODULE_TYPE_LINEAR){
+      if((ret = tnn_module_quantize_linear(mod, gsl_vector_get(xmax, k))) != TNN_ERROR_SUCCESS){
+	gsl_vector_free(xmax);
+	return ret;
+      }
+    }
+  }
+
+  gsl_vector_free(xmax);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Save a quantized machine
+tnn_error tnn_quant_save(tnn_machine *m, const char *file){
+  tnn_quant_header h;
+  tnn_module_linear_int8 *c;
+  tnn_module *mod;
+  uint64_t r[3];
+  size_t i;
+  double x;
+  FILE *fp;
+  tnn_error ret;
+
+  fp = fopen(file, "wb");
+  if(fp == NULL){
+    return TNN_ERROR_FILE;
+  }
+
+  memcpy(h.magic, TNN_QUANT_FILE_MAGIC, 8);
+  h.version = TNN_QUANT_FILE_VERSION;
+  h.endian = TNN_QUANT_FILE_ENDIAN;
+  h.nmod = tnn_quant_count(m);
+  ret = fwrite(&h, sizeof(tnn_quant_header), 1, fp) == 1 ? TNN_ERROR_SUCCESS : TNN_ERROR_FILE;
+
+  for(mod = &m->min; mod != NULL && ret == TNN_ERROR_SUCCESS; mod = tnn_quant_next(m, mod)){
+    r[0] = (uint64_t)mod->t;
+    if(mod->t == TNN_MODULE_TYPE_LINEAR_INT8){
+      c = (tnn_module_linear_int8 *) mod->c;
+      r[1] = c->ninput;
+      r[2] = c->noutput;
+      if(fwrite(r, sizeof(uint64_t), 3, fp) != 3 || fwrite(&c->sx, sizeof(double), 1, fp) != 1
+	 || fwrite(c->scale, sizeof(double), c->noutput, fp) != c->noutput){
+	ret = TNN_ERROR_FILE;
+      }
+      for(i = 0; i < c->noutput && ret == TNN_ERROR_SUCCESS; i = i + 1){
+	if(fwrite(c->w + i*c->stride, sizeof(int8_t), c->ninput, fp) != c->ninput){
+	  ret = TNN_ERROR_FILE;
+	}
+      }
+    } else {
+      r[1] = mod->w.size;
+      r[2] = 0;
+      if(fwrite(r, sizeof(uint64_t), 3, fp) != 3){
+	ret = TNN_ERROR_FILE;
+      }
+      for(i = 0; i < mod->w.size && ret == TNN_ERROR_SUCCESS; i = i + 1){
+	x = gsl_vector_get(&mod->w.x, i);
+	if(fwrite(&x, sizeof(double), 1, fp) != 1){
+	  ret = TNN_ERROR_FILE;
+	}
+      }
+    }
+  }
+
+  if(fclose(fp) != 0 && ret == TNN_ERROR_SUCCESS){
+    ret = TNN_ERROR_FILE;
+  }
+  return ret;
+}
+
+//Load the record of an int8 linear module into mod, converting it from linear if needed
+static tnn_error tnn_quant_load_int8(tnn_module *mod, uint64_t *r, FILE *fp){
+  tnn_error ret;
+  tnn_module_linear_int8 *c;
+  size_t i;
+
+  if((mod->t != TNN_MODULE_TYPE_LINEAR && mod->t != TNN_MODULE_TYPE_LINEAR_INT8)
+     || r[1] != mod->input->size || r[2] != mod->output->size){
+    return TNN_ERROR_PARAM_INCOMP;
+  }
+  if(mod->t == TNN_MODULE_TYPE_LINEAR_INT8){
+    TNN_MACRO_ERRORTEST(tnn_module_destroy_linear_int8(mod), ret);
+  }
+  TNN_MACRO_ERRORTEST(tnn_module_linear_int8_alloc(mod, mod->input->size, mod->output->size), ret);
+
+  c = (tnn_module_linear_int8 *) mod->c;
+  if(fread(&c->sx, sizeof(double), 1, fp) != 1 || fread(c->scale, sizeof(double), c->noutput, fp) != c->noutput){
+    return TNN_ERROR_FILE;
+  }
+  for(i = 0; i < c->noutput; i = i + 1){
+    if(fread(c->w + i*c->stride, sizeof(int8_t), c->ninput, fp) != c->ninput){
+      return TNN_ERROR_FILE;
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Load a quantized machine into a machine of the same structure
+tnn_error tnn_quant_load(tnn_machine *m, const char *file){
+  tnn_quant_header h;
+  tnn_module *mod;
+  uint64_t r[3];
+  size_t i;
+  double x;
+  FILE *fp;
+  tnn_error ret;
+
+  fp = fopen(file, "rb");
+  if(fp == NULL){
+    return TNN_ERROR_FILE;
+  }
+
+  //Check the header
+  ret = TNN_ERROR_SUCCESS;
+  if(fread(&h, sizeof(tnn_quant_header), 1, fp) != 1){
+    ret = TNN_ERROR_FILE;
+  } else if(memcmp(h.magic, TNN_QUANT_FILE_MAGIC, 8) != 0 || h.version != TNN_QUANT_FILE_VERSION
+            || h.endian != TNN_QUANT_FILE_ENDIAN){
+    ret = TNN_ERROR_FILE_FORMAT;
+  } else if(h.nmod != tnn_quant_count(m)){
+    ret = TNN_ERROR_PARAM_INCOMP;
+  }
+
+  //Read the modules
+  for(mod = &m->min; mod != NULL && ret == TNN_ERROR_SUCCESS; mod = tnn_quant_next(m, mod)){
+    if(fread(r, sizeof(uint64_t), 3, fp) != 3){
+      ret = TNN_ERROR_FILE;
+    } else if(r[0] == TNN_MODULE_TYPE_LINEAR_INT8){
+      ret = tnn_quant_load_int8(mod, r, fp);
+    } else if(r[0] != (uint64_t)mod->t || r[1] != mod->w.size){
+      ret = TNN_ERROR_PARAM_INCOMP;
+    } else {
+      for(i = 0; i < mod->w.size && ret == TNN_ERROR_SUCCESS; i = i + 1){
+	if(fread(&x, sizeof(double), 1, fp) != 1){
+	  ret = TNN_ERROR_FILE;
+	} else {
+	  gsl_vector_set(&mod->w.x, i, x);
+	}
+      }
+    }
+  }
+
+  fclose(fp);
+  return ret;
+}
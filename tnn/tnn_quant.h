@@ -0,0 +1,64 @@
+/* Thunder Neural Networks Quantization Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * Post-training quantization converts the linear modules of a trained machine to int8 linear modules for
+ * inference. Calibration runs sample inputs through tnn_machine_fprop and records the largest input magnitude
+ * of each linear module, which sets its input scale. The quantized machine is saved with the int8 weights
+ * and scales, and the other modules' parameters as they are, and loaded back into a machine of the same
+ * structure built in code. The double weights of a converted module stay in the machine's parameter (see
+ * tnn_module_linear_int8.h), so its memory is not reduced.
+ *
+ * This header defines the following structure:
+ * tnn_quant_header(char magic[8], uint32_t version, uint32_t endian, uint64_t nmod)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_quant_calibrate(tnn_machine *m, gsl_matrix *samples, gsl_vector *xmax);
+ * tnn_error tnn_quant_machine(tnn_machine *m, gsl_matrix *samples);
+ * tnn_error tnn_quant_save(tnn_machine *m, const char *file);
+ * tnn_error tnn_quant_load(tnn_machine *m, const char *file);
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_machine.h>
+
+#ifndef TNN_QUANT_H
+#define TNN_QUANT_H
+
+//Quantized machine file format: header, then for each module in order from min to mout, a record of
+//(type, n1, n2) as uint64 followed by its data. An int8 linear module (n1 inputs, n2 outputs) stores the input
+//scale, the n2 row scales as doubles and the n2 rows of n1 int8 weights. Other modules store their n1 weights.
+#define TNN_QUANT_FILE_MAGIC "TNNQUANT"
+#define TNN_QUANT_FILE_VERSION 1
+#define TNN_QUANT_FILE_ENDIAN 0x01020304
+
+//Quantized machine file header
+typedef struct __STRUCT_tnn_quant_header{
+  //Magic string TNN_QUANT_FILE_MAGIC (without the terminating zero)
+  char magic[8];
+  //File version
+  uint32_t version;
+  //TNN_QUANT_FILE_ENDIAN in the byte order of the writer
+  uint32_t endian;
+  //Number of modules
+  uint64_t nmod;
+} tnn_quant_header;
+
+//Run the rows of samples through the machine and store in xmax the largest input magnitude of each module
+//xmax has one element per module in order from min to mout.
+tnn_error tnn_quant_calibrate(tnn_machine *m, gsl_matrix *samples, gsl_vector *xmax);
+
+//Calibrate with the rows of samples and convert every linear module of the machine to int8
+tnn_error tnn_quant_machine(tnn_machine *m, gsl_matrix *samples);
+
+//Save a quantized machine
+tnn_error tnn_quant_save(tnn_machine *m, const char *file);
+
+//Load a quantized machine into a machine of the same structure
+tnn_error tnn_quant_load(tnn_machine *m, const char *file);
+
+#endif //TNN_QUANT_H
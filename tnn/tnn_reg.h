@@ -53,6 +53,9 @@ typedef struct __STRUCT_tnn_reg{
   TNN_REG_FUNC_DEBUG debug;
   //Destroy method
   TNN_REG_FUNC_DESTROY destroy;
+  //Original loss and derivative methods while profiled (see tnn_profile.h)
+  TNN_REG_FUNC_L pl;
+  TNN_REG_FUNC_D pd;
 } tnn_reg;
 
 //Polymorphically compute the loss of the regularizer
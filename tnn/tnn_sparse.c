@@ -0,0 +1,145 @@
+/* Thunder Neural Networks Sparse Matrix Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_sparse_init(tnn_sparse *s, size_t size2, size_t cap);
+ * tnn_error tnn_sparse_append(tnn_sparse *s, size_t j, double v);
+ * tnn_error tnn_sparse_end_row(tnn_sparse *s);
+ * tnn_error tnn_sparse_from_matrix(tnn_sparse *s, gsl_matrix *m);
+ * tnn_error tnn_sparse_row_nnz(tnn_sparse *s, size_t i, size_t *nnz);
+ * tnn_error tnn_sparse_destroy(tnn_sparse *s);
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_sparse.h>
+
+//Initialize an empty sparse matrix with size2 columns and room for cap nonzeros
+tnn_error tnn_sparse_init(tnn_sparse *s, size_t size2, size_t cap){
+  if(cap < 1){
+    cap = 1;
+  }
+
+  s->size1 = 0;
+  s->size2 = size2;
+  s->nnz = 0;
+  s->rcap = 16;
+  s->cap = cap;
+  s->ptr = (size_t *) malloc((s->rcap + 1)*sizeof(size_t));
+  s->ind = (size_t *) malloc(cap*sizeof(size_t));
+  s->val = (double *) malloc(cap*sizeof(double));
+  if(s->ptr == NULL || s->ind == NULL || s->val == NULL){
+    free(s->ptr);
+    free(s->ind);
+    free(s->val);
+    return TNN_ERROR_ALLOC;
+  }
+  s->ptr[0] = 0;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Append the value v at column j to the row being built
+tnn_error tnn_sparse_append(tnn_sparse *s, size_t j, double v){
+  size_t *ind;
+  double *val;
+
+  //Columns must be increasing within a row
+  if(j >= s->size2 || (s->nnz > s->ptr[s->size1] && j <= s->ind[s->nnz - 1])){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Grow geometrically
+  if(s->nnz == s->cap){
+    ind = (size_t *) realloc(s->ind, 2*s->cap*sizeof(size_t));
+    if(ind == NULL){
+      return TNN_ERROR_ALLOC;
+    }
+    s->ind = ind;
+    val = (double *) realloc(s->val, 2*s->cap*sizeof(double));
+    if(val == NULL){
+      return TNN_ERROR_ALLOC;
+    }
+    s->val = val;
+    s->cap = 2*s->cap;
+  }
+
+  s->ind[s->nnz] = j;
+  s->val[s->nnz] = v;
+  s->nnz = s->nnz + 1;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Finish the row being built
+tnn_error tnn_sparse_end_row(tnn_sparse *s){
+  size_t *ptr;
+
+  if(s->size1 == s->rcap){
+    ptr = (size_t *) realloc(s->ptr, (2*s->rcap + 1)*sizeof(size_t));
+    if(ptr == NULL){
+      return TNN_ERROR_ALLOC;
+    }
+    s->ptr = ptr;
+    s->rcap = 2*s->rcap;
+  }
+
+  s->size1 = s->size1 + 1;
+  s->ptr[s->size1] = s->nnz;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Initialize a sparse matrix from the nonzeros of a dense one
+tnn_error tnn_sparse_from_matrix(tnn_sparse *s, gsl_matrix *m){
+  tnn_error ret;
+  size_t i, j, n;
+
+  //Count the nonzeros
+  n = 0;
+  for(i = 0; i < m->size1; i = i + 1){
+    for(j = 0; j < m->size2; j = j + 1){
+      if(gsl_matrix_get(m, i, j) != 0.0){
+	n = n + 1;
+      }
+    }
+  }
+
+  TNN_MACRO_ERRORTEST(tnn_sparse_init(s, m->size2, n), ret);
+  for(i = 0; i < m->size1; i = i + 1){
+    for(j = 0; j < m->size2; j = j + 1){
+      if(gsl_matrix_get(m, i, j) != 0.0){
+	TNN_MACRO_ERRORTEST(tnn_sparse_append(s, j, gsl_matrix_get(m, i, j)), ret);
+      }
+    }
+    TNN_MACRO_ERRORTEST(tnn_sparse_end_row(s), ret);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the number of nonzeros in row i
+tnn_error tnn_sparse_row_nnz(tnn_sparse *s, size_t i, size_t *nnz){
+  if(i >= s->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  *nnz = s->ptr[i + 1] - s->ptr[i];
+  return TNN_ERROR_SUCCESS;
+}
+
+//Destroy the sparse matrix
+tnn_error tnn_sparse_destroy(tnn_sparse *s){
+  free(s->ptr);
+  free(s->ind);
+  free(s->val);
+  s->ptr = NULL;
+  s->ind = NULL;
+  s->val = NULL;
+  s->size1 = 0;
+  s->nnz = 0;
+  return TNN_ERROR_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/* Thunder Neural Networks Sparse Matrix Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A sparse matrix holds a batch of sparse samples in compressed sparse row (CSR) form. The nonzeros of row i
+ * are at positions ptr[i] to ptr[i+1] - 1 of ind (column indices) and val (values). Rows are appended one at a
+ * time, so the matrix can be filled while parsing. Column indices must be increasing within a row.
+ *
+ * This header defines the following structure:
+ * tnn_sparse(size_t size1, size_t size2, size_t nnz, size_t *ptr, size_t *ind, double *val,
+ *            size_t rcap, size_t cap)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_sparse_init(tnn_sparse *s, size_t size2, size_t cap);
+ * tnn_error tnn_sparse_append(tnn_sparse *s, size_t j, double v);
+ * tnn_error tnn_sparse_end_row(tnn_sparse *s);
+ * tnn_error tnn_sparse_from_matrix(tnn_sparse *s, gsl_matrix *m);
+ * tnn_error tnn_sparse_row_nnz(tnn_sparse *s, size_t i, size_t *nnz);
+ * tnn_error tnn_sparse_destroy(tnn_sparse *s);
+ */
+
+#include <stddef.h>
+#include <gsl/gsl_matrix.h>
+#include <tnn/tnn_error.h>
+
+#ifndef TNN_SPARSE_H
+#define TNN_SPARSE_H
+
+//The sparse matrix type
+typedef struct __STRUCT_tnn_sparse{
+  //Number of rows and columns
+  size_t size1;
+  size_t size2;
+  //Number of nonzeros
+  size_t nnz;
+  //Row pointers (size1 + 1 of them), column indices and values
+  size_t *ptr;
+  size_t *ind;
+  double *val;
+  //Capacity of ptr (in rows) and of ind and val (in nonzeros)
+  size_t rcap;
+  size_t cap;
+} tnn_sparse;
+
+//Initialize an empty sparse matrix with size2 columns and room for cap nonzeros
+tnn_error tnn_sparse_init(tnn_sparse *s, size_t size2, size_t cap);
+
+//Append the value v at column j to the row being built
+tnn_error tnn_sparse_append(tnn_sparse *s, size_t j, double v);
+
+//Finish the row being built
+tnn_error tnn_sparse_end_row(tnn_sparse *s);
+
+//Initialize a sparse matrix from the nonzeros of a dense one
+tnn_error tnn_sparse_from_matrix(tnn_sparse *s, gsl_matrix *m);
+
+//Get the number of nonzeros in row i
+tnn_error tnn_sparse_row_nnz(tnn_sparse *s, size_t i, size_t *nnz);
+
+//Destroy the sparse matrix
+tnn_error tnn_sparse_destroy(tnn_sparse *s);
+
+#endif //TNN_SPARSE_H
@@ -6,6 +6,7 @@
  * tnn_error tnn_state_init(tnn_state *s, size_t n);
  * tnn_error tnn_state_debug(tnn_state *s);
  * tnn_error tnn_state_copy(tnn_state *s, tnn_state *t);
+ * tnn_error tnn_state_share(tnn_state *s, tnn_state *t);
  */
 
 #include <stddef.h>
@@ -60,3 +61,22 @@ tnn_error tnn_state_copy(tnn_state *s, tnn_state *t){
 
   return TNN_ERROR_SUCCESS;
 }
+
+tnn_error tnn_state_share(tnn_state *s, tnn_state *t){
+  //Check validity
+  if(s->valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+
+  //Share the vectors, but not the list links
+  t->x = s->x;
+  t->dx = s->dx;
+  t->size = s->size;
+  t->valid = true;
+  t->parent = NULL;
+  t->offset = 0L;
+  t->prev = NULL;
+  t->next = NULL;
+
+  return TNN_ERROR_SUCCESS;
+}
@@ -9,6 +9,7 @@
  * tnn_error tnn_state_init(tnn_state *s, size_t n);
  * tnn_error tnn_state_debug(tnn_state *s);
  * tnn_error tnn_state_copy(tnn_state *s, tnn_state *t);
+ * tnn_error tnn_state_share(tnn_state *s, tnn_state *t);
  */
 
 #include <stddef.h>
@@ -48,4 +49,8 @@ tnn_error tnn_state_debug(tnn_state *s);
 //Copy a state to another state: both must be valid
 tnn_error tnn_state_copy(tnn_state *s, tnn_state *t);
 
+//Make t a view of the storage of s: t is valid but not allocated in any parameter
+//t becomes invalid when the parameter holding s is reallocated or destroyed.
+tnn_error tnn_state_share(tnn_state *s, tnn_state *t);
+
 #endif //TNN_STATE_H
@@ -0,0 +1,121 @@
+/* Thunder Neural Networks Stream Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_stream_init(tnn_stream *st, tnn_dataset *ds, size_t block, size_t pool, unsigned long seed);
+ * tnn_error tnn_stream_fetch(void *src, size_t i, gsl_vector *x, size_t *label);
+ * tnn_error tnn_stream_destroy(tnn_stream *st);
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_permutation.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_stream.h>
+
+tnn_error tnn_stream_init(tnn_stream *st, tnn_dataset *ds, size_t block, size_t pool, unsigned long seed){
+  if(block < 1 || pool < 1 || ds->inputs.size1 < 1){
+    return TNN_ERROR_STREAM_NVALIDP;
+  }
+
+  st->ds = ds;
+  st->block = block < ds->inputs.size1 ? block : ds->inputs.size1;
+  st->nblock = (ds->inputs.size1 + st->block - 1)/st->block;
+  st->pool = pool < st->nblock ? pool : st->nblock;
+  st->count = 0;
+  st->seed = seed;
+  st->next = st->nblock;
+  st->epoch = (size_t)-1;
+
+  //Pool and generator
+  st->x = (double *) malloc(st->pool*st->block*ds->inputs.size2*sizeof(double));
+  st->labels = (size_t *) malloc(st->pool*st->block*sizeof(size_t));
+  st->rng = gsl_rng_alloc(gsl_rng_mt19937);
+  st->order = gsl_permutation_alloc(st->nblock);
+  if(st->x == NULL || st->labels == NULL || st->rng == NULL || st->order == NULL){
+    tnn_stream_destroy(st);
+    return TNN_ERROR_ALLOC;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_stream_fetch(void *src, size_t i, gsl_vector *x, size_t *label){
+  tnn_stream *st;
+  gsl_vector_view row;
+  size_t size2, b, n, r;
+  tnn_error ret;
+
+  st = (tnn_stream *) src;
+  size2 = st->ds->inputs.size2;
+  if(i >= st->ds->inputs.size1 || x->size != size2){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //A new epoch starts with an empty pool and a new block order
+  if(i == 0){
+    st->epoch = st->epoch + 1;
+    gsl_permutation_init(st->order);
+    gsl_rng_set(st->rng, st->seed + st->epoch);
+    gsl_ran_shuffle(st->rng, st->order->data, st->nblock, sizeof(size_t));
+    st->next = 0;
+    st->count = 0;
+  }
+
+  //Read the next blocks while they fit
+  while(st->next < st->nblock){
+    b = gsl_permutation_get(st->order, st->next);
+    n = (b + 1)*st->block <= st->ds->inputs.size1 ? st->block : st->ds->inputs.size1 - b*st->block;
+    if(st->count + n > st->pool*st->block){
+      break;
+    }
+    TNN_MACRO_ERRORTEST(tnn_dataset_read(st->ds, b*st->block, n, st->x + st->count*size2,
+					 st->labels + st->count), ret);
+    st->count = st->count + n;
+    st->next = st->next + 1;
+  }
+  if(st->count == 0){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Draw a row and fill its place with the last one
+  r = gsl_rng_uniform_int(st->rng, st->count);
+  row = gsl_vector_view_array(st->x + r*size2, size2);
+  TNN_MACRO_GSLTEST(gsl_vector_memcpy(x, &row.vector));
+  *label = st->labels[r];
+  st->count = st->count - 1;
+  if(r != st->count){
+    memcpy(st->x + r*size2, st->x + st->count*size2, size2*sizeof(double));
+    st->labels[r] = st->labels[st->count];
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+tnn_error tnn_stream_destroy(tnn_stream *st){
+  if(st->x != NULL){
+    free(st->x);
+  }
+  if(st->labels != NULL){
+    free(st->labels);
+  }
+  if(st->rng != NULL){
+    gsl_rng_free(st->rng);
+  }
+  if(st->order != NULL){
+    gsl_permutation_free(st->order);
+  }
+  st->x = NULL;
+  st->labels = NULL;
+  st->rng = NULL;
+  st->order = NULL;
+
+  return TNN_ERROR_SUCCESS;
+}
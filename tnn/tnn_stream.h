@@ -0,0 +1,68 @@
+/* Thunder Neural Networks Stream Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A stream is a loader source that shuffles a dataset larger than memory without random reads. The rows are
+ * cut into blocks of contiguous rows, and every epoch reads the blocks in a random order into a pool of a few
+ * blocks. Each sample is drawn at random from the pool, and a new block is read whenever there is room for
+ * it. Disk reads stay sequential inside a block and memory stays bounded by the pool, while the samples come
+ * in nearly independent order. Every epoch visits every row once, and the order of epoch e only depends on
+ * seed + e.
+ *
+ * A stream feeds a trainer through a loader with tnn_stream_fetch, which must be the only reader. The epoch
+ * counter starts from 0 at init, so a resumed training replays the order of the first epoch.
+ *
+ * This header defines the following structures:
+ * tnn_stream(tnn_dataset *ds, size_t block, size_t nblock, size_t pool, double *x, size_t *labels,
+ *            size_t count, gsl_rng *rng, unsigned long seed, gsl_permutation *order, size_t next,
+ *            size_t epoch)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_stream_init(tnn_stream *st, tnn_dataset *ds, size_t block, size_t pool, unsigned long seed);
+ * tnn_error tnn_stream_fetch(void *src, size_t i, gsl_vector *x, size_t *label);
+ * tnn_error tnn_stream_destroy(tnn_stream *st);
+ */
+
+#include <stddef.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_permutation.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_dataset.h>
+
+#ifndef TNN_STREAM_H
+#define TNN_STREAM_H
+
+//The stream type
+typedef struct __STRUCT_tnn_stream{
+  //The dataset read
+  tnn_dataset *ds;
+  //Rows in a block and number of blocks
+  size_t block;
+  size_t nblock;
+  //Capacity of the pool in blocks
+  size_t pool;
+  //Pool rows and labels, and number of rows in the pool
+  double *x;
+  size_t *labels;
+  size_t count;
+  //Generator of the block orders and samples, and its seed
+  gsl_rng *rng;
+  unsigned long seed;
+  //Block order of the current epoch and the next block of it to read
+  gsl_permutation *order;
+  size_t next;
+  //Current epoch: (size_t)-1 before the first sample
+  size_t epoch;
+} tnn_stream;
+
+//Initialize a stream over ds with blocks of block rows and a pool of pool blocks
+tnn_error tnn_stream_init(tnn_stream *st, tnn_dataset *ds, size_t block, size_t pool, unsigned long seed);
+
+//Fetch function for a tnn_stream source. Sample i is the i-th drawn in its epoch.
+tnn_error tnn_stream_fetch(void *src, size_t i, gsl_vector *x, size_t *label);
+
+//Destroy the stream. The dataset is not closed.
+tnn_error tnn_stream_destroy(tnn_stream *st);
+
+#endif //TNN_STREAM_H
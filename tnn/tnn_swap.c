@@ -0,0 +1,142 @@
+/* Thunder Neural Networks Hot Swap Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_swap_init(tnn_swap *s, tnn_machine *m);
+ * tnn_error tnn_swap_reader_init(tnn_swap *s, tnn_swap_reader *r);
+ * tnn_error tnn_swap_fprop(tnn_swap *s, tnn_swap_reader *r, gsl_vector *input, gsl_vector *output);
+ * tnn_error tnn_swap_shadow(tnn_swap *s, tnn_param **p);
+ * tnn_error tnn_swap_publish(tnn_swap *s);
+ * tnn_error tnn_swap_update(tnn_swap *s, gsl_vector *w);
+ * tnn_error tnn_swap_get_machine(tnn_swap *s, tnn_machine **m);
+ * tnn_error tnn_swap_reader_destroy(tnn_swap_reader *r);
+ * tnn_error tnn_swap_destroy(tnn_swap *s);
+ */
+
+#include <stddef.h>
+#include <sched.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_state.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_swap.h>
+
+//Initialize the swap from a built machine
+tnn_error tnn_swap_init(tnn_swap *s, tnn_machine *m){
+  tnn_error ret;
+
+  //The second buffer is a clone, so both start with the same weights
+  TNN_MACRO_ERRORTEST(tnn_machine_clone(m, &s->b, NULL), ret);
+  s->m[0] = m;
+  s->m[1] = &s->b;
+  s->cur = 0;
+  s->readers[0] = 0L;
+  s->readers[1] = 0L;
+  __sync_synchronize();
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Initialize a reader
+tnn_error tnn_swap_reader_init(tnn_swap *s, tnn_swap_reader *r){
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_machine_replica(s->m[0], &r->r[0], NULL), ret);
+  if((ret = tnn_machine_replica(s->m[1], &r->r[1], NULL)) != TNN_ERROR_SUCCESS){
+    tnn_machine_destroy(&r->r[0]);
+    return ret;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Run the current machine on input and store the result in output
+tnn_error tnn_swap_fprop(tnn_swap *s, tnn_swap_reader *r, gsl_vector *input, gsl_vector *output){
+  tnn_state *sin, *sout;
+  tnn_error ret;
+  int i;
+
+  //Enter the current buffer. If a publish happened in between, leave and retry on the new one.
+  while(1){
+    i = s->cur;
+    __sync_fetch_and_add(&s->readers[i], 1);
+    if(i == s->cur){
+      break;
+    }
+    __sync_fetch_and_sub(&s->readers[i], 1);
+  }
+
+  //Run the replica of this buffer
+  tnn_machine_get_sin(&r->r[i], &sin);
+  tnn_machine_get_sout(&r->r[i], &sout);
+  if(input->size != sin->size || output->size != sout->size){
+    __sync_fetch_and_sub(&s->readers[i], 1);
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  gsl_vector_memcpy(&sin->x, input);
+  ret = tnn_machine_fprop(&r->r[i]);
+  if(ret == TNN_ERROR_SUCCESS){
+    gsl_vector_memcpy(output, &sout->x);
+  }
+
+  //Leave the buffer
+  __sync_fetch_and_sub(&s->readers[i], 1);
+
+  return ret;
+}
+
+//Wait until no reader uses the shadow buffer and get its parameter for writing
+tnn_error tnn_swap_shadow(tnn_swap *s, tnn_param **p){
+  int i;
+
+  i = 1 - s->cur;
+  while(__sync_fetch_and_add(&s->readers[i], 0) != 0){
+    sched_yield();
+  }
+  return tnn_machine_get_param(s->m[i], p);
+}
+
+//Publish the shadow buffer as the current one
+tnn_error tnn_swap_publish(tnn_swap *s){
+  //Make the weights visible before the index
+  __sync_synchronize();
+  s->cur = 1 - s->cur;
+  __sync_synchronize();
+  return TNN_ERROR_SUCCESS;
+}
+
+//Copy w into the shadow buffer and publish it
+tnn_error tnn_swap_update(tnn_swap *s, gsl_vector *w){
+  tnn_param *p;
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_swap_shadow(s, &p), ret);
+  if(w->size != p->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  gsl_vector_memcpy(p->x, w);
+  return tnn_swap_publish(s);
+}
+
+//Get the machine of the current buffer
+tnn_error tnn_swap_get_machine(tnn_swap *s, tnn_machine **m){
+  *m = s->m[s->cur];
+  return TNN_ERROR_SUCCESS;
+}
+
+//Destroy a reader
+tnn_error tnn_swap_reader_destroy(tnn_swap_reader *r){
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_machine_destroy(&r->r[0]), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_destroy(&r->r[1]), ret);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Destroy the swap
+tnn_error tnn_swap_destroy(tnn_swap *s){
+  return tnn_machine_destroy(&s->b);
+}
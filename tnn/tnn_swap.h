@@ -0,0 +1,83 @@
+/* Thunder Neural Networks Hot Swap Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * A swap holds two machines with identical structure, one per weight buffer. Each reader owns a replica of
+ * both, so publishing new weights only flips an index: no tnn_state view is ever reallocated or re-pointed.
+ * Readers entering after a publish use the new buffer, while those in flight finish on the old one. The
+ * writer waits for the old buffer to drain before writing to it again (read-copy-update with two versions).
+ *
+ * There can be any number of concurrent readers, but only one writer at a time.
+ *
+ * This header defines the following structures:
+ * tnn_swap(tnn_machine *m[2], tnn_machine b, int cur, size_t readers[2])
+ * tnn_swap_reader(tnn_machine r[2])
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_swap_init(tnn_swap *s, tnn_machine *m);
+ * tnn_error tnn_swap_reader_init(tnn_swap *s, tnn_swap_reader *r);
+ * tnn_error tnn_swap_fprop(tnn_swap *s, tnn_swap_reader *r, gsl_vector *input, gsl_vector *output);
+ * tnn_error tnn_swap_shadow(tnn_swap *s, tnn_param **p);
+ * tnn_error tnn_swap_publish(tnn_swap *s);
+ * tnn_error tnn_swap_update(tnn_swap *s, gsl_vector *w);
+ * tnn_error tnn_swap_get_machine(tnn_swap *s, tnn_machine **m);
+ * tnn_error tnn_swap_reader_destroy(tnn_swap_reader *r);
+ * tnn_error tnn_swap_destroy(tnn_swap *s);
+ */
+
+#include <stddef.h>
+#include <gsl/gsl_vector.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_param.h>
+#include <tnn/tnn_machine.h>
+
+#ifndef TNN_SWAP_H
+#define TNN_SWAP_H
+
+//The swap type
+typedef struct __STRUCT_tnn_swap{
+  //Machines of the two buffers. m[0] is the user's machine.
+  tnn_machine *m[2];
+  //Storage of the second machine (a clone of the first)
+  tnn_machine b;
+  //Index of the current buffer
+  volatile int cur;
+  //Number of readers in each buffer
+  volatile size_t readers[2];
+} tnn_swap;
+
+//The reader type: replicas of the two machines owned by one thread
+typedef struct __STRUCT_tnn_swap_reader{
+  tnn_machine r[2];
+} tnn_swap_reader;
+
+//Initialize the swap from a built machine, whose weights become the current buffer
+//The machine must outlive the swap and must not be changed directly afterwards.
+tnn_error tnn_swap_init(tnn_swap *s, tnn_machine *m);
+
+//Initialize a reader (one per thread)
+tnn_error tnn_swap_reader_init(tnn_swap *s, tnn_swap_reader *r);
+
+//Run the current machine on input and store the result in output
+tnn_error tnn_swap_fprop(tnn_swap *s, tnn_swap_reader *r, gsl_vector *input, gsl_vector *output);
+
+//Wait until no reader uses the shadow buffer and get its parameter for writing
+//All of the weights must be written: the shadow buffer holds the weights from two versions ago.
+tnn_error tnn_swap_shadow(tnn_swap *s, tnn_param **p);
+
+//Publish the shadow buffer as the current one
+tnn_error tnn_swap_publish(tnn_swap *s);
+
+//Copy w into the shadow buffer and publish it
+tnn_error tnn_swap_update(tnn_swap *s, gsl_vector *w);
+
+//Get the machine of the current buffer (for the writer only)
+tnn_error tnn_swap_get_machine(tnn_swap *s, tnn_machine **m);
+
+//Destroy a reader
+tnn_error tnn_swap_reader_destroy(tnn_swap_reader *r);
+
+//Destroy the swap. The user's machine is not destroyed.
+tnn_error tnn_swap_destroy(tnn_swap *s);
+
+#endif //TNN_SWAP_H
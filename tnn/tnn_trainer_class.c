@@ -7,7 +7,15 @@
  * tnn_error tnn_trainer_class_learn(tnn_trainer_class *t, gsl_vector *input, size_t label);
  * tnn_error tnn_trainer_class_try(tnn_trainer_class *t, gsl_vector *input, size_t label, bool* correct);
  * tnn_error tnn_trainer_class_test(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels, double *loss, double *error);
+ * tnn_error tnn_trainer_class_test_dataset(tnn_trainer_class *t, tnn_dataset *ds, double *loss, double *error);
+ * tnn_error tnn_trainer_class_test_parallel(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+ *                                           size_t nthreads, double *loss, double *error);
  * tnn_error tnn_trainer_class_train(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_clone_machine(tnn_trainer_class *t, tnn_machine *m, tnn_loss *l, tnn_state **label,
+ *                                           bool share);
+ * tnn_error tnn_trainer_class_iterate(tnn_trainer_class *t, TNN_TRAINER_CLASS_FUNC_STEP step,
+ *                                     TNN_TRAINER_CLASS_FUNC_BLOCK block, void *data, double epsilon, double delta,
+ *                                     size_t eiter, size_t niter, size_t *titer);
  * tnn_error tnn_trainer_class_destroy(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_debug(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_get_machine(tnn_trainer_class *t, tnn_machine **m);
@@ -17,7 +25,11 @@
  */
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <stdbool.h>
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_macro.h>
 #include <tnn/tnn_trainer_class.h>
@@ -25,17 +37,71 @@
 #include <tnn/tnn_loss.h>
 #include <tnn/tnn_state.h>
 #include <tnn/tnn_reg.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_pstable.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_blas.h>
 
-//Determine the label of a sample
-tnn_error tnn_trainer_class_run(tnn_trainer_class *t, gsl_vector *input, size_t *label, double* loss){
+//A share of the samples tested by one thread
+typedef struct __STRUCT_tnn_trainer_class_tester{
+  //The trainer
+  tnn_trainer_class *t;
+  //Machine, loss, label and losses used: those of the trainer for the first share, the replicas otherwise
+  tnn_machine *m;
+  tnn_loss *l;
+  tnn_state *label;
+  gsl_vector *losses;
+  //Replicas owned by the other shares
+  tnn_machine mr;
+  tnn_loss lr;
+  //Samples of the share
+  gsl_matrix *inputs;
+  size_t *labels;
+  size_t beg;
+  size_t end;
+  //Loss of each sample, and errors of the share
+  double *ls;
+  size_t nerr;
+  //Error of the share
+  tnn_error err;
+} tnn_trainer_class_tester;
+
+//Determine the label of a sample on machine m, with loss l, label state label and the losses vector losses
+static tnn_error tnn_trainer_class_eval(tnn_trainer_class *t, tnn_machine *m, tnn_loss *l, tnn_state *label,
+                                        gsl_vector *losses, gsl_vector *input, size_t *lb, double *loss){
   tnn_error ret;
   tnn_state *sin;
   gsl_vector_view v;
   size_t i;
 
+  //Copy input to sin
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(m, &sin), ret);
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(input, &sin->x));
+
+  //Do forward propagation
+  TNN_MACRO_ERRORTEST(tnn_machine_fprop(m), ret);
+
+  //Copy each lset to each label, and do forward propagation of loss
+  for(i = 0; i < t->lset->size1; i = i + 1){
+    v = gsl_matrix_row(t->lset, i);
+    TNN_MACRO_GSLTEST(gsl_blas_dcopy(&v.vector, &label->x));
+    TNN_MACRO_ERRORTEST(tnn_loss_fprop(l), ret);
+    gsl_vector_set(losses, i, gsl_vector_get(&l->output->x, 0));
+  }
+
+  //Find the label with the smallest loss
+  *lb = gsl_vector_min_index(losses);
+  *loss = gsl_vector_get(losses, *lb);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Determine the label of a sample
+tnn_error tnn_trainer_class_run(tnn_trainer_class *t, gsl_vector *input, size_t *label, double* loss){
+  tnn_state *sin;
+  tnn_error ret;
+
   //Get the machine's input state
   TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin), ret);
 
@@ -52,25 +118,7 @@ tnn_error tnn_trainer_class_run(tnn_trainer_class *t, gsl_vector *input, size_t
     return TNN_ERROR_STATE_INVALID;
   }
 
-  //Copy input to sin
-  TNN_MACRO_GSLTEST(gsl_blas_dcopy(input, &sin->x));
-
-  //Do forward propagation
-  TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
-
-  //Copy each lset to each label, and do forward propagation of loss
-  for(i = 0; i < t->lset->size1; i = i + 1){
-    v = gsl_matrix_row(t->lset, i);
-    TNN_MACRO_GSLTEST(gsl_blas_dcopy(&v.vector, &t->label->x));
-    TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
-    gsl_vector_set(t->losses, i, gsl_vector_get(&t->l.output->x, 0));
-  }
-
-  //Find the label with the smallest loss
-  *label = gsl_vector_min_index(t->losses);
-  *loss = gsl_vector_get(t->losses, *label);
-
-  return TNN_ERROR_SUCCESS;
+  return tnn_trainer_class_eval(t, &t->m, &t->l, t->label, t->losses, input, label, loss);
 }
 
 //Polymorphically learn a sample
@@ -117,6 +165,176 @@ tnn_error tnn_trainer_class_test(tnn_trainer_class *t, gsl_matrix *inputs, size_
   return TNN_ERROR_SUCCESS;
 }
 
+//Test on a dataset, with readahead of the rows
+tnn_error tnn_trainer_class_test_dataset(tnn_trainer_class *t, tnn_dataset *ds, double *loss, double *error){
+  gsl_vector_view input;
+  size_t lb;
+  double ls;
+  tnn_error ret;
+  size_t i;
+
+  *loss = 0;
+  *error = 0;
+  for(i = 0; i < ds->inputs.size1; i = i + 1){
+    TNN_MACRO_ERRORTEST(tnn_dataset_advise(ds, i), ret);
+    input = gsl_matrix_row(&ds->inputs, i);
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_run(t, &input.vector, &lb, &ls), ret);
+    if(lb != ds->labels[i]){
+      *error = *error + 1.0;
+    }
+    *loss = *loss + ls;
+  }
+  if(ds->inputs.size1 != 0){
+    *error = (*error)/(double)ds->inputs.size1;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Set up the share k: the first one uses the trainer itself, the others a replica of the machine and the loss
+//On failure the share is left with nothing to destroy.
+static tnn_error tnn_trainer_class_tester_init(tnn_trainer_class *t, tnn_trainer_class_tester *w, size_t k){
+  tnn_error ret;
+
+  w->t = t;
+  w->nerr = 0;
+  w->err = TNN_ERROR_SUCCESS;
+
+  //The first share runs on the trainer
+  if(k == 0){
+    w->m = &t->m;
+    w->l = &t->l;
+    w->label = t->label;
+    w->losses = t->losses;
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Replicate the machine, with the loss and the label on its io states
+  if((w->losses = gsl_vector_alloc(t->lset->size1)) == NULL){
+    return TNN_ERROR_GSL;
+  }
+  if((ret = tnn_trainer_class_clone_machine(t, &w->mr, &w->lr, &w->label, true)) != TNN_ERROR_SUCCESS){
+    gsl_vector_free(w->losses);
+    return ret;
+  }
+  w->m = &w->mr;
+  w->l = &w->lr;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Test the samples of a share, recording the loss of each
+static void *tnn_trainer_class_tester_run(void *arg){
+  tnn_trainer_class_tester *w;
+  gsl_vector_view input;
+  size_t i, lb;
+
+  w = (tnn_trainer_class_tester *)arg;
+  for(i = w->beg; i < w->end; i = i + 1){
+    input = gsl_matrix_row(w->inputs, i);
+    w->err = tnn_trainer_class_eval(w->t, w->m, w->l, w->label, w->losses, &input.vector, &lb, &w->ls[i]);
+    if(w->err != TNN_ERROR_SUCCESS){
+      return NULL;
+    }
+    if(lb != w->labels[i]){
+      w->nerr = w->nerr + 1;
+    }
+  }
+
+  return NULL;
+}
+
+//Test on samples with nthreads threads, each running a replica of the machine on a contiguous share of the rows
+tnn_error tnn_trainer_class_test_parallel(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                                          size_t nthreads, double *loss, double *error){
+  tnn_trainer_class_tester *w;
+  tnn_state *sin;
+  pthread_t *th;
+  tnn_error ret;
+  double *ls;
+  size_t k, i, nw, ready, started, nerr;
+
+  //Check the parameters and states
+  if(nthreads < 1){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin), ret);
+  if(sin->size != inputs->size2){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  if(sin->valid != true || t->label->valid != true){
+    return TNN_ERROR_STATE_INVALID;
+  }
+  *loss = 0;
+  *error = 0;
+  if(inputs->size1 == 0){
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Split the rows into contiguous shares
+  nw = nthreads < inputs->size1 ? nthreads : inputs->size1;
+  w = (tnn_trainer_class_tester *) malloc(nw*sizeof(tnn_trainer_class_tester));
+  th = (pthread_t *) malloc(nw*sizeof(pthread_t));
+  ls = (double *) malloc(inputs->size1*sizeof(double));
+  if(w == NULL || th == NULL || ls == NULL){
+    free(w);
+    free(th);
+    free(ls);
+    return TNN_ERROR_ALLOC;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  for(ready = 0; ready < nw; ready = ready + 1){
+    if((ret = tnn_trainer_class_tester_init(t, &w[ready], ready)) != TNN_ERROR_SUCCESS){
+      break;
+    }
+    w[ready].inputs = inputs;
+    w[ready].labels = labels;
+    w[ready].beg = inputs->size1*ready/nw;
+    w[ready].end = inputs->size1*(ready + 1)/nw;
+    w[ready].ls = ls;
+  }
+
+  //Run the shares, the first one in the calling thread
+  started = 1;
+  if(ret == TNN_ERROR_SUCCESS){
+    for(; started < nw; started = started + 1){
+      if(pthread_create(&th[started], NULL, tnn_trainer_class_tester_run, &w[started]) != 0){
+	ret = TNN_ERROR_TRAINER_CLASS_THREAD;
+	break;
+      }
+    }
+    tnn_trainer_class_tester_run(&w[0]);
+    for(k = 1; k < started; k = k + 1){
+      pthread_join(th[k], NULL);
+    }
+  }
+
+  //Reduce the errors in the order of the shares, and the losses in the order of the samples
+  nerr = 0;
+  for(k = 0; k < nw && ret == TNN_ERROR_SUCCESS; k = k + 1){
+    ret = w[k].err;
+    nerr = nerr + w[k].nerr;
+  }
+  if(ret == TNN_ERROR_SUCCESS){
+    for(i = 0; i < inputs->size1; i = i + 1){
+      *loss = *loss + ls[i];
+    }
+    *error = (double)nerr/(double)inputs->size1;
+  }
+
+  //Destroy the replicas
+  for(k = 1; k < ready && k < nw; k = k + 1){
+    tnn_loss_destroy(&w[k].lr);
+    tnn_machine_destroy(&w[k].mr);
+    gsl_vector_free(w[k].losses);
+  }
+  free(w);
+  free(th);
+  free(ls);
+
+  return ret;
+}
+
 //Polymorphically train on samples
 tnn_error tnn_trainer_class_train(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
   if(t->train != NULL){
@@ -125,6 +343,63 @@ tnn_error tnn_trainer_class_train(tnn_trainer_class *t, gsl_matrix *inputs, size
   return TNN_ERROR_TRAINER_CLASS_FUNCNDEF;
 }
 
+//Clone or replicate the machine of the trainer, with its loss and label on the io states of the copy
+tnn_error tnn_trainer_class_clone_machine(tnn_trainer_class *t, tnn_machine *m, tnn_loss *l, tnn_state **label,
+                                          bool share){
+  tnn_pstable table;
+  tnn_error ret;
+
+  TNN_MACRO_ERRORTEST(tnn_pstable_init(&table), ret);
+  ret = share ? tnn_machine_replica(&t->m, m, &table) : tnn_machine_clone(&t->m, m, &table);
+  if(ret != TNN_ERROR_SUCCESS){
+    tnn_pstable_destroy(&table);
+    return ret;
+  }
+  if((ret = tnn_pstable_find(&table, t->label, label)) != TNN_ERROR_SUCCESS ||
+     (ret = tnn_loss_clone(&t->l, l, &table)) != TNN_ERROR_SUCCESS){
+    tnn_machine_destroy(m);
+    tnn_pstable_destroy(&table);
+    return ret;
+  }
+  tnn_pstable_destroy(&table);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Run the steps of a trainer in blocks of eiter steps until one of the exit criteria is met
+tnn_error tnn_trainer_class_iterate(tnn_trainer_class *t, TNN_TRAINER_CLASS_FUNC_STEP step,
+                                    TNN_TRAINER_CLASS_FUNC_BLOCK block, void *data, double epsilon, double delta,
+                                    size_t eiter, size_t niter, size_t *titer){
+  tnn_error ret;
+  double eps, dl, s, loss, aloss;
+  size_t i;
+
+  for(eps = DBL_MAX, dl = DBL_MAX, aloss = DBL_MAX; eps > epsilon && dl > delta && *titer < niter;
+      *titer = *titer + eiter){
+
+    //The updates and losses of these eiter steps are accumulated as they are computed
+    s = 0.0;
+    loss = 0.0;
+    for(i = 0; i < eiter; i = i + 1){
+      TNN_MACRO_ERRORTEST((*step)(t, data, *titer + i, &s, &loss), ret);
+    }
+
+    //The norm of the updates applied as eps, and the relative change of the average loss as dl
+    eps = sqrt(s);
+    loss = loss/(double)eiter;
+    if(delta > 0.0 && aloss != DBL_MAX){
+      dl = fabs(loss - aloss)/fmax(fabs(aloss), DBL_MIN);
+    }
+    aloss = loss;
+
+    if(block != NULL){
+      TNN_MACRO_ERRORTEST((*block)(t, data, *titer + eiter, s, loss), ret);
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
 //Polymorphically destroy the trainer
 tnn_error tnn_trainer_class_destroy(tnn_trainer_class *t){
   tnn_error ret;
@@ -13,7 +13,15 @@
  * tnn_error tnn_trainer_class_learn(tnn_trainer_class *t, gsl_vector *input, size_t label);
  * tnn_error tnn_trainer_class_try(tnn_trainer_class *t, gsl_vector *input, size_t label, bool* correct);
  * tnn_error tnn_trainer_class_test(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels, double *loss, double *error);
+ * tnn_error tnn_trainer_class_test_dataset(tnn_trainer_class *t, tnn_dataset *ds, double *loss, double *error);
+ * tnn_error tnn_trainer_class_test_parallel(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+ *                                           size_t nthreads, double *loss, double *error);
  * tnn_error tnn_trainer_class_train(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_clone_machine(tnn_trainer_class *t, tnn_machine *m, tnn_loss *l, tnn_state **label,
+ *                                           bool share);
+ * tnn_error tnn_trainer_class_iterate(tnn_trainer_class *t, TNN_TRAINER_CLASS_FUNC_STEP step,
+ *                                     TNN_TRAINER_CLASS_FUNC_BLOCK block, void *data, double epsilon, double delta,
+ *                                     size_t eiter, size_t niter, size_t *titer);
  * tnn_error tnn_trainer_class_destroy(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_debug(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_get_machine(tnn_trainer_class *t, tnn_machine **m);
@@ -28,6 +36,7 @@
 #include <tnn/tnn_machine.h>
 #include <tnn/tnn_loss.h>
 #include <tnn/tnn_reg.h>
+#include <tnn/tnn_dataset.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 
@@ -39,6 +48,12 @@ typedef enum __ENUM_tnn_trainer_class_type{
   TNN_TRAINER_CLASS_TYPE_NONE, //Nothing..
   TNN_TRAINER_CLASS_TYPE_NSGD, //Naive stochastic gradient descent classification trainer
   TNN_TRAINER_CLASS_TYPE_TSGD, //Threaded stochastic gradient descent classification trainer
+  TNN_TRAINER_CLASS_TYPE_MSGD, //Momentum stochastic gradient descent classification trainer
+  TNN_TRAINER_CLASS_TYPE_ADAGRAD, //AdaGrad classification trainer
+  TNN_TRAINER_CLASS_TYPE_RMSPROP, //RMSProp classification trainer
+  TNN_TRAINER_CLASS_TYPE_ADAM, //Adam classification trainer
+  TNN_TRAINER_CLASS_TYPE_MBSGD, //Minibatch stochastic gradient descent classification trainer
+  TNN_TRAINER_CLASS_TYPE_LBFGS, //Limited-memory BFGS classification trainer
 
   TNN_TRAINER_TYPE_SIZE //Size indicator (if you want to define your own polymorph-safe trainer, do it above this integer)
 } tnn_trainer_class_type;
@@ -49,6 +64,10 @@ typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_LEARN)(struct __STRUCT_tnn_trainer_cl
 typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_TRAIN)(struct __STRUCT_tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
 typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_DESTROY)(struct __STRUCT_tnn_trainer_class *t);
 typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_DEBUG)(struct __STRUCT_tnn_trainer_class *t);
+typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_STEP)(struct __STRUCT_tnn_trainer_class *t, void *data, size_t k, double *s,
+                                                 double *l);
+typedef tnn_error (*TNN_TRAINER_CLASS_FUNC_BLOCK)(struct __STRUCT_tnn_trainer_class *t, void *data, size_t k,
+                                                  double s, double l);
 
 //The tructure
 typedef struct __STRUCT_tnn_trainer_class{
@@ -92,9 +111,36 @@ tnn_error tnn_trainer_class_try(tnn_trainer_class *t, gsl_vector *input, size_t
 //Test on samples
 tnn_error tnn_trainer_class_test(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels, double *loss, double *error);
 
+//Test on a dataset, with readahead of the rows
+tnn_error tnn_trainer_class_test_dataset(tnn_trainer_class *t, tnn_dataset *ds, double *loss, double *error);
+
+//Test on samples with nthreads threads, each running a replica of the machine on a contiguous share of the rows
+//The replicas share the parameter of the machine, which must not be changed during the test. The errors are
+//counted per share and the losses kept per sample, then summed in order, so the results are the same as those of
+//tnn_trainer_class_test for any number of threads.
+tnn_error tnn_trainer_class_test_parallel(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                                          size_t nthreads, double *loss, double *error);
+
 //Polymorphicall train on samples
 tnn_error tnn_trainer_class_train(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
 
+//Run the steps of a trainer from step *titer on, in blocks of eiter steps, until niter steps are taken, the norm of
+//the updates of a block is at most epsilon, or the average loss of a block changes by at most delta relatively
+//(epsilon or delta 0 if not used). step takes step k, adding the squared norm of its update to *s and its loss to *l.
+//epsilon is tested against the square root of the summed squared norms of the steps, which is below the norm of
+//the net change of the parameters over the block when the steps point the same way, and above it when they cancel.
+//block, if not NULL, is called after each block with the number of steps taken, the squared norm of the updates
+//and the average loss of the block. Used by the trainer types.
+tnn_error tnn_trainer_class_iterate(tnn_trainer_class *t, TNN_TRAINER_CLASS_FUNC_STEP step,
+                                    TNN_TRAINER_CLASS_FUNC_BLOCK block, void *data, double epsilon, double delta,
+                                    size_t eiter, size_t niter, size_t *titer);
+
+//Clone the machine of the trainer to m, or replicate it sharing its parameter if share, and clone the loss of the
+//trainer to l and find the label state in label, both on the io states of m. On failure nothing is left to destroy.
+//Used by the trainers and tests that run copies of the machine in threads.
+tnn_error tnn_trainer_class_clone_machine(tnn_trainer_class *t, tnn_machine *m, tnn_loss *l, tnn_state **label,
+                                          bool share);
+
 //Polymorphically debug the trainer
 tnn_error tnn_trainer_class_debug(tnn_trainer_class *t);
 
@@ -0,0 +1,94 @@
+/* Thunder Neural Networks Trainer - Classification - Adaptive SGD Utility Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The adaptive trainers scale the step of every parameter by its gradient history. With
+ * g = dx + lambda*reg'(x), they update the moments m (first) and s (second) of each parameter as
+ *   AdaGrad: s = s + g*g,                                      x = x - eta*g/(sqrt(s) + delta)
+ *   RMSProp: s = beta2*s + (1 - beta2)*g*g,                    x = x - eta*g/(sqrt(s) + delta)
+ *   Adam:    m = beta1*m + (1 - beta1)*g, s as RMSProp,        x = x - eta_k*m/(sqrt(s) + delta)
+ * where eta_k = eta*sqrt(1 - beta2^k)/(1 - beta1^k) folds the bias correction of step k into a scalar. The
+ * moments are one aligned block (m then s) laid out like the unit-stride x, and each step is a single fused pass
+ * over x, dx, m and s without temporaries, with a loop of its own for the L1 regularizer.
+ *
+ * This header defines the following structure:
+ * tnn_trainer_class_adapt(double eta, double beta1, double beta2, double delta, double epsilon, size_t eiter,
+ *                         size_t niter, size_t titer, size_t k, double p1, double p2, double *moments,
+ *                         size_t msize)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_trainer_class_init_adagrad(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                          double lambda, double eta, double delta, double epsilon, size_t eiter,
+ *                                          size_t niter);
+ * tnn_error tnn_trainer_class_init_rmsprop(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                          double lambda, double eta, double beta2, double delta, double epsilon,
+ *                                          size_t eiter, size_t niter);
+ * tnn_error tnn_trainer_class_init_adam(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                       double lambda, double eta, double beta1, double beta2, double delta,
+ *                                       double epsilon, size_t eiter, size_t niter);
+ * tnn_error tnn_trainer_class_learn_adapt(tnn_trainer_class *t, gsl_vector *input, size_t label);
+ * tnn_error tnn_trainer_class_train_adapt(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_adapt(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_adapt(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_adapt(tnn_trainer_class *t, size_t *titer);
+ */
+
+#include <stddef.h> //For size_t
+#include <tnn/tnn_trainer_class.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#ifndef TNN_TRAINER_CLASS_ADAPT_H
+#define TNN_TRAINER_CLASS_ADAPT_H
+
+//Alignment of the moments in bytes
+#define TNN_TRAINER_CLASS_ADAPT_ALIGN 64
+
+//The training parameters
+typedef struct __STRUCT_tnn_trainer_class_adapt{
+  double eta; //Step size
+  double beta1; //Decay of the first moment (Adam)
+  double beta2; //Decay of the second moment (RMSProp and Adam)
+  double delta; //Added to the root of the second moment
+  double epsilon; //Exit criterion on the root of the summed squared norms of eiter steps: 0 if not used
+  size_t eiter; //For speed, after eiter steps we test whether to exit
+  size_t niter; //Exit step size criterion
+  size_t titer; //True steps executed
+  size_t k; //Updates applied to the moments
+  double p1; //beta1^k
+  double p2; //beta2^k
+  double *moments; //First and second moments, msize each: NULL until the first step
+  size_t msize; //Size of each moment
+} tnn_trainer_class_adapt;
+
+//Initialize a trainer to be AdaGrad trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_adagrad(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                         double lambda, double eta, double delta, double epsilon, size_t eiter,
+                                         size_t niter);
+
+//Initialize a trainer to be RMSProp trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_rmsprop(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                         double lambda, double eta, double beta2, double delta, double epsilon,
+                                         size_t eiter, size_t niter);
+
+//Initialize a trainer to be Adam trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_adam(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                      double lambda, double eta, double beta1, double beta2, double delta,
+                                      double epsilon, size_t eiter, size_t niter);
+
+//Learn one sample using the adaptive method of the trainer
+tnn_error tnn_trainer_class_learn_adapt(tnn_trainer_class *t, gsl_vector *input, size_t label);
+
+//Train all the samples using the adaptive method of the trainer
+tnn_error tnn_trainer_class_train_adapt(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_adapt(tnn_trainer_class *t);
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_adapt(tnn_trainer_class *t);
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_adapt(tnn_trainer_class *t, size_t *titer);
+
+#endif //TNN_TRAINER_CLASS_ADAPT_H
@@ -0,0 +1,749 @@
+/* Thunder Neural Networks Trainer - Classification - L-BFGS Utility Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_trainer_class_init_lbfgs(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                        double lambda, size_t m, double epsilon, size_t niter, size_t nthreads);
+ * tnn_error tnn_trainer_class_train_lbfgs(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_lbfgs(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_lbfgs(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_lbfgs(tnn_trainer_class *t, size_t *titer);
+ * tnn_error tnn_trainer_class_objective_lbfgs(tnn_trainer_class *t, double *f);
+ */
+
+#include <stddef.h> //For size_t
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <tnn/utlist.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_lbfgs.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <tnn/tnn_param.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+
+//A share of the samples evaluated by one thread
+typedef struct __STRUCT_tnn_trainer_class_lbfgs_worker{
+  //The trainer
+  tnn_trainer_class *t;
+  //Machine, loss and states used: those of the trainer for the first worker, the clones otherwise
+  tnn_machine *m;
+  tnn_loss *l;
+  tnn_state *sin;
+  tnn_state *label;
+  tnn_param *p;
+  //Clones owned by the other workers
+  tnn_machine mc;
+  tnn_loss lc;
+  //Segments of the parameter (offset in the trainer's, offset in this one's, length), one for each module weight
+  size_t *seg;
+  size_t nseg;
+  //Samples of the share
+  gsl_matrix *inputs;
+  size_t *labels;
+  size_t beg;
+  size_t end;
+  //Loss and gradient sums of the share
+  double f;
+  double *g;
+  //Error of the share
+  tnn_error err;
+} tnn_trainer_class_lbfgs_worker;
+
+//Initialize a trainer to be lbfgs trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_lbfgs(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                       double lambda, size_t m, double epsilon, size_t niter, size_t nthreads){
+  tnn_error ret;
+
+  //Check the paramters
+  if(lambda < 0 || m < 1 || epsilon < 0 || nthreads < 1){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+  if(niter < 1 && epsilon == 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+
+  //Defined type
+  t->t = TNN_TRAINER_CLASS_TYPE_LBFGS;
+
+  //Constant paramters
+  t->c = (tnn_trainer_class_lbfgs *) malloc(sizeof(tnn_trainer_class_lbfgs));
+  if(t->c == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  ((tnn_trainer_class_lbfgs*)t->c)->m = m;
+  ((tnn_trainer_class_lbfgs*)t->c)->epsilon = epsilon;
+  ((tnn_trainer_class_lbfgs*)t->c)->niter = niter;
+  ((tnn_trainer_class_lbfgs*)t->c)->nthreads = nthreads;
+  ((tnn_trainer_class_lbfgs*)t->c)->nls = TNN_TRAINER_CLASS_LBFGS_NLS;
+  ((tnn_trainer_class_lbfgs*)t->c)->titer = 0;
+  ((tnn_trainer_class_lbfgs*)t->c)->f = 0.0;
+
+  //lset
+  t->lset = lset;
+
+  //Losses
+  t->losses = gsl_vector_alloc(t->lset->size1);
+
+  //Initialize the machine
+  TNN_MACRO_ERRORTEST(tnn_machine_init(&t->m, ninput, noutput),ret);
+
+  //Initialize the label
+  t->label = (tnn_state *) malloc(sizeof(tnn_state));
+  if(t->label == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  TNN_MACRO_ERRORTEST(tnn_state_init(t->label, noutput),ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_state_alloc(&t->m, t->label),ret);
+
+  //Initialize the regularization parameter
+  t->lambda = lambda;
+
+  //Initialize methods (there is no learning of single samples for a full-batch method)
+  t->learn = NULL;
+  t->train = tnn_trainer_class_train_lbfgs;
+  t->debug = tnn_trainer_class_debug_lbfgs;
+  t->destroy = tnn_trainer_class_destroy_lbfgs;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Add the segment of the weight of module m1 to a worker whose clone of it is m2
+static tnn_error tnn_trainer_class_lbfgs_segment(tnn_trainer_class_lbfgs_worker *w, tnn_param *p,
+                                                 tnn_module *m1, tnn_module *m2){
+  tnn_error ret;
+  size_t o1, o2;
+
+  if(m1->w.valid != true || m1->w.size == 0){
+    return TNN_ERROR_SUCCESS;
+  }
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(p, &m1->w, &o1), ret);
+  TNN_MACRO_ERRORTEST(tnn_param_state_offset(w->p, &m2->w, &o2), ret);
+  w->seg[3*w->nseg] = o1;
+  w->seg[3*w->nseg + 1] = o2;
+  w->seg[3*w->nseg + 2] = m1->w.size;
+  w->nseg = w->nseg + 1;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Set up worker k: the first one uses the trainer itself, the others a clone of the machine and the loss
+static tnn_error tnn_trainer_class_lbfgs_worker_init(tnn_trainer_class *t, tnn_trainer_class_lbfgs_worker *w,
+                                                     size_t k){
+  tnn_module *m1, *m2;
+  tnn_param *p;
+  tnn_error ret;
+  size_t n, i;
+
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  w->t = t;
+  w->g = (double *) malloc((p->size > 0 ? p->size : 1)*sizeof(double));
+  w->seg = NULL;
+  w->nseg = 0;
+  if(w->g == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+
+  //The first worker runs on the trainer
+  if(k == 0){
+    w->m = &t->m;
+    w->l = &t->l;
+    w->label = t->label;
+    w->p = p;
+    return tnn_machine_get_sin(&t->m, &w->sin);
+  }
+
+  //Clone the machine, with the loss and the label on its io states
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_clone_machine(t, &w->mc, &w->lc, &w->label, false), ret);
+  w->m = &w->mc;
+  w->l = &w->lc;
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&w->mc, &w->sin), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&w->mc, &w->p), ret);
+
+  //Map the weights of the clone to the parameter of the trainer, module by module
+  n = 2;
+  DL_FOREACH(t->m.m, m1){
+    n = n + 1;
+  }
+  w->seg = (size_t *) malloc(3*n*sizeof(size_t));
+  if(w->seg == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_segment(w, p, &t->m.min, &w->mc.min), ret);
+  for(m1 = t->m.m, m2 = w->mc.m; m1 != NULL && m2 != NULL; m1 = m1->next, m2 = m2->next){
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_segment(w, p, m1, m2), ret);
+  }
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_segment(w, p, &t->m.mout, &w->mc.mout), ret);
+  for(n = 0, i = 0; i < w->nseg; i = i + 1){
+    n = n + w->seg[3*i + 2];
+  }
+  if(n != p->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Release worker k
+static void tnn_trainer_class_lbfgs_worker_destroy(tnn_trainer_class_lbfgs_worker *w, size_t k){
+  if(k > 0 && w->m == &w->mc){
+    tnn_loss_destroy(&w->lc);
+    tnn_machine_destroy(&w->mc);
+  }
+  free(w->seg);
+  free(w->g);
+}
+
+//Accumulate the loss and the parameter gradient over the share of one worker
+static void *tnn_trainer_class_lbfgs_run(void *arg){
+  tnn_trainer_class_lbfgs_worker *w;
+  tnn_param *p;
+  gsl_vector_view in, lb;
+  double *restrict g, *restrict dx;
+  double *x, *y;
+  size_t i, j, o1, o2, n;
+
+  w = (tnn_trainer_class_lbfgs_worker *) arg;
+  w->f = 0.0;
+  w->err = TNN_ERROR_SUCCESS;
+  if((w->err = tnn_machine_get_param(&w->t->m, &p)) != TNN_ERROR_SUCCESS){
+    return NULL;
+  }
+  memset(w->g, 0, p->size*sizeof(double));
+
+  //Copy the parameter of the trainer into the clone
+  for(j = 0; j < w->nseg; j = j + 1){
+    x = p->x->data + w->seg[3*j];
+    y = w->p->x->data + w->seg[3*j + 1];
+    memcpy(y, x, w->seg[3*j + 2]*sizeof(double));
+  }
+
+  gsl_vector_set(&w->l->output->dx, 0, 1.0);
+  for(i = w->beg; i < w->end; i = i + 1){
+    if(w->labels[i] >= w->t->lset->size1){
+      w->err = TNN_ERROR_STATE_INCOMP;
+      return NULL;
+    }
+    in = gsl_matrix_row(w->inputs, i);
+    lb = gsl_matrix_row(w->t->lset, w->labels[i]);
+    if(gsl_blas_dcopy(&in.vector, &w->sin->x) != 0 || gsl_blas_dcopy(&lb.vector, &w->label->x) != 0){
+      w->err = TNN_ERROR_GSL;
+      return NULL;
+    }
+    if((w->err = tnn_machine_fprop(w->m)) != TNN_ERROR_SUCCESS
+       || (w->err = tnn_loss_fprop(w->l)) != TNN_ERROR_SUCCESS
+       || (w->err = tnn_loss_bprop(w->l)) != TNN_ERROR_SUCCESS
+       || (w->err = tnn_machine_bprop(w->m)) != TNN_ERROR_SUCCESS){
+      return NULL;
+    }
+    w->f = w->f + gsl_vector_get(&w->l->output->x, 0);
+
+    //Add the gradient, in the order of the trainer's parameter
+    g = w->g;
+    dx = w->p->dx->data;
+    if(w->seg == NULL){
+      for(j = 0; j < p->size; j = j + 1){
+	g[j] = g[j] + dx[j];
+      }
+    } else {
+      for(j = 0; j < w->nseg; j = j + 1){
+	o1 = w->seg[3*j];
+	o2 = w->seg[3*j + 1];
+	for(n = 0; n < w->seg[3*j + 2]; n = n + 1){
+	  g[o1 + n] = g[o1 + n] + dx[o2 + n];
+	}
+      }
+    }
+  }
+
+  return NULL;
+}
+
+//Evaluate the objective f and its gradient g at the current parameter of the trainer
+static tnn_error tnn_trainer_class_lbfgs_eval(tnn_trainer_class *t, tnn_trainer_class_lbfgs_worker *w, size_t nw,
+                                              size_t ns, double *f, double *g){
+  pthread_t *th;
+  tnn_param *p;
+  tnn_error ret;
+  double *restrict dx;
+  double r;
+  size_t k, i, started;
+
+  th = (pthread_t *) malloc(nw*sizeof(pthread_t));
+  if(th == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+
+  //Run the shares, the first one in the calling thread
+  ret = TNN_ERROR_SUCCESS;
+  for(started = 1; started < nw; started = started + 1){
+    if(pthread_create(&th[started], NULL, tnn_trainer_class_lbfgs_run, &w[started]) != 0){
+      ret = TNN_ERROR_TRAINER_CLASS_THREAD;
+      break;
+    }
+  }
+  tnn_trainer_class_lbfgs_run(&w[0]);
+  for(k = 1; k < started; k = k + 1){
+    pthread_join(th[k], NULL);
+  }
+  free(th);
+  for(k = 0; k < nw && ret == TNN_ERROR_SUCCESS; k = k + 1){
+    ret = w[k].err;
+  }
+  if(ret != TNN_ERROR_SUCCESS){
+    return ret;
+  }
+
+  //Reduce in the order of the workers
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  *f = 0.0;
+  memset(g, 0, p->size*sizeof(double));
+  for(k = 0; k < nw; k = k + 1){
+    *f = *f + w[k].f;
+    for(i = 0; i < p->size; i = i + 1){
+      g[i] = g[i] + w[k].g[i];
+    }
+  }
+  *f = *f/(double)ns;
+  for(i = 0; i < p->size; i = i + 1){
+    g[i] = g[i]/(double)ns;
+  }
+
+  //Add the regularizer, using p->dx for its derivative
+  if(t->r.l != NULL && t->r.d != NULL && t->lambda != 0.0){
+    TNN_MACRO_ERRORTEST(tnn_reg_l(&t->r, p->x, &r), ret);
+    TNN_MACRO_ERRORTEST(tnn_reg_d(&t->r, p->x, p->dx), ret);
+    *f = *f + t->lambda*r;
+    dx = p->dx->data;
+    for(i = 0; i < p->size; i = i + 1){
+      g[i] = g[i] + t->lambda*dx[i];
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Set the parameter to x0 + a*d and evaluate the objective and its directional derivative there
+static tnn_error tnn_trainer_class_lbfgs_phi(tnn_trainer_class *t, tnn_trainer_class_lbfgs_worker *w, size_t nw,
+                                             size_t ns, double *x0, double *d, double a, double *f, double *g,
+                                             double *dg){
+  tnn_param *p;
+  tnn_error ret;
+  double *restrict x;
+  size_t i;
+
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  x = p->x->data;
+  for(i = 0; i < p->size; i = i + 1){
+    x[i] = x0[i] + a*d[i];
+  }
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_eval(t, w, nw, ns, f, g), ret);
+  for(*dg = 0.0, i = 0; i < p->size; i = i + 1){
+    *dg = *dg + g[i]*d[i];
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Minimizer of the cubic interpolating (a1, f1, d1) and (a2, f2, d2), safeguarded inside the bracket
+static double tnn_trainer_class_lbfgs_cubic(double a1, double f1, double d1, double a2, double f2, double d2){
+  double e1, e2, a, lo, hi;
+
+  lo = fmin(a1, a2) + 0.1*fabs(a2 - a1);
+  hi = fmax(a1, a2) - 0.1*fabs(a2 - a1);
+  e1 = d1 + d2 - 3.0*(f1 - f2)/(a1 - a2);
+  e2 = e1*e1 - d1*d2;
+  if(e2 < 0.0){
+    return (a1 + a2)/2.0;
+  }
+  e2 = (a2 > a1 ? 1.0 : -1.0)*sqrt(e2);
+  a = a2 - (a2 - a1)*(d2 + e2 - e1)/(d2 - d1 + 2.0*e2);
+  if(!isfinite(a) || a < lo || a > hi){
+    return (a1 + a2)/2.0;
+  }
+  return a;
+}
+
+//Line search from x0 along d for a step satisfying the strong Wolfe conditions
+//f0 and dg0 are the objective and directional derivative at x0. On success the parameter, f and g are at the
+//accepted step and *found is 1; otherwise they are at the last trial step and *found is 0.
+static tnn_error tnn_trainer_class_lbfgs_search(tnn_trainer_class *t, tnn_trainer_class_lbfgs_worker *w, size_t nw,
+                                                size_t ns, double *x0, double *d, double f0, double dg0, double a,
+                                                double *f, double *g, int *found){
+  tnn_error ret;
+  size_t nls, k;
+  double alo, flo, dlo, ahi, fhi, dhi, aj, dg;
+
+  nls = ((tnn_trainer_class_lbfgs*)t->c)->nls;
+  *found = 0;
+
+  //Bracketing phase
+  alo = 0.0;
+  flo = f0;
+  dlo = dg0;
+  for(k = 0; ; k = k + 1){
+    if(k >= nls){
+      return TNN_ERROR_SUCCESS;
+    }
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_phi(t, w, nw, ns, x0, d, a, f, g, &dg), ret);
+    if(*f > f0 + TNN_TRAINER_CLASS_LBFGS_C1*a*dg0 || (k > 0 && *f >= flo)){
+      ahi = a;
+      fhi = *f;
+      dhi = dg;
+      break;
+    }
+    if(fabs(dg) <= -TNN_TRAINER_CLASS_LBFGS_C2*dg0){
+      *found = 1;
+      return TNN_ERROR_SUCCESS;
+    }
+    if(dg >= 0.0){
+      ahi = alo;
+      fhi = flo;
+      dhi = dlo;
+      alo = a;
+      flo = *f;
+      dlo = dg;
+      break;
+    }
+    alo = a;
+    flo = *f;
+    dlo = dg;
+    a = 2.0*a;
+  }
+
+  //Zoom phase
+  for(k = k + 1; k < nls; k = k + 1){
+    aj = tnn_trainer_class_lbfgs_cubic(alo, flo, dlo, ahi, fhi, dhi);
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_lbfgs_phi(t, w, nw, ns, x0, d, aj, f, g, &dg), ret);
+    if(*f > f0 + TNN_TRAINER_CLASS_LBFGS_C1*aj*dg0 || *f >= flo){
+      ahi = aj;
+      fhi = *f;
+      dhi = dg;
+    } else {
+      if(fabs(dg) <= -TNN_TRAINER_CLASS_LBFGS_C2*dg0){
+	*found = 1;
+	return TNN_ERROR_SUCCESS;
+      }
+      if(dg*(ahi - alo) >= 0.0){
+	ahi = alo;
+	fhi = flo;
+	dhi = dlo;
+      }
+      alo = aj;
+      flo = *f;
+      dlo = dg;
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Set d to minus the product of the inverse Hessian approximation and g by the two-loop recursion
+//The h pairs of s and y are stored in rings of m rows starting at row h0.
+static void tnn_trainer_class_lbfgs_direction(size_t n, size_t m, size_t h0, size_t h, double *s, double *y,
+                                              double *rho, double *alpha, double *g, double *d){
+  double *restrict dd;
+  double b, gamma, sy, yy;
+  size_t i, j, r;
+
+  dd = d;
+  for(i = 0; i < n; i = i + 1){
+    dd[i] = -g[i];
+  }
+  for(j = h; j > 0; j = j - 1){
+    r = (h0 + j - 1)%m;
+    for(alpha[r] = 0.0, i = 0; i < n; i = i + 1){
+      alpha[r] = alpha[r] + s[r*n + i]*dd[i];
+    }
+    alpha[r] = rho[r]*alpha[r];
+    for(i = 0; i < n; i = i + 1){
+      dd[i] = dd[i] - alpha[r]*y[r*n + i];
+    }
+  }
+  if(h > 0){
+    r = (h0 + h - 1)%m;
+    for(sy = 0.0, yy = 0.0, i = 0; i < n; i = i + 1){
+      sy = sy + s[r*n + i]*y[r*n + i];
+      yy = yy + y[r*n + i]*y[r*n + i];
+    }
+    gamma = sy/yy;
+    for(i = 0; i < n; i = i + 1){
+      dd[i] = gamma*dd[i];
+    }
+  }
+  for(j = 0; j < h; j = j + 1){
+    r = (h0 + j)%m;
+    for(b = 0.0, i = 0; i < n; i = i + 1){
+      b = b + y[r*n + i]*dd[i];
+    }
+    b = rho[r]*b;
+    for(i = 0; i < n; i = i + 1){
+      dd[i] = dd[i] + (alpha[r] - b)*s[r*n + i];
+    }
+  }
+}
+
+//Train all the samples as one batch using L-BFGS
+tnn_error tnn_trainer_class_train_lbfgs(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_trainer_class_lbfgs *c;
+  tnn_trainer_class_lbfgs_worker *w;
+  tnn_state *sin;
+  tnn_param *p;
+  tnn_error ret;
+  double *buf, *s, *y, *rho, *alpha, *g, *g0, *x0, *d;
+  double f, f0, dg0, gn, dn, a, sy;
+  size_t n, nw, k, i, h0, h, r;
+  int found;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_LBFGS){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Check the input
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin),ret);
+  if(inputs->size2 != sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Get the parameter
+  c = (tnn_trainer_class_lbfgs*)t->c;
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  if(p->size > 0 && (p->x->stride != 1 || p->dx->stride != 1)){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  n = p->size;
+  c->titer = 0;
+  f = 0.0;
+  if(inputs->size1 == 0 || n == 0){
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Allocate the history rings and the vectors in one block
+  buf = (double *) malloc((2*c->m*n + 2*c->m + 4*n)*sizeof(double));
+  if(buf == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  s = buf;
+  y = s + c->m*n;
+  rho = y + c->m*n;
+  alpha = rho + c->m;
+  g = alpha + c->m;
+  g0 = g + n;
+  x0 = g0 + n;
+  d = x0 + n;
+
+  //Set up the workers on contiguous shares of the samples
+  nw = c->nthreads < inputs->size1 ? c->nthreads : inputs->size1;
+  w = (tnn_trainer_class_lbfgs_worker *) calloc(nw, sizeof(tnn_trainer_class_lbfgs_worker));
+  if(w == NULL){
+    free(buf);
+    return TNN_ERROR_ALLOC;
+  }
+  ret = TNN_ERROR_SUCCESS;
+  for(k = 0; k < nw && ret == TNN_ERROR_SUCCESS; k = k + 1){
+    ret = tnn_trainer_class_lbfgs_worker_init(t, &w[k], k);
+    w[k].inputs = inputs;
+    w[k].labels = labels;
+    w[k].beg = inputs->size1*k/nw;
+    w[k].end = inputs->size1*(k + 1)/nw;
+  }
+
+  //Evaluate at the starting point
+  if(ret == TNN_ERROR_SUCCESS){
+    ret = tnn_trainer_class_lbfgs_eval(t, w, nw, inputs->size1, &f, g);
+  }
+
+  //Into the main loop
+  h0 = 0;
+  h = 0;
+  while(ret == TNN_ERROR_SUCCESS && c->titer < c->niter){
+
+    //Test the gradient norm
+    for(gn = 0.0, i = 0; i < n; i = i + 1){
+      gn = gn + g[i]*g[i];
+    }
+    gn = sqrt(gn);
+    if(gn <= c->epsilon){
+      break;
+    }
+
+    //Search direction, falling back to steepest descent if it does not descend
+    tnn_trainer_class_lbfgs_direction(n, c->m, h0, h, s, y, rho, alpha, g, d);
+    for(dg0 = 0.0, i = 0; i < n; i = i + 1){
+      dg0 = dg0 + g[i]*d[i];
+    }
+    if(!(dg0 < 0.0)){
+      h = 0;
+      for(i = 0; i < n; i = i + 1){
+	d[i] = -g[i];
+      }
+      dg0 = -gn*gn;
+    }
+
+    //Line search, with a unit step except on steepest descent where the first step has unit length
+    memcpy(x0, p->x->data, n*sizeof(double));
+    memcpy(g0, g, n*sizeof(double));
+    f0 = f;
+    if(h == 0){
+      for(dn = 0.0, i = 0; i < n; i = i + 1){
+	dn = dn + d[i]*d[i];
+      }
+      a = fmin(1.0, 1.0/sqrt(dn));
+    } else {
+      a = 1.0;
+    }
+    ret = tnn_trainer_class_lbfgs_search(t, w, nw, inputs->size1, x0, d, f0, dg0, a, &f, g, &found);
+    if(ret != TNN_ERROR_SUCCESS){
+      break;
+    }
+    if(found == 0){
+      //Restore the last point, and stop unless the history can be dropped
+      memcpy(p->x->data, x0, n*sizeof(double));
+      memcpy(g, g0, n*sizeof(double));
+      f = f0;
+      if(h == 0){
+	break;
+      }
+      h = 0;
+      continue;
+    }
+
+    //Store the correction pair if it keeps the approximation positive definite
+    r = (h0 + h)%c->m;
+    for(sy = 0.0, i = 0; i < n; i = i + 1){
+      s[r*n + i] = p->x->data[i] - x0[i];
+      y[r*n + i] = g[i] - g0[i];
+      sy = sy + s[r*n + i]*y[r*n + i];
+    }
+    if(sy > 0.0){
+      rho[r] = 1.0/sy;
+      if(h < c->m){
+	h = h + 1;
+      } else {
+	h0 = (h0 + 1)%c->m;
+      }
+    }
+
+    c->titer = c->titer + 1;
+  }
+  c->f = f;
+
+  for(k = 0; k < nw; k = k + 1){
+    tnn_trainer_class_lbfgs_worker_destroy(&w[k], k);
+  }
+  free(w);
+  free(buf);
+
+  return ret;
+}
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_lbfgs(tnn_trainer_class *t){
+  tnn_error ret;
+  size_t i,j;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_LBFGS){
+    printf("Trainer classifcation (L-BFGS) mistype\n");
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+
+  printf("Trainer classification (L-BFGS) = %p, type = %d, constant = %p, label_set = %p, lambda = %g\n", t, t->t, t->c, t->lset, t->lambda);
+  printf("losses = %p, learn = %p, train = %p, debug = %p, destroy = %p\n", t->losses, t->learn, t->train, t->debug, t->destroy);
+  printf("m = %ld, epsilon = %g, niter = %ld, nthreads = %ld, nls = %ld, titer = %ld, f = %g\n",
+	 ((tnn_trainer_class_lbfgs*)t->c)->m,
+	 ((tnn_trainer_class_lbfgs*)t->c)->epsilon,
+	 ((tnn_trainer_class_lbfgs*)t->c)->niter,
+	 ((tnn_trainer_class_lbfgs*)t->c)->nthreads,
+	 ((tnn_trainer_class_lbfgs*)t->c)->nls,
+	 ((tnn_trainer_class_lbfgs*)t->c)->titer,
+	 ((tnn_trainer_class_lbfgs*)t->c)->f);
+
+  printf("machine: ");
+  if((ret = tnn_machine_debug(&t->m)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_MODULE_FUNCNDEF){
+    printf("machine debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("loss: ");
+  if((ret = tnn_loss_debug(&t->l)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_LOSS_FUNCNDEF){
+    printf("loss debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("label: ");
+  if((ret = tnn_state_debug(t->label)) != TNN_ERROR_SUCCESS){
+    printf("label state debug error in trainer classification\n");
+    return ret;
+  }
+
+  printf("regularizer: ");
+  if((ret = tnn_reg_debug(&t->r)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_REG_FUNCNDEF){
+    printf("regularizer debug error in classification\n");
+    return ret;
+  }
+
+  printf("label_set: size1 = %ld, size2 = %ld\n", t->lset->size1, t->lset->size2);
+  for(i = 0; i < t->lset->size1; i = i + 1){
+    printf("%ld:", i);
+    for(j = 0; j < t->lset->size2; j = j + 1){
+      printf(" %g", gsl_matrix_get(t->lset, i, j));
+    }
+    printf("\n");
+  }
+
+  printf("losses: size = %ld, values:", t->losses->size);
+  for(i = 0; i < t->losses->size; i = i + 1){
+    printf(" %g", gsl_vector_get(t->losses, i));
+  }
+  printf("\n");
+
+  return ret;
+}
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_lbfgs(tnn_trainer_class *t){
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_LBFGS){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Destroy the parameter
+  free((tnn_trainer_class_lbfgs*)t->c);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_lbfgs(tnn_trainer_class *t, size_t *titer){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_LBFGS){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  *titer = ((tnn_trainer_class_lbfgs*)t->c)->titer;
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the objective at the end of the last training
+tnn_error tnn_trainer_class_objective_lbfgs(tnn_trainer_class *t, double *f){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_LBFGS){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  *f = ((tnn_trainer_class_lbfgs*)t->c)->f;
+  return TNN_ERROR_SUCCESS;
+}
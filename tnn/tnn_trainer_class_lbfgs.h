@@ -0,0 +1,72 @@
+/* Thunder Neural Networks Trainer - Classification - L-BFGS Utility Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The L-BFGS trainer minimizes the full-batch objective (average loss over all the samples plus the regularizer)
+ * over the contiguous parameter vector of the machine. The search direction comes from the last m pairs of
+ * parameter and gradient changes, and each step is taken by a line search satisfying the strong Wolfe conditions.
+ * The full-batch gradient is accumulated by nthreads threads, each on a clone of the machine and a contiguous
+ * share of the samples, and reduced in the order of the threads.
+ *
+ * This header defines the following structure:
+ * tnn_trainer_class_lbfgs(size_t m, double epsilon, size_t niter, size_t nthreads, size_t nls, size_t titer,
+ *                         double f)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_trainer_class_init_lbfgs(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                        double lambda, size_t m, double epsilon, size_t niter, size_t nthreads);
+ * tnn_error tnn_trainer_class_train_lbfgs(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_lbfgs(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_lbfgs(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_lbfgs(tnn_trainer_class *t, size_t *titer);
+ * tnn_error tnn_trainer_class_objective_lbfgs(tnn_trainer_class *t, double *f);
+ */
+
+#include <stddef.h> //For size_t
+#include <tnn/tnn_trainer_class.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#ifndef TNN_TRAINER_CLASS_LBFGS_H
+#define TNN_TRAINER_CLASS_LBFGS_H
+
+//Sufficient decrease and curvature constants of the strong Wolfe conditions
+#define TNN_TRAINER_CLASS_LBFGS_C1 1e-4
+#define TNN_TRAINER_CLASS_LBFGS_C2 0.9
+
+//Maximum objective evaluations in one line search
+#define TNN_TRAINER_CLASS_LBFGS_NLS 20
+
+//The training parameters
+typedef struct __STRUCT_tnn_trainer_class_lbfgs{
+  size_t m; //Number of correction pairs kept
+  double epsilon; //Exit criterion on the 2-norm of the gradient: 0 if not used
+  size_t niter; //Maximum iterations
+  size_t nthreads; //Threads accumulating the full-batch gradient
+  size_t nls; //Maximum objective evaluations in one line search
+  size_t titer; //True iterations executed
+  double f; //Objective at the end of the last training
+} tnn_trainer_class_lbfgs;
+
+//Initialize a trainer to be lbfgs trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_lbfgs(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                       double lambda, size_t m, double epsilon, size_t niter, size_t nthreads);
+
+//Train all the samples as one batch using L-BFGS
+//The training stops after niter iterations, when the gradient norm is at most epsilon, or when no step along
+//the steepest descent direction satisfies the line search. The result is the same for the same number of threads.
+tnn_error tnn_trainer_class_train_lbfgs(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_lbfgs(tnn_trainer_class *t);
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_lbfgs(tnn_trainer_class *t);
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_lbfgs(tnn_trainer_class *t, size_t *titer);
+
+//Get the objective at the end of the last training
+tnn_error tnn_trainer_class_objective_lbfgs(tnn_trainer_class *t, double *f);
+
+#endif //TNN_TRAINER_CLASS_LBFGS_H
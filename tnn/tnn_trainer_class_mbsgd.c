@@ -0,0 +1,401 @@
+/* Thunder Neural Networks Trainer - Classification - Minibatch SGD Utility Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_trainer_class_init_mbsgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                        double lambda, double eta, size_t batch, double epsilon, size_t eiter,
+ *                                        size_t niter);
+ * tnn_error tnn_trainer_class_learn_mbsgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+ * tnn_error tnn_trainer_class_train_mbsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_mbsgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_mbsgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_mbsgd(tnn_trainer_class *t, size_t *titer);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h> //For size_t
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_mbsgd.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+
+//Initialize a trainer to be mbsgd trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_mbsgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                       double lambda, double eta, size_t batch, double epsilon, size_t eiter,
+                                       size_t niter){
+  tnn_error ret;
+
+  //Check the paramters
+  if(lambda < 0 || eta < 0 || batch < 1 || epsilon < 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+  if(eiter < 1){
+    eiter = 1;
+  }
+  if(niter < 1 && epsilon == 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+
+  //Defined type
+  t->t = TNN_TRAINER_CLASS_TYPE_MBSGD;
+
+  //Constant paramters
+  t->c = (tnn_trainer_class_mbsgd *) malloc(sizeof(tnn_trainer_class_mbsgd));
+  if(t->c == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  ((tnn_trainer_class_mbsgd*)t->c)->eta = eta;
+  ((tnn_trainer_class_mbsgd*)t->c)->batch = batch;
+  ((tnn_trainer_class_mbsgd*)t->c)->epsilon = epsilon;
+  ((tnn_trainer_class_mbsgd*)t->c)->eiter = eiter;
+  ((tnn_trainer_class_mbsgd*)t->c)->niter = niter;
+  ((tnn_trainer_class_mbsgd*)t->c)->titer = 0;
+  ((tnn_trainer_class_mbsgd*)t->c)->g = NULL;
+  ((tnn_trainer_class_mbsgd*)t->c)->gsize = 0;
+
+  //lset
+  t->lset = lset;
+
+  //Losses
+  t->losses = gsl_vector_alloc(t->lset->size1);
+
+  //Initialize the machine
+  TNN_MACRO_ERRORTEST(tnn_machine_init(&t->m, ninput, noutput),ret);
+
+  //Initialize the label
+  t->label = (tnn_state *) malloc(sizeof(tnn_state));
+  if(t->label == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  TNN_MACRO_ERRORTEST(tnn_state_init(t->label, noutput),ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_state_alloc(&t->m, t->label),ret);
+
+  //Initialize the regularization parameter
+  t->lambda = lambda;
+
+  //Initialize methods
+  t->learn = tnn_trainer_class_learn_mbsgd;
+  t->train = tnn_trainer_class_train_mbsgd;
+  t->debug = tnn_trainer_class_debug_mbsgd;
+  t->destroy = tnn_trainer_class_destroy_mbsgd;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Allocate the gradient accumulator for the parameter p, if not yet done for its size
+static tnn_error tnn_trainer_class_mbsgd_accumulator(tnn_trainer_class_mbsgd *c, tnn_param *p){
+  void *g;
+
+  if(c->g != NULL && c->gsize == p->size){
+    return TNN_ERROR_SUCCESS;
+  }
+  if(posix_memalign(&g, TNN_TRAINER_CLASS_MBSGD_ALIGN, (p->size > 0 ? p->size : 1)*sizeof(double)) != 0){
+    return TNN_ERROR_ALLOC;
+  }
+  if(c->g != NULL){
+    free(c->g);
+  }
+  c->g = (double *) g;
+  c->gsize = p->size;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Forward and backward propagate one sample, store (first) or add its parameter gradient into g, and add its loss
+//to *l
+static tnn_error tnn_trainer_class_mbsgd_sample(tnn_trainer_class *t, tnn_state *sin, tnn_param *p, gsl_vector *input,
+                                                size_t label, int first, double *l){
+  tnn_trainer_class_mbsgd *c;
+  gsl_vector_view lb;
+  tnn_error ret;
+  double *restrict g, *restrict dx;
+  size_t i, n;
+
+  //Check the label
+  if(label >= t->lset->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  lb = gsl_matrix_row(t->lset, label);
+
+  //Copy the data into the input/label and do forward and backward propagation
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(input, &sin->x));
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&lb.vector, &t->label->x));
+  TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
+  *l = *l + gsl_vector_get(&t->l.output->x, 0);
+
+  //Accumulate the gradient
+  c = (tnn_trainer_class_mbsgd*)t->c;
+  g = c->g;
+  dx = p->dx->data;
+  n = p->size;
+  if(first){
+    memcpy(g, dx, n*sizeof(double));
+  } else {
+    for(i = 0; i < n; i = i + 1){
+      g[i] = g[i] + dx[i];
+    }
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Apply the average gradient of nb samples in g, the regularizer and the update to the parameter in one pass, adding
+//the squared norm of the update to *s. The regularizer derivative is left in p->dx for regularizers other than L1
+//and L2, which take a pass of their own.
+static tnn_error tnn_trainer_class_mbsgd_update(tnn_trainer_class *t, tnn_param *p, size_t nb, double *s){
+  tnn_trainer_class_mbsgd *c;
+  tnn_error ret;
+  double *restrict x, *restrict g, *restrict dx;
+  double a, l, eta, d, e;
+  size_t i, n;
+
+  c = (tnn_trainer_class_mbsgd*)t->c;
+  x = p->x->data;
+  g = c->g;
+  n = p->size;
+  a = 1.0/(double)nb;
+  eta = c->eta;
+  e = 0.0;
+  if(t->r.t == TNN_REG_TYPE_L1){
+    for(i = 0; i < n; i = i + 1){
+      d = eta*(a*g[i] + t->lambda*(double)((x[i] > 0.0) - (x[i] < 0.0)));
+      x[i] = x[i] - d;
+      e = e + d*d;
+    }
+  } else if(t->r.t == TNN_REG_TYPE_L2){
+    l = 2.0*t->lambda;
+    for(i = 0; i < n; i = i + 1){
+      d = eta*(a*g[i] + l*x[i]);
+      x[i] = x[i] - d;
+      e = e + d*d;
+    }
+  } else {
+    l = 0.0;
+    if(t->r.d != NULL && t->lambda != 0.0){
+      TNN_MACRO_ERRORTEST(tnn_reg_d(&t->r, p->x, p->dx), ret);
+      l = t->lambda;
+    }
+    dx = p->dx->data;
+    for(i = 0; i < n; i = i + 1){
+      d = eta*(a*g[i] + l*dx[i]);
+      x[i] = x[i] - d;
+      e = e + d*d;
+    }
+  }
+  *s = *s + e;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Learn one sample as a batch of its own using minibatch stochastic gradient descent
+tnn_error tnn_trainer_class_learn_mbsgd(tnn_trainer_class *t, gsl_vector *input, size_t label){
+  tnn_error ret;
+  tnn_state *sin;
+  tnn_param *p;
+  double s, l;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MBSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Check the input
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin),ret);
+  if(input->size != sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Set the loss output dx to be 1
+  gsl_vector_set(&t->l.output->dx, 0, 1.0);
+
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  if(p->size > 0 && (p->x->stride != 1 || p->dx->stride != 1)){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_mbsgd_accumulator((tnn_trainer_class_mbsgd*)t->c, p), ret);
+  s = 0.0;
+  l = 0.0;
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_mbsgd_sample(t, sin, p, input, label, 1, &l), ret);
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_mbsgd_update(t, p, 1, &s), ret);
+
+  //Set the titer parameter
+  ((tnn_trainer_class_mbsgd*)t->c)->titer = 1;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Data of the steps of train_mbsgd
+typedef struct __STRUCT_tnn_trainer_class_mbsgd_data{
+  gsl_matrix *inputs; //Input matrix
+  size_t *labels; //Labels of inputs
+  tnn_state *sin; //Input state of the machine
+  tnn_param *p; //Parameter the steps are taken on
+} tnn_trainer_class_mbsgd_data;
+
+//Take step k of train_mbsgd on the batch it visits, adding the average loss of the batch to *l
+static tnn_error tnn_trainer_class_mbsgd_train_step(tnn_trainer_class *t, void *data, size_t k, double *s,
+                                                    double *l){
+  tnn_error ret;
+  tnn_trainer_class_mbsgd *c;
+  tnn_trainer_class_mbsgd_data *d;
+  gsl_vector_view in;
+  double bl;
+  size_t j,b;
+
+  c = (tnn_trainer_class_mbsgd*)t->c;
+  d = (tnn_trainer_class_mbsgd_data*)data;
+  for(bl = 0.0, b = 0; b < c->batch; b = b + 1){
+    j = (k*c->batch + b)%d->inputs->size1;
+    in = gsl_matrix_row(d->inputs, j);
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_mbsgd_sample(t, d->sin, d->p, &in.vector, d->labels[j], b == 0, &bl), ret);
+  }
+  *l = *l + bl/(double)c->batch;
+
+  return tnn_trainer_class_mbsgd_update(t, d->p, c->batch, s);
+}
+
+//Train all the samples using minibatch stochastic gradient descent
+tnn_error tnn_trainer_class_train_mbsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_error ret;
+  tnn_trainer_class_mbsgd *c;
+  tnn_trainer_class_mbsgd_data d;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MBSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Check the input
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &d.sin),ret);
+  if(inputs->size2 != d.sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Set the loss output dx to be 1
+  gsl_vector_set(&t->l.output->dx, 0, 1.0);
+
+  //Get the parameter and allocate the accumulator
+  c = (tnn_trainer_class_mbsgd*)t->c;
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &d.p), ret);
+  if(d.p->size > 0 && (d.p->x->stride != 1 || d.p->dx->stride != 1)){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_mbsgd_accumulator(c, d.p), ret);
+
+  //Into the main loop
+  d.inputs = inputs;
+  d.labels = labels;
+  c->titer = 0;
+  return tnn_trainer_class_iterate(t, tnn_trainer_class_mbsgd_train_step, NULL, &d, c->epsilon, 0.0, c->eiter,
+                                   c->niter, &c->titer);
+}
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_mbsgd(tnn_trainer_class *t){
+  tnn_error ret;
+  size_t i,j;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MBSGD){
+    printf("Trainer classifcation (Minibatch SGD) mistype\n");
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+
+  printf("Trainer classification (Minibatch SGD) = %p, type = %d, constant = %p, label_set = %p, lambda = %g\n", t, t->t, t->c, t->lset, t->lambda);
+  printf("losses = %p, learn = %p, train = %p, debug = %p, destroy = %p\n", t->losses, t->learn, t->train, t->debug, t->destroy);
+  printf("eta = %g, batch = %ld, epsilon = %g, eiter = %ld, niter = %ld, titer = %ld, g = %p, gsize = %ld\n",
+	 ((tnn_trainer_class_mbsgd*)t->c)->eta,
+	 ((tnn_trainer_class_mbsgd*)t->c)->batch,
+	 ((tnn_trainer_class_mbsgd*)t->c)->epsilon,
+	 ((tnn_trainer_class_mbsgd*)t->c)->eiter,
+	 ((tnn_trainer_class_mbsgd*)t->c)->niter,
+	 ((tnn_trainer_class_mbsgd*)t->c)->titer,
+	 ((tnn_trainer_class_mbsgd*)t->c)->g,
+	 ((tnn_trainer_class_mbsgd*)t->c)->gsize);
+
+  printf("machine: ");
+  if((ret = tnn_machine_debug(&t->m)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_MODULE_FUNCNDEF){
+    printf("machine debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("loss: ");
+  if((ret = tnn_loss_debug(&t->l)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_LOSS_FUNCNDEF){
+    printf("loss debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("label: ");
+  if((ret = tnn_state_debug(t->label)) != TNN_ERROR_SUCCESS){
+    printf("label state debug error in trainer classification\n");
+    return ret;
+  }
+
+  printf("regularizer: ");
+  if((ret = tnn_reg_debug(&t->r)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_REG_FUNCNDEF){
+    printf("regularizer debug error in classification\n");
+    return ret;
+  }
+
+  printf("label_set: size1 = %ld, size2 = %ld\n", t->lset->size1, t->lset->size2);
+  for(i = 0; i < t->lset->size1; i = i + 1){
+    printf("%ld:", i);
+    for(j = 0; j < t->lset->size2; j = j + 1){
+      printf(" %g", gsl_matrix_get(t->lset, i, j));
+    }
+    printf("\n");
+  }
+
+  printf("losses: size = %ld, values:", t->losses->size);
+  for(i = 0; i < t->losses->size; i = i + 1){
+    printf(" %g", gsl_vector_get(t->losses, i));
+  }
+  printf("\n");
+
+  return ret;
+}
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_mbsgd(tnn_trainer_class *t){
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MBSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Destroy the gradient accumulator
+  if(((tnn_trainer_class_mbsgd*)t->c)->g != NULL){
+    free(((tnn_trainer_class_mbsgd*)t->c)->g);
+  }
+
+  //Destroy the parameter
+  free((tnn_trainer_class_mbsgd*)t->c);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_mbsgd(tnn_trainer_class *t, size_t *titer){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MBSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  *titer = ((tnn_trainer_class_mbsgd*)t->c)->titer;
+  return TNN_ERROR_SUCCESS;
+}
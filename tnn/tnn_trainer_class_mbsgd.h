@@ -0,0 +1,69 @@
+/* Thunder Neural Networks Trainer - Classification - Minibatch SGD Utility Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The minibatch trainer takes batch samples per step. Each sample is propagated forward and backward in turn
+ * and its parameter gradient added to an accumulator, then a single fused pass applies the averaged gradient,
+ * the regularizer derivative and the update to x. The regularizer and the update therefore stream the
+ * parameters once per batch instead of once per sample. A step is one batch: eiter, niter and titer count
+ * batches, and step k takes the samples k*batch to (k + 1)*batch - 1, wrapping around the data.
+ *
+ * This header defines the following structure:
+ * tnn_trainer_class_mbsgd(double eta, size_t batch, double epsilon, size_t eiter, size_t niter, size_t titer,
+ *                         double *g, size_t gsize)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_trainer_class_init_mbsgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                        double lambda, double eta, size_t batch, double epsilon, size_t eiter,
+ *                                        size_t niter);
+ * tnn_error tnn_trainer_class_learn_mbsgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+ * tnn_error tnn_trainer_class_train_mbsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_mbsgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_mbsgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_mbsgd(tnn_trainer_class *t, size_t *titer);
+ */
+
+#include <stddef.h> //For size_t
+#include <tnn/tnn_trainer_class.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#ifndef TNN_TRAINER_CLASS_MBSGD_H
+#define TNN_TRAINER_CLASS_MBSGD_H
+
+//Alignment of the gradient accumulator in bytes
+#define TNN_TRAINER_CLASS_MBSGD_ALIGN 64
+
+//The training parameters
+typedef struct __STRUCT_tnn_trainer_class_mbsgd{
+  double eta; //Step size
+  size_t batch; //Samples in a batch
+  double epsilon; //Exit criterion on the root of the summed squared norms of eiter steps: 0 if not used
+  size_t eiter; //For speed, after eiter steps we test whether to exit
+  size_t niter; //Exit step size criterion
+  size_t titer; //True steps executed
+  double *g; //Gradient accumulator: NULL until the first step
+  size_t gsize; //Size of the gradient accumulator
+} tnn_trainer_class_mbsgd;
+
+//Initialize a trainer to be mbsgd trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_mbsgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                       double lambda, double eta, size_t batch, double epsilon, size_t eiter,
+                                       size_t niter);
+
+//Learn one sample as a batch of its own using minibatch stochastic gradient descent
+tnn_error tnn_trainer_class_learn_mbsgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+
+//Train all the samples using minibatch stochastic gradient descent
+tnn_error tnn_trainer_class_train_mbsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_mbsgd(tnn_trainer_class *t);
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_mbsgd(tnn_trainer_class *t);
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_mbsgd(tnn_trainer_class *t, size_t *titer);
+
+#endif //TNN_TRAINER_CLASS_MBSGD_H
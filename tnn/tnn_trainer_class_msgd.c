@@ -0,0 +1,375 @@
+/* Thunder Neural Networks Trainer - Classification - Momentum SGD Utility Source
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * This source implements the following functions:
+ * tnn_error tnn_trainer_class_init_msgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                       double lambda, double eta, double mu, int nesterov, double epsilon,
+ *                                       size_t eiter, size_t niter);
+ * tnn_error tnn_trainer_class_learn_msgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+ * tnn_error tnn_trainer_class_train_msgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_msgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_msgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_msgd(tnn_trainer_class *t, size_t *titer);
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stddef.h> //For size_t
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tnn/tnn_error.h>
+#include <tnn/tnn_macro.h>
+#include <tnn/tnn_trainer_class.h>
+#include <tnn/tnn_trainer_class_msgd.h>
+#include <tnn/tnn_machine.h>
+#include <tnn/tnn_loss.h>
+#include <tnn/tnn_reg.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+
+//Initialize a trainer to be msgd trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_msgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                      double lambda, double eta, double mu, int nesterov, double epsilon,
+                                      size_t eiter, size_t niter){
+  tnn_error ret;
+
+  //Check the paramters
+  if(lambda < 0 || eta < 0 || mu < 0 || mu >= 1 || epsilon < 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+  if(eiter < 1){
+    eiter = 1;
+  }
+  if(niter < 1 && epsilon == 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+
+  //Defined type
+  t->t = TNN_TRAINER_CLASS_TYPE_MSGD;
+
+  //Constant paramters
+  t->c = (tnn_trainer_class_msgd *) malloc(sizeof(tnn_trainer_class_msgd));
+  if(t->c == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  ((tnn_trainer_class_msgd*)t->c)->eta = eta;
+  ((tnn_trainer_class_msgd*)t->c)->mu = mu;
+  ((tnn_trainer_class_msgd*)t->c)->nesterov = nesterov;
+  ((tnn_trainer_class_msgd*)t->c)->epsilon = epsilon;
+  ((tnn_trainer_class_msgd*)t->c)->eiter = eiter;
+  ((tnn_trainer_class_msgd*)t->c)->niter = niter;
+  ((tnn_trainer_class_msgd*)t->c)->titer = 0;
+  ((tnn_trainer_class_msgd*)t->c)->v = NULL;
+  ((tnn_trainer_class_msgd*)t->c)->vsize = 0;
+
+  //lset
+  t->lset = lset;
+
+  //Losses
+  t->losses = gsl_vector_alloc(t->lset->size1);
+
+  //Initialize the machine
+  TNN_MACRO_ERRORTEST(tnn_machine_init(&t->m, ninput, noutput),ret);
+
+  //Initialize the label
+  t->label = (tnn_state *) malloc(sizeof(tnn_state));
+  if(t->label == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  TNN_MACRO_ERRORTEST(tnn_state_init(t->label, noutput),ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_state_alloc(&t->m, t->label),ret);
+
+  //Initialize the regularization parameter
+  t->lambda = lambda;
+
+  //Initialize methods
+  t->learn = tnn_trainer_class_learn_msgd;
+  t->train = tnn_trainer_class_train_msgd;
+  t->debug = tnn_trainer_class_debug_msgd;
+  t->destroy = tnn_trainer_class_destroy_msgd;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Allocate a zero velocity for the parameter p, if not yet done for its size
+static tnn_error tnn_trainer_class_msgd_velocity(tnn_trainer_class_msgd *c, tnn_param *p){
+  void *v;
+
+  if(c->v != NULL && c->vsize == p->size){
+    return TNN_ERROR_SUCCESS;
+  }
+  if(posix_memalign(&v, TNN_TRAINER_CLASS_MSGD_ALIGN, (p->size > 0 ? p->size : 1)*sizeof(double)) != 0){
+    return TNN_ERROR_ALLOC;
+  }
+  memset(v, 0, p->size*sizeof(double));
+  if(c->v != NULL){
+    free(c->v);
+  }
+  c->v = (double *) v;
+  c->vsize = p->size;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Update the velocity and the parameter from the gradient in p->dx, in one pass over x, dx and v, adding the squared
+//norm of the update to *s. With a = 1, b = 0 this is heavy-ball momentum, and with a = mu, b = -eta it is Nesterov
+//momentum.
+static tnn_error tnn_trainer_class_msgd_update(tnn_trainer_class *t, tnn_param *p, double *s){
+  tnn_trainer_class_msgd *c;
+  tnn_error ret;
+  double *restrict x, *restrict dx, *restrict v;
+  double eta, mu, a, b, l, g, d, e;
+  size_t i, n;
+
+  c = (tnn_trainer_class_msgd*)t->c;
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_msgd_velocity(c, p), ret);
+  if(p->size > 0 && (p->x->stride != 1 || p->dx->stride != 1)){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Other regularizers add their derivatives in a pass of their own
+  l = 0.0;
+  if(t->r.t == TNN_REG_TYPE_L1 || t->r.t == TNN_REG_TYPE_L2){
+    l = t->r.t == TNN_REG_TYPE_L2 ? 2.0*t->lambda : t->lambda;
+  } else if(t->r.d != NULL && t->lambda != 0.0){
+    TNN_MACRO_ERRORTEST(tnn_reg_addd(&t->r, p->x, p->dx, t->lambda), ret);
+  }
+
+  x = p->x->data;
+  dx = p->dx->data;
+  v = c->v;
+  n = p->size;
+  eta = c->eta;
+  mu = c->mu;
+  a = c->nesterov ? mu : 1.0;
+  b = c->nesterov ? -eta : 0.0;
+  e = 0.0;
+  if(t->r.t == TNN_REG_TYPE_L1){
+    for(i = 0; i < n; i = i + 1){
+      g = dx[i] + l*(double)((x[i] > 0.0) - (x[i] < 0.0));
+      v[i] = mu*v[i] - eta*g;
+      d = a*v[i] + b*g;
+      x[i] = x[i] + d;
+      e = e + d*d;
+    }
+  } else {
+    for(i = 0; i < n; i = i + 1){
+      g = dx[i] + l*x[i];
+      v[i] = mu*v[i] - eta*g;
+      d = a*v[i] + b*g;
+      x[i] = x[i] + d;
+      e = e + d*d;
+    }
+  }
+  *s = *s + e;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Forward and backward propagate one sample and update the parameters, adding the squared norm of the update to *s
+//and the loss to *l
+static tnn_error tnn_trainer_class_msgd_step(tnn_trainer_class *t, tnn_state *sin, tnn_param *p, gsl_vector *input,
+                                             size_t label, double *s, double *l){
+  gsl_vector_view lb;
+  tnn_error ret;
+
+  //Check the label
+  if(label >= t->lset->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  lb = gsl_matrix_row(t->lset, label);
+
+  //Copy the data into the input/label and do forward and backward propagation
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(input, &sin->x));
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&lb.vector, &t->label->x));
+  TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
+  *l = *l + gsl_vector_get(&t->l.output->x, 0);
+
+  return tnn_trainer_class_msgd_update(t, p, s);
+}
+
+//Learn one sample using momentum stochastic gradient descent
+tnn_error tnn_trainer_class_learn_msgd(tnn_trainer_class *t, gsl_vector *input, size_t label){
+  tnn_error ret;
+  tnn_state *sin;
+  tnn_param *p;
+  double s, l;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Check the input
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin),ret);
+  if(input->size != sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Set the loss output dx to be 1
+  gsl_vector_set(&t->l.output->dx, 0, 1.0);
+
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  s = 0.0;
+  l = 0.0;
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_msgd_step(t, sin, p, input, label, &s, &l), ret);
+
+  //Set the titer parameter
+  ((tnn_trainer_class_msgd*)t->c)->titer = 1;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Data of the steps of train_msgd
+typedef struct __STRUCT_tnn_trainer_class_msgd_data{
+  gsl_matrix *inputs; //Input matrix
+  size_t *labels; //Labels of inputs
+  tnn_state *sin; //Input state of the machine
+  tnn_param *p; //Parameter the steps are taken on
+} tnn_trainer_class_msgd_data;
+
+//Take step k of train_msgd on the sample it visits
+static tnn_error tnn_trainer_class_msgd_train_step(tnn_trainer_class *t, void *data, size_t k, double *s,
+                                                   double *l){
+  tnn_trainer_class_msgd_data *d;
+  gsl_vector_view in;
+  size_t j;
+
+  d = (tnn_trainer_class_msgd_data*)data;
+  j = k%d->inputs->size1;
+  in = gsl_matrix_row(d->inputs, j);
+  return tnn_trainer_class_msgd_step(t, d->sin, d->p, &in.vector, d->labels[j], s, l);
+}
+
+//Train all the samples using momentum stochastic gradient descent
+tnn_error tnn_trainer_class_train_msgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  tnn_error ret;
+  tnn_trainer_class_msgd *c;
+  tnn_trainer_class_msgd_data d;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Check the input
+  TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &d.sin),ret);
+  if(inputs->size2 != d.sin->size){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+
+  //Set the loss output dx to be 1
+  gsl_vector_set(&t->l.output->dx, 0, 1.0);
+
+  //Into the main loop
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &d.p), ret);
+  d.inputs = inputs;
+  d.labels = labels;
+  c = (tnn_trainer_class_msgd*)t->c;
+  c->titer = 0;
+  return tnn_trainer_class_iterate(t, tnn_trainer_class_msgd_train_step, NULL, &d, c->epsilon, 0.0, c->eiter,
+                                   c->niter, &c->titer);
+}
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_msgd(tnn_trainer_class *t){
+  tnn_error ret;
+  size_t i,j;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MSGD){
+    printf("Trainer classifcation (Momentum SGD) mistype\n");
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  ret = TNN_ERROR_SUCCESS;
+
+  printf("Trainer classification (Momentum SGD) = %p, type = %d, constant = %p, label_set = %p, lambda = %g\n", t, t->t, t->c, t->lset, t->lambda);
+  printf("losses = %p, learn = %p, train = %p, debug = %p, destroy = %p\n", t->losses, t->learn, t->train, t->debug, t->destroy);
+  printf("eta = %g, mu = %g, nesterov = %d, epsilon = %g, eiter = %ld, niter = %ld, titer = %ld, v = %p, vsize = %ld\n",
+	 ((tnn_trainer_class_msgd*)t->c)->eta,
+	 ((tnn_trainer_class_msgd*)t->c)->mu,
+	 ((tnn_trainer_class_msgd*)t->c)->nesterov,
+	 ((tnn_trainer_class_msgd*)t->c)->epsilon,
+	 ((tnn_trainer_class_msgd*)t->c)->eiter,
+	 ((tnn_trainer_class_msgd*)t->c)->niter,
+	 ((tnn_trainer_class_msgd*)t->c)->titer,
+	 ((tnn_trainer_class_msgd*)t->c)->v,
+	 ((tnn_trainer_class_msgd*)t->c)->vsize);
+
+  printf("machine: ");
+  if((ret = tnn_machine_debug(&t->m)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_MODULE_FUNCNDEF){
+    printf("machine debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("loss: ");
+  if((ret = tnn_loss_debug(&t->l)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_LOSS_FUNCNDEF){
+    printf("loss debug error in trainer classsification\n");
+    return ret;
+  }
+
+  printf("label: ");
+  if((ret = tnn_state_debug(t->label)) != TNN_ERROR_SUCCESS){
+    printf("label state debug error in trainer classification\n");
+    return ret;
+  }
+
+  printf("regularizer: ");
+  if((ret = tnn_reg_debug(&t->r)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_REG_FUNCNDEF){
+    printf("regularizer debug error in classification\n");
+    return ret;
+  }
+
+  printf("label_set: size1 = %ld, size2 = %ld\n", t->lset->size1, t->lset->size2);
+  for(i = 0; i < t->lset->size1; i = i + 1){
+    printf("%ld:", i);
+    for(j = 0; j < t->lset->size2; j = j + 1){
+      printf(" %g", gsl_matrix_get(t->lset, i, j));
+    }
+    printf("\n");
+  }
+
+  printf("losses: size = %ld, values:", t->losses->size);
+  for(i = 0; i < t->losses->size; i = i + 1){
+    printf(" %g", gsl_vector_get(t->losses, i));
+  }
+  printf("\n");
+
+  return ret;
+}
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_msgd(tnn_trainer_class *t){
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  //Destroy the velocity
+  if(((tnn_trainer_class_msgd*)t->c)->v != NULL){
+    free(((tnn_trainer_class_msgd*)t->c)->v);
+  }
+
+  //Destroy the parameter
+  free((tnn_trainer_class_msgd*)t->c);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_msgd(tnn_trainer_class *t, size_t *titer){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_MSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  *titer = ((tnn_trainer_class_msgd*)t->c)->titer;
+  return TNN_ERROR_SUCCESS;
+}
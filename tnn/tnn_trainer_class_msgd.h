@@ -0,0 +1,69 @@
+/* Thunder Neural Networks Trainer - Classification - Momentum SGD Utility Header
+ * By Xiang Zhang @ New York University
+ * Version 0.1, 10/19/2026
+ *
+ * The momentum trainer keeps a velocity v of the size of the parameters. With g = dx + lambda*reg'(x), each
+ * step does v = mu*v - eta*g, then x = x + v (heavy-ball) or x = x + mu*v - eta*g (Nesterov, in the form that
+ * takes the gradient at the current parameters). The regularizer derivative, the velocity and the parameter
+ * update are fused into one pass over x, dx and v for the L1 and L2 regularizers.
+ *
+ * This header defines the following structure:
+ * tnn_trainer_class_msgd(double eta, double mu, int nesterov, double epsilon, size_t eiter, size_t niter,
+ *                        size_t titer, double *v, size_t vsize)
+ *
+ * This header defines the following functions:
+ * tnn_error tnn_trainer_class_init_msgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+ *                                       double lambda, double eta, double mu, int nesterov, double epsilon,
+ *                                       size_t eiter, size_t niter);
+ * tnn_error tnn_trainer_class_learn_msgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+ * tnn_error tnn_trainer_class_train_msgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_debug_msgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_destroy_msgd(tnn_trainer_class *t);
+ * tnn_error tnn_trainer_class_titer_msgd(tnn_trainer_class *t, size_t *titer);
+ */
+
+#include <stddef.h> //For size_t
+#include <tnn/tnn_trainer_class.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+
+#ifndef TNN_TRAINER_CLASS_MSGD_H
+#define TNN_TRAINER_CLASS_MSGD_H
+
+//Alignment of the velocity in bytes
+#define TNN_TRAINER_CLASS_MSGD_ALIGN 64
+
+//The training parameters
+typedef struct __STRUCT_tnn_trainer_class_msgd{
+  double eta; //Step size
+  double mu; //Momentum
+  int nesterov; //Whether to use Nesterov momentum
+  double epsilon; //Exit criterion on the root of the summed squared norms of eiter steps: 0 if not used
+  size_t eiter; //For speed, after eiter steps we test whether to exit
+  size_t niter; //Exit step size criterion
+  size_t titer; //True steps executed
+  double *v; //Velocity: NULL until the first step
+  size_t vsize; //Size of the velocity
+} tnn_trainer_class_msgd;
+
+//Initialize a trainer to be msgd trainer. The lset is managed by the trainer
+tnn_error tnn_trainer_class_init_msgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
+                                      double lambda, double eta, double mu, int nesterov, double epsilon,
+                                      size_t eiter, size_t niter);
+
+//Learn one sample using momentum stochastic gradient descent
+tnn_error tnn_trainer_class_learn_msgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
+
+//Train all the samples using momentum stochastic gradient descent
+tnn_error tnn_trainer_class_train_msgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+
+//Debug this trainer
+tnn_error tnn_trainer_class_debug_msgd(tnn_trainer_class *t);
+
+//Destroy this trainer
+tnn_error tnn_trainer_class_destroy_msgd(tnn_trainer_class *t);
+
+//Get the true number of iterations executed
+tnn_error tnn_trainer_class_titer_msgd(tnn_trainer_class *t, size_t *titer);
+
+#endif //TNN_TRAINER_CLASS_MSGD_H
@@ -8,14 +8,26 @@
  *                                       double lambda, double eta, double epsilon, size_t eiter, size_t niter);
  * tnn_error tnn_trainer_class_learn_nsgd(tnn_trainer_class *t, gsl_vector *input, size_t label);
  * tnn_error tnn_trainer_class_train_nsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels);
+ * tnn_error tnn_trainer_class_train_dataset_nsgd(tnn_trainer_class *t, tnn_dataset *ds);
+ * tnn_error tnn_trainer_class_train_loader_nsgd(tnn_trainer_class *t, tnn_loader *ld);
+ * tnn_error tnn_trainer_class_train_sparse_nsgd(tnn_trainer_class *t, tnn_sparse *inputs, size_t *labels);
  * tnn_error tnn_trainer_class_debug_nsgd(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_destroy_nsgd(tnn_trainer_class *t);
  * tnn_error tnn_trainer_class_titer_nsgd(tnn_trainer_class *t, size_t *titer);
+ * tnn_error tnn_trainer_class_checkpoint_nsgd(tnn_trainer_class *t, const char *file, size_t citer);
+ * tnn_error tnn_trainer_class_resume_nsgd(tnn_trainer_class *t, const char *file);
+ * tnn_error tnn_trainer_class_shuffle_nsgd(tnn_trainer_class *t, unsigned long seed, size_t prefetch);
+ * tnn_error tnn_trainer_class_lazy_nsgd(tnn_trainer_class *t, int lazy);
+ * tnn_error tnn_trainer_class_prox_nsgd(tnn_trainer_class *t, int prox);
+ * tnn_error tnn_trainer_class_sparsity_nsgd(tnn_trainer_class *t, size_t *nzero);
+ * tnn_error tnn_trainer_class_stop_nsgd(tnn_trainer_class *t, double delta);
  */
 
 #include <stddef.h> //For size_t
 #include <stdio.h>
+#include <stdlib.h>
 #include <float.h>
+#include <math.h>
 #include <tnn/tnn_error.h>
 #include <tnn/tnn_macro.h>
 #include <tnn/tnn_trainer_class.h>
@@ -23,9 +35,18 @@
 #include <tnn/tnn_machine.h>
 #include <tnn/tnn_loss.h>
 #include <tnn/tnn_reg.h>
+#include <tnn/tnn_dataset.h>
+#include <tnn/tnn_loader.h>
+#include <tnn/tnn_ckpt.h>
+#include <tnn/tnn_sparse.h>
+#include <tnn/tnn_module.h>
+#include <tnn/tnn_module_linear_sparse.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_permutation.h>
 
 //Initialize a trainer to be nsgd trainer. The lset is managed by the trainer
 tnn_error tnn_trainer_class_init_nsgd(tnn_trainer_class *t, size_t ninput, size_t noutput, gsl_matrix *lset,
@@ -53,6 +74,23 @@ tnn_error tnn_trainer_class_init_nsgd(tnn_trainer_class *t, size_t ninput, size_
   ((tnn_trainer_class_nsgd*)t->c)->eiter = eiter;
   ((tnn_trainer_class_nsgd*)t->c)->niter = niter;
   ((tnn_trainer_class_nsgd*)t->c)->titer = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->siter = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->ckpt = NULL;
+  ((tnn_trainer_class_nsgd*)t->c)->citer = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->rng = NULL;
+  ((tnn_trainer_class_nsgd*)t->c)->seed = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->perm = NULL;
+  ((tnn_trainer_class_nsgd*)t->c)->epoch = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->prefetch = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->lazy = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->lpen = 0.0;
+  ((tnn_trainer_class_nsgd*)t->c)->lu = NULL;
+  ((tnn_trainer_class_nsgd*)t->c)->lsize = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->prox = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->nzero = 0;
+  ((tnn_trainer_class_nsgd*)t->c)->delta = 0.0;
+  ((tnn_trainer_class_nsgd*)t->c)->snorm = 0.0;
+  ((tnn_trainer_class_nsgd*)t->c)->aloss = 0.0;
 
   //lset
   t->lset = lset;
@@ -83,6 +121,49 @@ tnn_error tnn_trainer_class_init_nsgd(tnn_trainer_class *t, size_t ninput, size_
   return TNN_ERROR_SUCCESS;
 }
 
+//Take the gradient step x = x - eta*(dx + lambda*rd) on the n parameters at x (without rd if it is NULL), adding
+//the squared norm of the update to s
+static void tnn_trainer_class_nsgd_step(double *restrict x, const double *restrict dx, const double *restrict rd,
+                                        size_t n, double eta, double lambda, double *s){
+  double d, a;
+  size_t i;
+
+  a = 0.0;
+  if(rd == NULL){
+    for(i = 0; i < n; i = i + 1){
+      d = eta*dx[i];
+      x[i] = x[i] - d;
+      a = a + d*d;
+    }
+  } else {
+    for(i = 0; i < n; i = i + 1){
+      d = eta*(dx[i] + lambda*rd[i]);
+      x[i] = x[i] - d;
+      a = a + d*d;
+    }
+  }
+  *s = *s + a;
+}
+
+//Take the proximal L1 step on the n parameters at x: the gradient step x - eta*dx, shrunk by pen towards 0 and
+//clipped at 0, adding the squared norm of the update to s. Returns the number of parameters left at 0.
+static size_t tnn_trainer_class_nsgd_prox_step(double *restrict x, const double *restrict dx, size_t n, double eta,
+                                               double pen, double *s){
+  double v, d, a;
+  size_t i, z;
+
+  for(a = 0.0, z = 0, i = 0; i < n; i = i + 1){
+    v = x[i] - eta*dx[i];
+    v = v > pen ? v - pen : (v < -pen ? v + pen : 0.0);
+    d = v - x[i];
+    x[i] = v;
+    a = a + d*d;
+    z = z + (v == 0.0);
+  }
+  *s = *s + a;
+  return z;
+}
+
 //Learn one sample using naive stochastic gradient descent
 tnn_error tnn_trainer_class_learn_nsgd(tnn_trainer_class *t, gsl_vector *input, size_t label){
   tnn_error ret;
@@ -113,12 +194,20 @@ tnn_error tnn_trainer_class_learn_nsgd(tnn_trainer_class *t, gsl_vector *input,
   TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
   TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
 
-  //Compute the accumulated regularization paramter
+  //Compute the parameter update, with the proximal L1 step if set
   TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
-  TNN_MACRO_ERRORTEST(tnn_reg_addd(&t->r, p->x, p->dx, t->lambda), ret);
-
-  //Compute the parameter update
-  TNN_MACRO_GSLTEST(gsl_blas_daxpy(-((tnn_trainer_class_nsgd*)t->c)->eta, p->dx, p->x));
+  if(((tnn_trainer_class_nsgd*)t->c)->prox){
+    if(t->r.t != TNN_REG_TYPE_L1 || p->x->stride != 1 || p->dx->stride != 1){
+      return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+    }
+    ((tnn_trainer_class_nsgd*)t->c)->nzero =
+      tnn_trainer_class_nsgd_prox_step(p->x->data, p->dx->data, p->size, ((tnn_trainer_class_nsgd*)t->c)->eta,
+                                       ((tnn_trainer_class_nsgd*)t->c)->eta*t->lambda,
+                                       &((tnn_trainer_class_nsgd*)t->c)->snorm);
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_reg_addd(&t->r, p->x, p->dx, t->lambda), ret);
+    TNN_MACRO_GSLTEST(gsl_blas_daxpy(-((tnn_trainer_class_nsgd*)t->c)->eta, p->dx, p->x));
+  }
 
   //Set the titer parameter
   ((tnn_trainer_class_nsgd*)t->c)->titer = 1;
@@ -126,17 +215,414 @@ tnn_error tnn_trainer_class_learn_nsgd(tnn_trainer_class *t, gsl_vector *input,
   return TNN_ERROR_SUCCESS;
 }
 
-//Train all the samples using naive stochastic gradient descent
-tnn_error tnn_trainer_class_train_nsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+//Shrink the n weights at x by pen towards 0, clipping them at 0
+static void tnn_trainer_class_nsgd_lazy_shrink(double *restrict x, size_t n, double pen){
+  size_t i;
+
+  for(i = 0; i < n; i = i + 1){
+    if(x[i] > pen){
+      x[i] = x[i] - pen;
+    } else if(x[i] < -pen){
+      x[i] = x[i] + pen;
+    } else {
+      x[i] = 0.0;
+    }
+  }
+}
+
+//Apply the penalty (L1) or decay (L2) accumulated since weight row r of the sparse module at offset off was last
+//regularized
+static void tnn_trainer_class_nsgd_lazy_row(tnn_trainer_class *t, tnn_param *p, size_t off, size_t r){
+  tnn_trainer_class_nsgd *c;
+  double *restrict x;
+  double a;
+  size_t i, n;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  if(c->lu[r] == c->lpen){
+    return;
+  }
+  n = t->m.min.output->size;
+  x = p->x->data + off + r*n;
+  if(t->r.t == TNN_REG_TYPE_L1){
+    tnn_trainer_class_nsgd_lazy_shrink(x, n, c->lpen - c->lu[r]);
+  } else {
+    a = c->lpen/c->lu[r];
+    for(i = 0; i < n; i = i + 1){
+      x[i] = a*x[i];
+    }
+  }
+  c->lu[r] = c->lpen;
+}
+
+//Bring every weight row of the sparse module at offset off up to date
+static void tnn_trainer_class_nsgd_lazy_flush(tnn_trainer_class *t, tnn_param *p, size_t off){
+  tnn_trainer_class_nsgd *c;
+  size_t r;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  for(r = 0; r < c->lsize; r = r + 1){
+    tnn_trainer_class_nsgd_lazy_row(t, p, off, r);
+  }
+}
+
+//Update the parameters after the sample in row j of sp with the lazy regularizer, adding the squared norm of the
+//update to *s
+//The rows of the nonzero features were brought up to date before fprop. With L1, this step's penalty is only
+//added to the cumulative one. With L2, the rows of the nonzero features take this step's decay with their
+//gradient, and the global scale takes it for the others; the scale is folded into all the rows and reset when
+//it gets too small. The dense parameters take the gradient and the regularizer derivative in one pass, or the
+//proximal step if set.
+static tnn_error tnn_trainer_class_nsgd_lazy_update(tnn_trainer_class *t, tnn_param *p, tnn_sparse *sp, size_t j,
+                                                   size_t off, double *s){
+  tnn_trainer_class_nsgd *c;
+  double *restrict x, *restrict dx;
+  double eta, l, d, a;
+  size_t i, k, n, w, r;
+  int l1;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  eta = c->eta;
+  l = t->lambda;
+  n = t->m.min.output->size;
+  w = t->m.min.w.size;
+  x = p->x->data;
+  dx = p->dx->data;
+  l1 = (t->r.t == TNN_REG_TYPE_L1);
+
+  //Dense parameters before and after the sparse weights
+  a = 0.0;
+  if(l1 && c->prox){
+    tnn_trainer_class_nsgd_prox_step(x, dx, off, eta, eta*l, s);
+    tnn_trainer_class_nsgd_prox_step(x + off + w, dx + off + w, p->size - off - w, eta, eta*l, s);
+  } else {
+    for(i = 0; i < p->size; i = i + 1){
+      if(i == off && w > 0){
+	i = off + w - 1;
+	continue;
+      }
+      if(l1){
+	d = eta*(dx[i] + l*(double)((x[i] > 0.0) - (x[i] < 0.0)));
+      } else {
+	d = eta*(dx[i] + 2.0*l*x[i]);
+      }
+      x[i] = x[i] - d;
+      a = a + d*d;
+    }
+  }
+
+  //Weight rows of the nonzero features
+  if(l1){
+    for(k = sp->ptr[j]; k < sp->ptr[j + 1]; k = k + 1){
+      r = off + sp->ind[k]*n;
+      for(i = 0; i < n; i = i + 1){
+	d = eta*dx[r + i];
+	x[r + i] = x[r + i] - d;
+	a = a + d*d;
+      }
+    }
+    *s = *s + a;
+    c->lpen = c->lpen + eta*l;
+    return TNN_ERROR_SUCCESS;
+  }
+  c->lpen = c->lpen*(1.0 - 2.0*eta*l);
+  for(k = sp->ptr[j]; k < sp->ptr[j + 1]; k = k + 1){
+    r = off + sp->ind[k]*n;
+    for(i = 0; i < n; i = i + 1){
+      d = eta*(dx[r + i] + 2.0*l*x[r + i]);
+      x[r + i] = x[r + i] - d;
+      a = a + d*d;
+    }
+    c->lu[sp->ind[k]] = c->lpen;
+  }
+  *s = *s + a;
+  if(c->lpen < TNN_TRAINER_CLASS_NSGD_LAZY_RESCALE){
+    tnn_trainer_class_nsgd_lazy_flush(t, p, off);
+    for(r = 0; r < c->lsize; r = r + 1){
+      c->lu[r] = 1.0;
+    }
+    c->lpen = 1.0;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Update the parameters after the sample in row j of sp, with the sparse input module at offset off of p, adding the
+//squared norm of the update to *s
+//Only the weight rows of the nonzero features of the sample are read and written for the data term.
+static tnn_error tnn_trainer_class_nsgd_sparse_update(tnn_trainer_class *t, tnn_param *p, gsl_vector *rd,
+                                                      tnn_sparse *sp, size_t j, size_t off, double *s){
+  tnn_error ret;
+  tnn_trainer_class_nsgd *c;
+  double eta;
+  size_t n, w, k;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  eta = c->eta;
+  n = t->m.min.output->size;
+  w = t->m.min.w.size;
+
+  //The sparse weights are regularized lazily
+  if(c->lazy){
+    return tnn_trainer_class_nsgd_lazy_update(t, p, sp, j, off, s);
+  }
+
+  //The gradient outside the nonzero features is zero, so the proximal step is taken on the whole parameter
+  if(c->prox){
+    c->nzero = tnn_trainer_class_nsgd_prox_step(p->x->data, p->dx->data, p->size, eta, eta*t->lambda, s);
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //The regularizer touches the whole parameter, so the step is taken on it in one pass
+  if(t->lambda != 0.0){
+    TNN_MACRO_ERRORTEST(tnn_reg_d(&t->r, p->x, rd), ret);
+    tnn_trainer_class_nsgd_step(p->x->data, p->dx->data, rd->data, p->size, eta, t->lambda, s);
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Dense parameters before and after the sparse weights
+  tnn_trainer_class_nsgd_step(p->x->data, p->dx->data, NULL, off, eta, 0.0, s);
+  tnn_trainer_class_nsgd_step(p->x->data + off + w, p->dx->data + off + w, NULL, p->size - off - w, eta, 0.0,
+                              s);
+
+  //Weight rows of the nonzero features
+  for(k = sp->ptr[j]; k < sp->ptr[j + 1]; k = k + 1){
+    tnn_trainer_class_nsgd_step(p->x->data + off + sp->ind[k]*n, p->dx->data + off + sp->ind[k]*n, NULL, n, eta,
+                                0.0, s);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the row j visited at step k over n samples: in order, or through the permutation of the epoch of k
+static tnn_error tnn_trainer_class_nsgd_row(tnn_trainer_class_nsgd *c, size_t k, size_t n, size_t *j){
+  if(c->rng == NULL){
+    *j = k%n;
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Draw the permutation of a new epoch
+  if(c->perm == NULL || c->perm->size != n || c->epoch != k/n){
+    if(c->perm != NULL && c->perm->size != n){
+      gsl_permutation_free(c->perm);
+      c->perm = NULL;
+    }
+    if(c->perm == NULL && (c->perm = gsl_permutation_alloc(n)) == NULL){
+      return TNN_ERROR_GSL;
+    }
+    gsl_permutation_init(c->perm);
+    gsl_rng_set(c->rng, c->seed + k/n);
+    gsl_ran_shuffle(c->rng, c->perm->data, n, sizeof(size_t));
+    c->epoch = k/n;
+  }
+
+  *j = gsl_permutation_get(c->perm, k%n);
+  return TNN_ERROR_SUCCESS;
+}
+
+//Prefetch the row visited prefetch steps after step k, if it is in the same epoch
+static void tnn_trainer_class_nsgd_prefetch(tnn_trainer_class_nsgd *c, size_t k, size_t n, gsl_matrix *inputs,
+                                            tnn_sparse *sp){
+  const char *a, *v;
+  size_t j, b, size;
+
+  if(c->prefetch == 0 || c->perm == NULL || k%n + c->prefetch >= n){
+    return;
+  }
+  j = gsl_permutation_get(c->perm, k%n + c->prefetch);
+
+  if(sp != NULL){
+    a = (const char *)(sp->ind + sp->ptr[j]);
+    v = (const char *)(sp->val + sp->ptr[j]);
+    size = sp->ptr[j + 1] - sp->ptr[j];
+    for(b = 0; b < size*sizeof(size_t); b = b + TNN_MACRO_CACHE_LINE){
+      TNN_MACRO_PREFETCH(a + b);
+    }
+    for(b = 0; b < size*sizeof(double); b = b + TNN_MACRO_CACHE_LINE){
+      TNN_MACRO_PREFETCH(v + b);
+    }
+  } else {
+    a = (const char *)(inputs->data + j*inputs->tda);
+    for(b = 0; b < inputs->size2*sizeof(double); b = b + TNN_MACRO_CACHE_LINE){
+      TNN_MACRO_PREFETCH(a + b);
+    }
+  }
+}
+
+//Data of the steps of nsgd_train, with rd for the regularizer derivative and the sparse weights at offset off of p
+typedef struct __STRUCT_tnn_trainer_class_nsgd_data{
+  gsl_matrix *inputs; //Input matrix, if ld and sp are NULL
+  size_t *labels; //Labels of inputs or sp
+  tnn_dataset *ds; //Dataset advised of the rows read, or NULL
+  tnn_loader *ld; //Loader the samples are pulled from, or NULL
+  tnn_sparse *sp; //Sparse inputs, or NULL
+  tnn_state *sin; //Input state of the machine
+  tnn_param *p; //Parameter the steps are taken on
+  gsl_vector *rd; //Regularizer derivative
+  size_t off; //Offset of the sparse weights in p
+} tnn_trainer_class_nsgd_data;
+
+//Take step k of nsgd_train on the sample it visits
+static tnn_error tnn_trainer_class_nsgd_train_step(tnn_trainer_class *t, void *data, size_t k, double *s,
+                                                   double *l){
+  tnn_error ret;
+  tnn_trainer_class_nsgd *c;
+  tnn_trainer_class_nsgd_data *d;
+  gsl_vector_view in;
+  gsl_vector_view lb;
+  size_t i,j,label;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  d = (tnn_trainer_class_nsgd_data*)data;
+  j = 0;
+
+  //Get the inputs and label
+  if(d->ld != NULL){
+    TNN_MACRO_ERRORTEST(tnn_loader_pull(d->ld, &in, &label), ret);
+  } else if(d->sp != NULL){
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_nsgd_row(c, k, d->sp->size1, &j), ret);
+    tnn_trainer_class_nsgd_prefetch(c, k, d->sp->size1, NULL, d->sp);
+    TNN_MACRO_ERRORTEST(tnn_module_linear_sparse_input(&t->m.min, d->sp, j), ret);
+    if(c->lazy){
+      for(i = d->sp->ptr[j]; i < d->sp->ptr[j + 1]; i = i + 1){
+	tnn_trainer_class_nsgd_lazy_row(t, d->p, d->off, d->sp->ind[i]);
+      }
+    }
+    label = d->labels[j];
+  } else {
+    TNN_MACRO_ERRORTEST(tnn_trainer_class_nsgd_row(c, k, d->inputs->size1, &j), ret);
+    tnn_trainer_class_nsgd_prefetch(c, k, d->inputs->size1, d->inputs, NULL);
+    if(d->ds != NULL && c->rng == NULL){
+      TNN_MACRO_ERRORTEST(tnn_dataset_advise(d->ds, j), ret);
+    }
+    in = gsl_matrix_row(d->inputs, j);
+    label = d->labels[j];
+  }
+
+  //Check the label
+  if(label >= t->lset->size1){
+    return TNN_ERROR_STATE_INCOMP;
+  }
+  lb = gsl_matrix_row(t->lset, label);
+
+  //Copy the data into the input/label and do forward and backward propagation
+  if(d->sp == NULL){
+    TNN_MACRO_GSLTEST(gsl_blas_dcopy(&in.vector, &d->sin->x));
+  }
+  TNN_MACRO_GSLTEST(gsl_blas_dcopy(&lb.vector, &t->label->x));
+  if(d->ld != NULL){
+    TNN_MACRO_ERRORTEST(tnn_loader_release(d->ld), ret);
+  }
+  TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
+  TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
+  *l = *l + gsl_vector_get(&t->l.output->x, 0);
+
+  //The sparse weight gradient is kept zero outside the nonzero features, so nothing is added to it
+  if(d->sp != NULL){
+    return tnn_trainer_class_nsgd_sparse_update(t, d->p, d->rd, d->sp, j, d->off, s);
+  }
+
+  //Take the gradient and the L1 regularizer in one proximal step
+  if(c->prox){
+    c->nzero = tnn_trainer_class_nsgd_prox_step(d->p->x->data, d->p->dx->data, d->p->size, c->eta,
+                                                c->eta*t->lambda, s);
+    return TNN_ERROR_SUCCESS;
+  }
+
+  //Compute the regularization derivative, and take the step with it
+  TNN_MACRO_ERRORTEST(tnn_reg_d(&t->r, d->p->x, d->rd), ret);
+  tnn_trainer_class_nsgd_step(d->p->x->data, d->p->dx->data, d->rd->data, d->p->size, c->eta, t->lambda, s);
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Record the squared norm s and average loss l of the block of nsgd_train ending at step k, and take a checkpoint
+//when a multiple of citer steps is passed
+static tnn_error tnn_trainer_class_nsgd_train_block(tnn_trainer_class *t, void *data, size_t k, double s, double l){
+  tnn_trainer_class_nsgd *c;
+  tnn_trainer_class_nsgd_data *d;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+  d = (tnn_trainer_class_nsgd_data*)data;
+  c->snorm = s;
+  c->aloss = l;
+  if(c->ckpt == NULL || k/c->citer <= (k - c->eiter)/c->citer){
+    return TNN_ERROR_SUCCESS;
+  }
+  if(d->sp != NULL && c->lazy){
+    tnn_trainer_class_nsgd_lazy_flush(t, d->p, d->off);
+  }
+  return tnn_ckpt_snapshot(c->ckpt, d->p->x, NULL, k);
+}
+
+//Run the steps of nsgd_train on the checked trainer, with rd for the regularizer derivative and the sparse
+//weights at offset off of p
+static tnn_error tnn_trainer_class_nsgd_loop(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                                             tnn_dataset *ds, tnn_loader *ld, tnn_sparse *sp, tnn_state *sin,
+                                             tnn_param *p, gsl_vector *rd, size_t off){
+  tnn_error ret;
+  tnn_trainer_class_nsgd *c;
+  tnn_trainer_class_nsgd_data d;
+  gsl_vector_view in;
+  size_t i,label;
+
+  c = (tnn_trainer_class_nsgd*)t->c;
+
+  //Start from the resumed step. The loader starts from sample 0, so skip to the resumed position.
+  if(ld != NULL){
+    for(i = 0; i < c->siter%ld->n; i = i + 1){
+      TNN_MACRO_ERRORTEST(tnn_loader_pull(ld, &in, &label), ret);
+      TNN_MACRO_ERRORTEST(tnn_loader_release(ld), ret);
+    }
+  }
+
+  //Into the main loop
+  d.inputs = inputs;
+  d.labels = labels;
+  d.ds = ds;
+  d.ld = ld;
+  d.sp = sp;
+  d.sin = sin;
+  d.p = p;
+  d.rd = rd;
+  d.off = off;
+  c->titer = c->siter;
+  c->siter = 0;
+  TNN_MACRO_ERRORTEST(tnn_trainer_class_iterate(t, tnn_trainer_class_nsgd_train_step,
+                                                tnn_trainer_class_nsgd_train_block, &d, c->epsilon, c->delta,
+                                                c->eiter, c->niter, &c->titer), ret);
+
+  //Apply the penalty left to the sparse weights, and count the zeros the lazy rows left out of the proximal steps
+  if(sp != NULL && c->lazy){
+    tnn_trainer_class_nsgd_lazy_flush(t, p, off);
+    if(c->prox){
+      for(c->nzero = 0, i = 0; i < p->size; i = i + 1){
+	c->nzero = c->nzero + (p->x->data[i] == 0.0);
+      }
+    }
+  }
+
+  //Report the error of the last checkpoint
+  if(c->ckpt != NULL){
+    TNN_MACRO_ERRORTEST(tnn_ckpt_wait(c->ckpt), ret);
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Train all the samples using naive stochastic gradient descent, advising ds of the rows read if given
+//If ld is given, the samples are pulled from it instead of inputs and labels. If sp is given, the inputs
+//are its rows, fed to the sparse linear module min of the machine.
+static tnn_error tnn_trainer_class_nsgd_train(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels,
+                                              tnn_dataset *ds, tnn_loader *ld, tnn_sparse *sp){
   tnn_error ret;
   tnn_state *sin;
   tnn_param *p;
+  tnn_trainer_class_nsgd *c;
   gsl_vector *rd;
-  gsl_vector *pw;
-  gsl_vector_view in;
-  gsl_vector_view lb;
-  double eps;
-  size_t i,j;
+  size_t i,off;
 
   //Routine check
   if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
@@ -145,64 +631,87 @@ tnn_error tnn_trainer_class_train_nsgd(tnn_trainer_class *t, gsl_matrix *inputs,
 
   //Check the input
   TNN_MACRO_ERRORTEST(tnn_machine_get_sin(&t->m, &sin),ret);
-  if(inputs->size2 != sin->size){
+  if(sp != NULL){
+    if(t->m.min.t != TNN_MODULE_TYPE_LINEAR_SPARSE){
+      return TNN_ERROR_MODULE_MISTYPE;
+    }
+    if(sp->size2 != ((tnn_module_linear_sparse*)t->m.min.c)->ninput){
+      return TNN_ERROR_STATE_INCOMP;
+    }
+  } else if((ld == NULL ? inputs->size2 : ld->size) != sin->size){
     return TNN_ERROR_STATE_INCOMP;
   }
 
   //Set the loss output dx to be 1
   gsl_vector_set(&t->l.output->dx, 0, 1.0);
 
-  //Get the parameter and allocate rd and pw
+  //Get the parameter, which the steps are taken on in place
   TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
-  rd = gsl_vector_alloc(p->size);
-  pw = gsl_vector_alloc(p->size);
-  if(rd == NULL || pw == NULL){
-    return TNN_ERROR_GSL;
+  if(p->x->stride != 1 || p->dx->stride != 1){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+  off = 0;
+  if(sp != NULL){
+    TNN_MACRO_ERRORTEST(tnn_param_state_offset(p, &t->m.min.w, &off), ret);
   }
 
-  //Into the main loop
-  for(eps = DBL_MAX, ((tnn_trainer_class_nsgd*)t->c)->titer = 0;
-      eps > ((tnn_trainer_class_nsgd*)t->c)->epsilon && ((tnn_trainer_class_nsgd*)t->c)->titer < ((tnn_trainer_class_nsgd*)t->c)->niter;
-      ((tnn_trainer_class_nsgd*)t->c)->titer = ((tnn_trainer_class_nsgd*)t->c)->titer + ((tnn_trainer_class_nsgd*)t->c)->eiter){
-
-    //Copy the previous pw
-    TNN_MACRO_GSLTEST(gsl_blas_dcopy(p->x, pw));
-
-    for(i = 0; i < ((tnn_trainer_class_nsgd*)t->c)->eiter; i = i + 1){
-
-      j = (((tnn_trainer_class_nsgd*)t->c)->titer + i)%inputs->size1;
+  //The proximal step needs the L1 regularizer
+  c = (tnn_trainer_class_nsgd*)t->c;
+  if(c->prox && t->r.t != TNN_REG_TYPE_L1){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
 
-      //Check the label
-      if(labels[j] >= t->lset->size1){
-	return TNN_ERROR_STATE_INCOMP;
+  //Start the cumulative penalty or scale of the lazy regularizer
+  if(sp != NULL && c->lazy){
+    if(t->r.t != TNN_REG_TYPE_L1 && t->r.t != TNN_REG_TYPE_L2){
+      return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+    }
+    if(t->r.t == TNN_REG_TYPE_L2 && 2.0*c->eta*t->lambda >= 1.0){
+      return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+    }
+    if(c->lu == NULL || c->lsize != sp->size2){
+      free(c->lu);
+      c->lu = (double *) malloc(sp->size2*sizeof(double));
+      if(c->lu == NULL){
+	return TNN_ERROR_ALLOC;
       }
+      c->lsize = sp->size2;
+    }
+    c->lpen = (t->r.t == TNN_REG_TYPE_L1 ? 0.0 : 1.0);
+    for(i = 0; i < c->lsize; i = i + 1){
+      c->lu[i] = c->lpen;
+    }
+  }
 
-      //Get the inputs and label vector
-      lb = gsl_matrix_row(t->lset, labels[j]);
-      in = gsl_matrix_row(inputs, j);
+  //Allocate rd, which is freed on every exit of the loop
+  rd = gsl_vector_alloc(p->size);
+  if(rd == NULL){
+    return TNN_ERROR_GSL;
+  }
+  ret = tnn_trainer_class_nsgd_loop(t, inputs, labels, ds, ld, sp, sin, p, rd, off);
+  gsl_vector_free(rd);
 
-      //Copy the data into the input/label and do forward and backward propagation
-      TNN_MACRO_GSLTEST(gsl_blas_dcopy(&in.vector, &sin->x));
-      TNN_MACRO_GSLTEST(gsl_blas_dcopy(&lb.vector, &t->label->x));
-      TNN_MACRO_ERRORTEST(tnn_machine_fprop(&t->m), ret);
-      TNN_MACRO_ERRORTEST(tnn_loss_fprop(&t->l), ret);
-      TNN_MACRO_ERRORTEST(tnn_loss_bprop(&t->l), ret);
-      TNN_MACRO_ERRORTEST(tnn_machine_bprop(&t->m), ret);
+  return ret;
+}
 
-      //Compute the accumulated regularization paramter
-      TNN_MACRO_ERRORTEST(tnn_reg_d(&t->r, p->x, rd), ret);
-      TNN_MACRO_GSLTEST(gsl_blas_daxpy(t->lambda, rd, p->dx));
+//Train all the samples using naive stochastic gradient descent
+tnn_error tnn_trainer_class_train_nsgd(tnn_trainer_class *t, gsl_matrix *inputs, size_t *labels){
+  return tnn_trainer_class_nsgd_train(t, inputs, labels, NULL, NULL, NULL);
+}
 
-      //Compute the parameter update
-      TNN_MACRO_GSLTEST(gsl_blas_daxpy(-((tnn_trainer_class_nsgd*)t->c)->eta, p->dx, p->x));
-    }
+//Train on a dataset using naive stochastic gradient descent, with readahead of the rows
+tnn_error tnn_trainer_class_train_dataset_nsgd(tnn_trainer_class *t, tnn_dataset *ds){
+  return tnn_trainer_class_nsgd_train(t, &ds->inputs, ds->labels, ds, NULL, NULL);
+}
 
-    //Compute the 2 square norm of difference of p as eps
-    TNN_MACRO_GSLTEST(gsl_blas_daxpy(-1.0, p->x, pw));
-    eps = gsl_blas_dnrm2(pw);
-  }
-  
-  return TNN_ERROR_SUCCESS;
+//Train on the samples pulled from a loader using naive stochastic gradient descent
+tnn_error tnn_trainer_class_train_loader_nsgd(tnn_trainer_class *t, tnn_loader *ld){
+  return tnn_trainer_class_nsgd_train(t, NULL, NULL, NULL, ld, NULL);
+}
+
+//Train on the rows of a sparse matrix using naive stochastic gradient descent
+tnn_error tnn_trainer_class_train_sparse_nsgd(tnn_trainer_class *t, tnn_sparse *inputs, size_t *labels){
+  return tnn_trainer_class_nsgd_train(t, NULL, labels, NULL, NULL, inputs);
 }
 
 //Debug this trainer
@@ -226,6 +735,22 @@ tnn_error tnn_trainer_class_debug_nsgd(tnn_trainer_class *t){
 	 ((tnn_trainer_class_nsgd*)t->c)->eiter,
 	 ((tnn_trainer_class_nsgd*)t->c)->niter,
 	 ((tnn_trainer_class_nsgd*)t->c)->titer);
+  printf("shuffled = %d, seed = %lu, prefetch = %ld\n",
+	 ((tnn_trainer_class_nsgd*)t->c)->rng != NULL,
+	 ((tnn_trainer_class_nsgd*)t->c)->seed,
+	 ((tnn_trainer_class_nsgd*)t->c)->prefetch);
+  printf("lazy = %d, lpen = %g, lu = %p, lsize = %ld\n",
+	 ((tnn_trainer_class_nsgd*)t->c)->lazy,
+	 ((tnn_trainer_class_nsgd*)t->c)->lpen,
+	 ((tnn_trainer_class_nsgd*)t->c)->lu,
+	 ((tnn_trainer_class_nsgd*)t->c)->lsize);
+  printf("prox = %d, nzero = %ld\n",
+	 ((tnn_trainer_class_nsgd*)t->c)->prox,
+	 ((tnn_trainer_class_nsgd*)t->c)->nzero);
+  printf("delta = %g, snorm = %g, aloss = %g\n",
+	 ((tnn_trainer_class_nsgd*)t->c)->delta,
+	 ((tnn_trainer_class_nsgd*)t->c)->snorm,
+	 ((tnn_trainer_class_nsgd*)t->c)->aloss);
 
   printf("machine: ");
   if((ret = tnn_machine_debug(&t->m)) != TNN_ERROR_SUCCESS && ret != TNN_ERROR_MODULE_FUNCNDEF){
@@ -277,6 +802,25 @@ tnn_error tnn_trainer_class_destroy_nsgd(tnn_trainer_class *t){
     return TNN_ERROR_TRAINER_CLASS_MISTYPE;
   }
 
+  //Destroy the checkpoint writer
+  if(((tnn_trainer_class_nsgd*)t->c)->ckpt != NULL){
+    tnn_ckpt_destroy(((tnn_trainer_class_nsgd*)t->c)->ckpt);
+    free(((tnn_trainer_class_nsgd*)t->c)->ckpt);
+  }
+
+  //Destroy the shuffling state
+  if(((tnn_trainer_class_nsgd*)t->c)->rng != NULL){
+    gsl_rng_free(((tnn_trainer_class_nsgd*)t->c)->rng);
+  }
+  if(((tnn_trainer_class_nsgd*)t->c)->perm != NULL){
+    gsl_permutation_free(((tnn_trainer_class_nsgd*)t->c)->perm);
+  }
+
+  //Destroy the lazy regularizer state
+  if(((tnn_trainer_class_nsgd*)t->c)->lu != NULL){
+    free(((tnn_trainer_class_nsgd*)t->c)->lu);
+  }
+
   //Destroy the parameter
   free((tnn_trainer_class_nsgd*)t->c);
 
@@ -292,3 +836,132 @@ tnn_error tnn_trainer_class_titer_nsgd(tnn_trainer_class *t, size_t *titer){
   *titer = ((tnn_trainer_class_nsgd*)t->c)->titer;
   return TNN_ERROR_SUCCESS;
 }
+
+//Checkpoint the parameters and the steps executed to file every citer steps during training (rounded up to eiter)
+tnn_error tnn_trainer_class_checkpoint_nsgd(tnn_trainer_class *t, const char *file, size_t citer){
+  tnn_error ret;
+  tnn_param *p;
+  tnn_ckpt *ck;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  if(citer < 1){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+
+  //Start a new writer
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  ck = (tnn_ckpt *) malloc(sizeof(tnn_ckpt));
+  if(ck == NULL){
+    return TNN_ERROR_ALLOC;
+  }
+  if((ret = tnn_ckpt_init(ck, file, TNN_TRAINER_CLASS_TYPE_NSGD, p->size, 0)) != TNN_ERROR_SUCCESS){
+    free(ck);
+    return ret;
+  }
+
+  //Replace the previous one
+  if(((tnn_trainer_class_nsgd*)t->c)->ckpt != NULL){
+    tnn_ckpt_destroy(((tnn_trainer_class_nsgd*)t->c)->ckpt);
+    free(((tnn_trainer_class_nsgd*)t->c)->ckpt);
+  }
+  ((tnn_trainer_class_nsgd*)t->c)->ckpt = ck;
+  ((tnn_trainer_class_nsgd*)t->c)->citer = citer;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Load a checkpoint, so that the next training resumes from its step and its data position
+tnn_error tnn_trainer_class_resume_nsgd(tnn_trainer_class *t, const char *file){
+  tnn_error ret;
+  tnn_param *p;
+  size_t titer;
+
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  TNN_MACRO_ERRORTEST(tnn_machine_get_param(&t->m, &p), ret);
+  TNN_MACRO_ERRORTEST(tnn_ckpt_load(file, TNN_TRAINER_CLASS_TYPE_NSGD, p->x, NULL, &titer), ret);
+  ((tnn_trainer_class_nsgd*)t->c)->titer = titer;
+  ((tnn_trainer_class_nsgd*)t->c)->siter = titer;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Visit the samples of each epoch in a shuffled order, and prefetch the rows prefetch steps ahead
+tnn_error tnn_trainer_class_shuffle_nsgd(tnn_trainer_class *t, unsigned long seed, size_t prefetch){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  if(((tnn_trainer_class_nsgd*)t->c)->rng == NULL){
+    ((tnn_trainer_class_nsgd*)t->c)->rng = gsl_rng_alloc(gsl_rng_mt19937);
+    if(((tnn_trainer_class_nsgd*)t->c)->rng == NULL){
+      return TNN_ERROR_GSL;
+    }
+  }
+  ((tnn_trainer_class_nsgd*)t->c)->seed = seed;
+  ((tnn_trainer_class_nsgd*)t->c)->prefetch = prefetch;
+
+  //The permutation is drawn again at the next step
+  if(((tnn_trainer_class_nsgd*)t->c)->perm != NULL){
+    gsl_permutation_free(((tnn_trainer_class_nsgd*)t->c)->perm);
+    ((tnn_trainer_class_nsgd*)t->c)->perm = NULL;
+  }
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Apply the L1 or L2 regularizer lazily to the sparse weights when training on sparse inputs
+tnn_error tnn_trainer_class_lazy_nsgd(tnn_trainer_class *t, int lazy){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  ((tnn_trainer_class_nsgd*)t->c)->lazy = lazy;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Apply the L1 regularizer by a proximal step fused into the parameter update
+tnn_error tnn_trainer_class_prox_nsgd(tnn_trainer_class *t, int prox){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+
+  ((tnn_trainer_class_nsgd*)t->c)->prox = prox;
+
+  return TNN_ERROR_SUCCESS;
+}
+
+//Get the number of parameters left at exactly 0 by the last proximal step
+tnn_error tnn_trainer_class_sparsity_nsgd(tnn_trainer_class *t, size_t *nzero){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  *nzero = ((tnn_trainer_class_nsgd*)t->c)->nzero;
+  return TNN_ERROR_SUCCESS;
+}
+
+//Also stop training when the average training loss of eiter steps changes by at most delta relatively
+tnn_error tnn_trainer_class_stop_nsgd(tnn_trainer_class *t, double delta){
+  //Routine check
+  if(t->t != TNN_TRAINER_CLASS_TYPE_NSGD){
+    return TNN_ERROR_TRAINER_CLASS_MISTYPE;
+  }
+  if(delta < 0){
+    return TNN_ERROR_TRAINER_CLASS_NVALIDP;
+  }
+
+  ((tnn_trainer_class_nsgd*)t->c)->delta = delta;
+
+  return TNN_ERROR_SUCCESS;
+}